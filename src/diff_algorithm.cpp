@@ -0,0 +1,546 @@
+#include "diff_algorithm.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+DiffAlgorithm ParseDiffAlgorithm(const string &name) {
+	auto lower = StringUtil::Lower(name);
+	if (lower == "myers" || lower == "default") {
+		return DiffAlgorithm::MYERS;
+	}
+	if (lower == "minimal") {
+		return DiffAlgorithm::MINIMAL;
+	}
+	if (lower == "patience") {
+		return DiffAlgorithm::PATIENCE;
+	}
+	if (lower == "histogram") {
+		return DiffAlgorithm::HISTOGRAM;
+	}
+	throw InvalidInputException(
+	    "Unknown diff algorithm '%s' (expected 'myers', 'minimal', 'patience' or 'histogram')", name);
+}
+
+//===--------------------------------------------------------------------===//
+// LineInterner
+//===--------------------------------------------------------------------===//
+
+LineInterner::LineInterner(idx_t expected_lines) {
+	idx_t capacity = NextPowerOfTwo(MaxValue<idx_t>(2 * expected_lines, 16));
+	table.resize(capacity, Entry {0, nullptr, 0, EMPTY});
+	mask = capacity - 1;
+}
+
+void LineInterner::Intern(const char *data, const vector<LineToken> &lines, vector<uint32_t> &ids) {
+	ids.reserve(ids.size() + lines.size());
+	for (const auto &line : lines) {
+		if (2 * (count + 1) > table.size()) {
+			Grow();
+		}
+		auto line_data = data + line.offset;
+		for (idx_t slot = line.hash & mask;; slot = (slot + 1) & mask) {
+			auto &entry = table[slot];
+			if (entry.id == EMPTY) {
+				entry = Entry {line.hash, line_data, line.length, static_cast<uint32_t>(count++)};
+				ids.push_back(entry.id);
+				break;
+			}
+			if (entry.hash == line.hash && entry.length == line.length &&
+			    memcmp(entry.data, line_data, line.length) == 0) {
+				ids.push_back(entry.id);
+				break;
+			}
+		}
+	}
+}
+
+void LineInterner::Grow() {
+	vector<Entry> old_table;
+	old_table.swap(table);
+	table.resize(old_table.size() * 2, Entry {0, nullptr, 0, EMPTY});
+	mask = table.size() - 1;
+	for (const auto &entry : old_table) {
+		if (entry.id == EMPTY) {
+			continue;
+		}
+		idx_t slot = entry.hash & mask;
+		while (table[slot].id != EMPTY) {
+			slot = (slot + 1) & mask;
+		}
+		table[slot] = entry;
+	}
+}
+
+namespace {
+
+// Histogram diff falls back to Myers when every common line in a region occurs
+// more often than this on the old side (same limit as git).
+static constexpr uint32_t HISTOGRAM_MAX_CHAIN = 64;
+// Lower bound for the Myers cost limit; the limit grows with sqrt(N + M).
+static constexpr int64_t MYERS_MIN_COST_LIMIT = 256;
+
+// Half-open line ranges [off1, lim1) of the old side and [off2, lim2) of the new side.
+struct DiffRange {
+	int64_t off1;
+	int64_t lim1;
+	int64_t off2;
+	int64_t lim2;
+};
+
+struct MyersSplit {
+	int64_t i1;
+	int64_t i2;
+	bool min_lo;
+	bool min_hi;
+};
+
+// Diffs the compacted sequences a and b (only lines present on both sides);
+// a_index and b_index map their positions back to the caller's lines.
+class LineDiff {
+public:
+	LineDiff(vector<uint32_t> a_p, vector<uint32_t> b_p, vector<idx_t> a_index_p, vector<idx_t> b_index_p,
+	         idx_t id_count, vector<uint8_t> &old_changed_p, vector<uint8_t> &new_changed_p)
+	    : a(std::move(a_p)), b(std::move(b_p)), a_index(std::move(a_index_p)), b_index(std::move(b_index_p)),
+	      old_changed(old_changed_p), new_changed(new_changed_p), count_old(id_count, 0), count_new(id_count, 0),
+	      slot(id_count, -1) {
+	}
+
+	void Run(DiffAlgorithm algorithm) {
+		DiffRange all {0, static_cast<int64_t>(a.size()), 0, static_cast<int64_t>(b.size())};
+		switch (algorithm) {
+		case DiffAlgorithm::MYERS:
+			Myers(all, false);
+			break;
+		case DiffAlgorithm::MINIMAL:
+			Myers(all, true);
+			break;
+		case DiffAlgorithm::PATIENCE:
+			Patience(all);
+			break;
+		case DiffAlgorithm::HISTOGRAM:
+			Histogram(all);
+			break;
+		}
+	}
+
+private:
+	void MarkOld(int64_t begin, int64_t end) {
+		for (int64_t i = begin; i < end; i++) {
+			old_changed[a_index[i]] = 1;
+		}
+	}
+	void MarkNew(int64_t begin, int64_t end) {
+		for (int64_t i = begin; i < end; i++) {
+			new_changed[b_index[i]] = 1;
+		}
+	}
+
+	// Strips the common prefix and suffix of the range. Returns true when that
+	// leaves one side empty, after flagging whatever remains of the other.
+	bool Settle(DiffRange &r) {
+		while (r.off1 < r.lim1 && r.off2 < r.lim2 && a[r.off1] == b[r.off2]) {
+			r.off1++;
+			r.off2++;
+		}
+		while (r.off1 < r.lim1 && r.off2 < r.lim2 && a[r.lim1 - 1] == b[r.lim2 - 1]) {
+			r.lim1--;
+			r.lim2--;
+		}
+		if (r.off1 == r.lim1) {
+			MarkNew(r.off2, r.lim2);
+			return true;
+		}
+		if (r.off2 == r.lim2) {
+			MarkOld(r.off1, r.lim1);
+			return true;
+		}
+		return false;
+	}
+
+	//===----------------------------------------------------------------===//
+	// Myers
+	//===----------------------------------------------------------------===//
+
+	void Myers(DiffRange range, bool minimal) {
+		if (kvd.empty()) {
+			auto diagonals = static_cast<int64_t>(a.size() + b.size()) + 3;
+			kvd.resize(2 * diagonals);
+			kvdf = kvd.data() + b.size() + 1;
+			kvdb = kvdf + diagonals;
+			max_cost = MaxValue<int64_t>(MYERS_MIN_COST_LIMIT, static_cast<int64_t>(std::sqrt(diagonals)));
+		}
+		vector<std::pair<DiffRange, bool>> stack;
+		stack.emplace_back(range, minimal);
+		while (!stack.empty()) {
+			auto task = stack.back();
+			stack.pop_back();
+			auto r = task.first;
+			if (Settle(r)) {
+				continue;
+			}
+			auto split = Split(r, task.second || minimal);
+			stack.emplace_back(DiffRange {split.i1, r.lim1, split.i2, r.lim2}, split.min_hi);
+			stack.emplace_back(DiffRange {r.off1, split.i1, r.off2, split.i2}, split.min_lo);
+		}
+	}
+
+	// Finds the middle snake of the range, searching forward and backward
+	// along diagonals d = i1 - i2 until the two searches overlap. Without
+	// need_min the search gives up after max_cost steps and splits at the
+	// furthest-reaching diagonal instead; only that half loses minimality.
+	MyersSplit Split(const DiffRange &r, bool need_min) {
+		const int64_t dmin = r.off1 - r.lim2;
+		const int64_t dmax = r.lim1 - r.off2;
+		const int64_t fmid = r.off1 - r.off2;
+		const int64_t bmid = r.lim1 - r.lim2;
+		const bool odd = ((fmid - bmid) & 1) != 0;
+		int64_t fmin = fmid, fmax = fmid;
+		int64_t bmin = bmid, bmax = bmid;
+
+		kvdf[fmid] = r.off1;
+		kvdb[bmid] = r.lim1;
+
+		for (int64_t cost = 1;; cost++) {
+			// Forward search
+			if (fmin > dmin) {
+				kvdf[--fmin - 1] = -1;
+			} else {
+				++fmin;
+			}
+			if (fmax < dmax) {
+				kvdf[++fmax + 1] = -1;
+			} else {
+				--fmax;
+			}
+			for (int64_t d = fmax; d >= fmin; d -= 2) {
+				int64_t i1 = kvdf[d - 1] >= kvdf[d + 1] ? kvdf[d - 1] + 1 : kvdf[d + 1];
+				int64_t i2 = i1 - d;
+				while (i1 < r.lim1 && i2 < r.lim2 && a[i1] == b[i2]) {
+					i1++;
+					i2++;
+				}
+				kvdf[d] = i1;
+				if (odd && bmin <= d && d <= bmax && kvdb[d] <= i1) {
+					return MyersSplit {i1, i2, true, true};
+				}
+			}
+
+			// Backward search
+			if (bmin > dmin) {
+				kvdb[--bmin - 1] = NumericLimits<int64_t>::Maximum();
+			} else {
+				++bmin;
+			}
+			if (bmax < dmax) {
+				kvdb[++bmax + 1] = NumericLimits<int64_t>::Maximum();
+			} else {
+				--bmax;
+			}
+			for (int64_t d = bmax; d >= bmin; d -= 2) {
+				int64_t i1 = kvdb[d - 1] < kvdb[d + 1] ? kvdb[d - 1] : kvdb[d + 1] - 1;
+				int64_t i2 = i1 - d;
+				while (i1 > r.off1 && i2 > r.off2 && a[i1 - 1] == b[i2 - 1]) {
+					i1--;
+					i2--;
+				}
+				kvdb[d] = i1;
+				if (!odd && fmin <= d && d <= fmax && i1 <= kvdf[d]) {
+					return MyersSplit {i1, i2, true, true};
+				}
+			}
+
+			if (need_min || cost < max_cost) {
+				continue;
+			}
+
+			// Cost limit reached: split where either search got furthest
+			int64_t fbest = -1, fbest1 = -1;
+			for (int64_t d = fmax; d >= fmin; d -= 2) {
+				int64_t i1 = MinValue<int64_t>(kvdf[d], r.lim1);
+				int64_t i2 = i1 - d;
+				if (r.lim2 < i2) {
+					i1 = r.lim2 + d;
+					i2 = r.lim2;
+				}
+				if (fbest < i1 + i2) {
+					fbest = i1 + i2;
+					fbest1 = i1;
+				}
+			}
+			int64_t bbest = NumericLimits<int64_t>::Maximum(), bbest1 = bbest;
+			for (int64_t d = bmax; d >= bmin; d -= 2) {
+				int64_t i1 = MaxValue<int64_t>(r.off1, kvdb[d]);
+				int64_t i2 = i1 - d;
+				if (i2 < r.off2) {
+					i1 = r.off2 + d;
+					i2 = r.off2;
+				}
+				if (i1 + i2 < bbest) {
+					bbest = i1 + i2;
+					bbest1 = i1;
+				}
+			}
+			if ((r.lim1 + r.lim2) - bbest < fbest - (r.off1 + r.off2)) {
+				return MyersSplit {fbest1, fbest - fbest1, true, false};
+			}
+			return MyersSplit {bbest1, bbest - bbest1, false, true};
+		}
+	}
+
+	//===----------------------------------------------------------------===//
+	// Patience
+	//===----------------------------------------------------------------===//
+
+	void Patience(DiffRange range) {
+		vector<DiffRange> stack {range};
+		vector<std::pair<int64_t, int64_t>> anchors;
+		vector<idx_t> tails;
+		vector<int64_t> previous;
+		while (!stack.empty()) {
+			auto r = stack.back();
+			stack.pop_back();
+			if (Settle(r)) {
+				continue;
+			}
+
+			// Lines occurring exactly once on each side, in old-side order
+			for (int64_t i = r.off1; i < r.lim1; i++) {
+				if (count_old[a[i]]++ == 0 && count_new[a[i]] == 0) {
+					touched.push_back(a[i]);
+				}
+			}
+			for (int64_t j = r.off2; j < r.lim2; j++) {
+				if (count_new[b[j]]++ == 0 && count_old[b[j]] == 0) {
+					touched.push_back(b[j]);
+				}
+				slot[b[j]] = j;
+			}
+			anchors.clear();
+			for (int64_t i = r.off1; i < r.lim1; i++) {
+				if (count_old[a[i]] == 1 && count_new[a[i]] == 1) {
+					anchors.emplace_back(i, slot[a[i]]);
+				}
+			}
+			ResetScratch();
+			if (anchors.empty()) {
+				Myers(r, false);
+				continue;
+			}
+
+			// Longest increasing subsequence of new-side positions
+			tails.clear();
+			previous.assign(anchors.size(), -1);
+			for (idx_t k = 0; k < anchors.size(); k++) {
+				auto pos = std::lower_bound(tails.begin(), tails.end(), anchors[k].second,
+				                            [&](idx_t t, int64_t value) { return anchors[t].second < value; });
+				if (pos != tails.begin()) {
+					previous[k] = static_cast<int64_t>(*(pos - 1));
+				}
+				if (pos == tails.end()) {
+					tails.push_back(k);
+				} else {
+					*pos = k;
+				}
+			}
+
+			// The anchors match; diff the gaps between them
+			int64_t next1 = r.lim1, next2 = r.lim2;
+			for (auto k = static_cast<int64_t>(tails.back()); k >= 0; k = previous[k]) {
+				stack.push_back(DiffRange {anchors[k].first + 1, next1, anchors[k].second + 1, next2});
+				next1 = anchors[k].first;
+				next2 = anchors[k].second;
+			}
+			stack.push_back(DiffRange {r.off1, next1, r.off2, next2});
+		}
+	}
+
+	//===----------------------------------------------------------------===//
+	// Histogram
+	//===----------------------------------------------------------------===//
+
+	enum class LcsResult : uint8_t { FOUND, NONE, TOO_COMMON };
+
+	void Histogram(DiffRange range) {
+		vector<DiffRange> stack {range};
+		next_occurrence.resize(a.size());
+		while (!stack.empty()) {
+			auto r = stack.back();
+			stack.pop_back();
+			if (Settle(r)) {
+				continue;
+			}
+			DiffRange lcs;
+			switch (FindHistogramLcs(r, lcs)) {
+			case LcsResult::TOO_COMMON:
+				Myers(r, false);
+				break;
+			case LcsResult::NONE:
+				MarkOld(r.off1, r.lim1);
+				MarkNew(r.off2, r.lim2);
+				break;
+			case LcsResult::FOUND:
+				stack.push_back(DiffRange {lcs.lim1, r.lim1, lcs.lim2, r.lim2});
+				stack.push_back(DiffRange {r.off1, lcs.off1, r.off2, lcs.off2});
+				break;
+			}
+		}
+	}
+
+	// Finds the longest common region whose rarest line is as rare as possible
+	// on the old side, following git's xhistogram.
+	LcsResult FindHistogramLcs(const DiffRange &r, DiffRange &lcs) {
+		// Occurrence chains of each old-side line, first occurrence in slot[]
+		for (int64_t i = r.lim1 - 1; i >= r.off1; i--) {
+			auto id = a[i];
+			if (count_old[id]++ == 0) {
+				touched.push_back(id);
+				next_occurrence[i] = -1;
+			} else {
+				next_occurrence[i] = slot[id];
+			}
+			slot[id] = i;
+		}
+
+		uint32_t best_count = HISTOGRAM_MAX_CHAIN + 1;
+		bool found = false;
+		bool has_common = false;
+		for (int64_t j = r.off2; j < r.lim2;) {
+			int64_t next_j = j + 1;
+			auto id = b[j];
+			if (count_old[id] == 0) {
+				j = next_j;
+				continue;
+			}
+			has_common = true;
+			if (count_old[id] > best_count) {
+				j = next_j;
+				continue;
+			}
+			for (int64_t as = slot[id];;) {
+				int64_t next = next_occurrence[as];
+				int64_t bs = j, ae = as, be = j;
+				uint32_t rarest = count_old[id];
+				while (r.off1 < as && r.off2 < bs && a[as - 1] == b[bs - 1]) {
+					as--;
+					bs--;
+					rarest = MinValue<uint32_t>(rarest, count_old[a[as]]);
+				}
+				while (ae + 1 < r.lim1 && be + 1 < r.lim2 && a[ae + 1] == b[be + 1]) {
+					ae++;
+					be++;
+					rarest = MinValue<uint32_t>(rarest, count_old[a[ae]]);
+				}
+				next_j = MaxValue<int64_t>(next_j, be + 1);
+				if (!found || lcs.lim1 - lcs.off1 < ae + 1 - as || rarest < best_count) {
+					lcs = DiffRange {as, ae + 1, bs, be + 1};
+					best_count = rarest;
+					found = true;
+				}
+				// Next occurrence past the region just matched
+				while (next >= 0 && next <= ae) {
+					next = next_occurrence[next];
+				}
+				if (next < 0) {
+					break;
+				}
+				as = next;
+			}
+			j = next_j;
+		}
+		ResetScratch();
+		if (found) {
+			return LcsResult::FOUND;
+		}
+		return has_common ? LcsResult::TOO_COMMON : LcsResult::NONE;
+	}
+
+	void ResetScratch() {
+		for (auto id : touched) {
+			count_old[id] = 0;
+			count_new[id] = 0;
+			slot[id] = -1;
+		}
+		touched.clear();
+	}
+
+	vector<uint32_t> a;
+	vector<uint32_t> b;
+	vector<idx_t> a_index;
+	vector<idx_t> b_index;
+	vector<uint8_t> &old_changed;
+	vector<uint8_t> &new_changed;
+
+	// Myers: furthest-reaching positions per diagonal, forward and backward
+	vector<int64_t> kvd;
+	int64_t *kvdf = nullptr;
+	int64_t *kvdb = nullptr;
+	int64_t max_cost = 0;
+
+	// Patience / histogram scratch, indexed by line id and reset after use
+	vector<uint32_t> count_old;
+	vector<uint32_t> count_new;
+	vector<int64_t> slot;
+	vector<uint32_t> touched;
+	vector<int64_t> next_occurrence;
+};
+
+} // namespace
+
+void ComputeLineDiff(const vector<uint32_t> &old_ids, const vector<uint32_t> &new_ids, idx_t id_count,
+                     DiffAlgorithm algorithm, vector<uint8_t> &old_changed, vector<uint8_t> &new_changed) {
+	old_changed.assign(old_ids.size(), 0);
+	new_changed.assign(new_ids.size(), 0);
+
+	idx_t begin = 0;
+	idx_t old_end = old_ids.size();
+	idx_t new_end = new_ids.size();
+	while (begin < old_end && begin < new_end && old_ids[begin] == new_ids[begin]) {
+		begin++;
+	}
+	while (old_end > begin && new_end > begin && old_ids[old_end - 1] == new_ids[new_end - 1]) {
+		old_end--;
+		new_end--;
+	}
+
+	// Lines missing from the other side can never match
+	vector<uint8_t> in_old(id_count, 0);
+	vector<uint8_t> in_new(id_count, 0);
+	for (idx_t i = begin; i < old_end; i++) {
+		in_old[old_ids[i]] = 1;
+	}
+	for (idx_t j = begin; j < new_end; j++) {
+		in_new[new_ids[j]] = 1;
+	}
+	vector<uint32_t> a, b;
+	vector<idx_t> a_index, b_index;
+	for (idx_t i = begin; i < old_end; i++) {
+		if (in_new[old_ids[i]]) {
+			a.push_back(old_ids[i]);
+			a_index.push_back(i);
+		} else {
+			old_changed[i] = 1;
+		}
+	}
+	for (idx_t j = begin; j < new_end; j++) {
+		if (in_old[new_ids[j]]) {
+			b.push_back(new_ids[j]);
+			b_index.push_back(j);
+		} else {
+			new_changed[j] = 1;
+		}
+	}
+	if (a.empty() && b.empty()) {
+		return;
+	}
+
+	LineDiff diff(std::move(a), std::move(b), std::move(a_index), std::move(b_index), id_count, old_changed,
+	              new_changed);
+	diff.Run(algorithm);
+}
+
+} // namespace duckdb
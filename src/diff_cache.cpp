@@ -0,0 +1,125 @@
+#include "diff_cache.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr const char *DIFF_CACHE_SETTING = "duck_tails_diff_cache_size";
+
+DiffCache &DiffCache::Instance() {
+	static DiffCache instance;
+	return instance;
+}
+
+idx_t ParseCacheSize(const Value &value) {
+	if (value.IsNull()) {
+		return 0;
+	}
+	// Accepts memory_limit style sizes ('256MB', '1GiB'); '0' disables the cache
+	auto text = StringUtil::Lower(StringUtil::Replace(value.ToString(), " ", ""));
+	if (text.empty() || text == "0") {
+		return 0;
+	}
+	auto capacity = DBConfig::ParseMemoryLimit(text);
+	return capacity == DConstants::INVALID_INDEX ? 0 : capacity;
+}
+
+optional_ptr<DiffCache> DiffCache::Get(ClientContext &context) {
+	auto &cache = Instance();
+	if (cache.Capacity() == 0) {
+		return nullptr;
+	}
+	return &cache;
+}
+
+// SET duck_tails_diff_cache_size: the one cache is shared by every
+// connection, so its budget follows the last SET from any of them
+static void SetDiffCacheSize(ClientContext &context, SetScope scope, Value &parameter) {
+	DiffCache::Instance().SetCapacity(ParseCacheSize(parameter));
+}
+
+shared_ptr<const PackedTextDiff> DiffCache::Lookup(const DiffCacheKey &key, const char *old_data,
+                                                   const char *new_data) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	// Sizes are part of the key; a hash collision compares unequal here
+	auto &cached = *entry->second;
+	if (memcmp(cached.old_text.data(), old_data, key.old_size) != 0 ||
+	    memcmp(cached.new_text.data(), new_data, key.new_size) != 0) {
+		return nullptr;
+	}
+	lru.splice(lru.begin(), lru, entry->second);
+	return cached.diff;
+}
+
+void DiffCache::Insert(const DiffCacheKey &key, const char *old_data, const char *new_data,
+                       shared_ptr<const PackedTextDiff> diff) {
+	// Heap footprint of the entry: both inputs, the packed diff and the bookkeeping
+	auto entry_size = sizeof(Entry) + key.old_size + key.new_size + diff->MemorySize();
+	std::lock_guard<std::mutex> guard(lock);
+	if (entry_size > capacity || entries.find(key) != entries.end()) {
+		return;
+	}
+	lru.push_front(Entry {key, string(old_data, key.old_size), string(new_data, key.new_size), std::move(diff),
+	                      entry_size});
+	entries[key] = lru.begin();
+	size += entry_size;
+	EvictToCapacity();
+}
+
+void DiffCache::SetCapacity(idx_t bytes) {
+	std::lock_guard<std::mutex> guard(lock);
+	capacity = bytes;
+	EvictToCapacity();
+}
+
+idx_t DiffCache::Capacity() {
+	std::lock_guard<std::mutex> guard(lock);
+	return capacity;
+}
+
+void DiffCache::EvictToCapacity() {
+	while (size > capacity) {
+		auto &oldest = lru.back();
+		size -= oldest.size;
+		entries.erase(oldest.key);
+		lru.pop_back();
+	}
+}
+
+shared_ptr<const PackedTextDiff> CachedTextDiff(optional_ptr<DiffCache> cache, const char *old_data, idx_t old_size,
+                                                const char *new_data, idx_t new_size,
+                                                const TextDiff::Options &options) {
+	if (!cache) {
+		return make_shared_ptr<PackedTextDiff>(TextDiff::CreateDiff(old_data, old_size, new_data, new_size, options));
+	}
+	DiffCacheKey key;
+	key.old_hash = HashContent(old_data, old_size);
+	key.new_hash = HashContent(new_data, new_size);
+	key.old_size = old_size;
+	key.new_size = new_size;
+	key.options = options;
+	auto diff = cache->Lookup(key, old_data, new_data);
+	if (diff) {
+		return diff;
+	}
+	diff = make_shared_ptr<PackedTextDiff>(TextDiff::CreateDiff(old_data, old_size, new_data, new_size, options));
+	cache->Insert(key, old_data, new_data, diff);
+	return diff;
+}
+
+void RegisterDiffCacheSettings(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(DIFF_CACHE_SETTING,
+	                          "Memory budget of the process-wide cache of text_diff/diff_text results, shared by all "
+	                          "connections (0 disables it)",
+	                          LogicalType::VARCHAR, Value("0"), SetDiffCacheSize);
+}
+
+} // namespace duckdb
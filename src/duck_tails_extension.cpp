@@ -1,9 +1,14 @@
 #define DUCKDB_EXTENSION_MAIN
 
 #include "duck_tails_extension.hpp"
+#include "diff_cache.hpp"
+#include "git_result_cache.hpp"
+#include "git_ref_watcher.hpp"
 #include "git_filesystem.hpp"
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "text_diff.hpp"
+#include "worktree_hash.hpp"
 #include "duckdb.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
@@ -35,6 +40,15 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	// Register TextDiff type and functions
 	RegisterTextDiffType(loader);
+
+	// Register GITOID type, casts and the duck_tails_gitoid setting
+	RegisterGitOidType(loader);
+
+	// Register extension settings
+	RegisterWorktreeHashSettings(loader);
+	RegisterDiffCacheSettings(loader);
+	RegisterGitResultCacheSettings(loader);
+	RegisterGitRefWatcherSettings(loader);
 }
 
 void DuckTailsExtension::Load(ExtensionLoader &loader) {
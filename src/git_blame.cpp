@@ -1,9 +1,12 @@
 #include "duckdb.hpp"
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_path.hpp"
 #include "git_context_manager.hpp"
 #include "git_utils.hpp"
+#include "git_result_cache.hpp"
+#include "text_utils.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/function/function_set.hpp"
@@ -31,72 +34,60 @@ static string oid_to_hex(const git_oid *oid) {
 	return string(hex);
 }
 
-// Simple UTF-8 validation to prevent DuckDB VARCHAR verification crashes on
-// non-UTF-8 text files. Mirrors git_read.cpp's IsValidUTF8 — duplicated here
-// rather than extracted until a third caller appears.
-static bool IsValidUTF8(const char *data, size_t length) {
-	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
-	for (size_t i = 0; i < length;) {
-		unsigned char byte = bytes[i];
-		if (byte <= 0x7F) {
-			i++;
-			continue;
-		}
-		int num_bytes = 0;
-		if ((byte & 0xE0) == 0xC0) {
-			num_bytes = 2;
-		} else if ((byte & 0xF0) == 0xE0) {
-			num_bytes = 3;
-		} else if ((byte & 0xF8) == 0xF0) {
-			num_bytes = 4;
-		} else {
-			return false;
-		}
-		if (i + num_bytes > length) {
-			return false;
-		}
-		for (int j = 1; j < num_bytes; j++) {
-			if ((bytes[i + j] & 0xC0) != 0x80) {
-				return false;
-			}
-		}
-		i += num_bytes;
-	}
-	return true;
-}
-
 //===--------------------------------------------------------------------===//
-// GitBlameRow — covers both per-line and per-hunk output shapes.
+// GitBlameHunk / GitBlameResult — per-file blame output.
+//
+// Per-line rows are not materialized: a line row is (hunk, offset within
+// hunk), and line_content is a view into the single copy of the final blob
+// held by the result. A 50k-line file therefore costs one content buffer and
+// one string_t per line instead of 50k row structs with their own strings.
 //===--------------------------------------------------------------------===//
 
-struct GitBlameRow {
-	// Identity (populated by caller, not CollectBlameRows)
-	string repo_path;
-	string file_path;
-	string file_ext;
-	string revision;
-
-	// Per-line fields (git_blame)
-	int64_t line_number = 0;
-	string line_content;
-	bool line_content_is_null = false;
-
-	// Per-hunk fields (git_blame_hunks)
+struct GitBlameHunk {
 	int64_t start_line = 0;
 	int64_t line_count = 0;
 	int64_t orig_start_line = 0;
-
-	// Shared fields
-	string commit_hash;
+	git_oid commit_id {};
 	string author_name;
 	string author_email;
 	timestamp_t author_date = timestamp_t(0);
-	string orig_commit_hash;
+	git_oid orig_commit_id {};
 	string orig_path;
-	int64_t orig_line_number = 0;
 	bool boundary = false;
 };
 
+struct GitBlameResult {
+	// Identity (same for every emitted row)
+	string repo_path;
+	string file_path;
+	string file_ext;
+	string revision;
+
+	vector<GitBlameHunk> hunks;
+
+	// Final blob text (per-line form only). `lines` are views into `content`,
+	// so the result is owned through unique_ptr and never moved.
+	string content;
+	vector<string_t> lines;
+	bool have_text = false;
+
+	GitBlameResult() = default;
+	GitBlameResult(const GitBlameResult &) = delete;
+	GitBlameResult &operator=(const GitBlameResult &) = delete;
+};
+
+// Output position inside a GitBlameResult: hunk index plus line offset within
+// that hunk (the offset is unused for the hunks form).
+struct GitBlameCursor {
+	idx_t hunk = 0;
+	idx_t line = 0;
+
+	void Reset() {
+		hunk = 0;
+		line = 0;
+	}
+};
+
 //===--------------------------------------------------------------------===//
 // GitBlameOptions — mirror of the blame-related named parameters.
 //===--------------------------------------------------------------------===//
@@ -113,77 +104,56 @@ struct GitBlameOptions {
 // Blame core
 //===--------------------------------------------------------------------===//
 
-// Loads the blob for `file_path` at `commit` and splits it into lines
-// (strips trailing `\r`). Returns false if the blob is binary; `lines` is
-// left empty in that case.
-static bool LoadFileLines(git_repository *repo, git_commit *commit, const string &file_path, vector<string> &lines) {
+// Loads the final blob of `file_path` from the already-peeled commit into
+// `result.content` (one copy) and splits it into line views (trailing `\r`
+// stripped). Leaves `have_text` false for binary or non-UTF-8 blobs so callers
+// emit NULL line_content rather than invalid VARCHAR data.
+static void LoadBlameText(git_repository *repo, git_commit *commit, const string &file_path, GitBlameResult &result) {
 	git_tree *tree = nullptr;
 	int error = git_commit_tree(&tree, commit);
 	if (error != 0) {
 		const git_error *e = git_error_last();
 		throw IOException("git_blame: failed to get commit tree: %s", e ? e->message : "unknown error");
 	}
+	auto tree_guard = MakeGitTree(tree);
 
 	git_tree_entry *entry = nullptr;
 	error = git_tree_entry_bypath(&entry, tree, file_path.c_str());
 	if (error != 0) {
-		git_tree_free(tree);
 		throw IOException("git_blame: file not found '%s' at revision", file_path);
 	}
-
 	git_blob *blob = nullptr;
 	error = git_blob_lookup(&blob, repo, git_tree_entry_id(entry));
+	git_tree_entry_free(entry);
 	if (error != 0) {
-		git_tree_entry_free(entry);
-		git_tree_free(tree);
 		throw IOException("git_blame: failed to load blob for '%s'", file_path);
 	}
+	auto blob_guard = MakeGitBlob(blob);
 
-	bool is_binary = git_blob_is_binary(blob) != 0;
-	if (!is_binary) {
-		const char *data = static_cast<const char *>(git_blob_rawcontent(blob));
-		size_t size = static_cast<size_t>(git_blob_rawsize(blob));
-
-		// Validate the whole blob as UTF-8 before splitting. DuckDB VARCHAR
-		// requires valid UTF-8; latin-1 and other 8-bit encodings would trip
-		// verification assertions. Mark the file as binary if validation fails
-		// so callers emit NULL line_content rather than garbage.
-		if (!IsValidUTF8(data, size)) {
-			is_binary = true;
-		} else {
-			size_t start = 0;
-			for (size_t i = 0; i < size; i++) {
-				if (data[i] == '\n') {
-					size_t end = i;
-					if (end > start && data[end - 1] == '\r') {
-						end--;
-					}
-					lines.emplace_back(data + start, end - start);
-					start = i + 1;
-				}
-			}
-			if (start < size) {
-				size_t end = size;
-				if (end > start && data[end - 1] == '\r') {
-					end--;
-				}
-				lines.emplace_back(data + start, end - start);
-			}
-		}
+	if (git_blob_is_binary(blob)) {
+		return;
+	}
+	const char *data = static_cast<const char *>(git_blob_rawcontent(blob));
+	size_t size = static_cast<size_t>(git_blob_rawsize(blob));
+	if (!IsValidUTF8(data, size)) {
+		return;
 	}
 
-	git_blob_free(blob);
-	git_tree_entry_free(entry);
-	git_tree_free(tree);
-	return !is_binary;
+	result.content.assign(data, size);
+	SplitLineViews(result.content.data(), result.content.size(), result.lines);
+	result.have_text = true;
 }
 
-// Computes blame rows for (repo, file_path) at `revision`. If `per_line` is
-// true, emits one row per line with `line_content`; otherwise emits one row
-// per hunk with `start_line`/`line_count`.
-static void CollectBlameRows(git_repository *repo, const string &repo_path, const string &file_path,
-                             const string &revision, const GitBlameOptions &opts, bool per_line,
-                             vector<GitBlameRow> &rows) {
+// Computes blame for (repo, file_path) at `revision` into `result`. The
+// revision is resolved once and the peeled commit is shared by the blame
+// engine (as newest_commit) and, when `load_text` is set, by the blob load.
+static void CollectBlame(git_repository *repo, const string &repo_path, const string &file_path,
+                         const string &revision, const GitBlameOptions &opts, bool load_text, GitBlameResult &result) {
+	result.repo_path = repo_path;
+	result.file_path = file_path;
+	result.file_ext = ExtractFileExtension(file_path);
+	result.revision = revision;
+
 	git_object *rev_obj = nullptr;
 	int error = git_revparse_single(&rev_obj, repo, revision.c_str());
 	if (error != 0) {
@@ -193,10 +163,17 @@ static void CollectBlameRows(git_repository *repo, const string &repo_path, cons
 
 	git_commit *commit = nullptr;
 	error = git_object_peel(reinterpret_cast<git_object **>(&commit), rev_obj, GIT_OBJECT_COMMIT);
+	git_object_free(rev_obj);
 	if (error != 0) {
-		git_object_free(rev_obj);
 		throw IOException("git_blame: revision '%s' does not resolve to a commit", revision);
 	}
+	auto commit_guard = MakeGitCommit(commit);
+
+	// Load the text first: a missing path fails fast here with a clear message
+	// before the (much more expensive) blame walk starts.
+	if (load_text) {
+		LoadBlameText(repo, commit, file_path, result);
+	}
 
 	// Build blame options.
 	git_blame_options blame_opts = GIT_BLAME_OPTIONS_INIT;
@@ -223,93 +200,35 @@ static void CollectBlameRows(git_repository *repo, const string &repo_path, cons
 	error = git_blame_file(&blame, repo, file_path.c_str(), &blame_opts);
 	if (error != 0) {
 		const git_error *e = git_error_last();
-		git_commit_free(commit);
-		git_object_free(rev_obj);
 		throw IOException("git_blame: blame failed for '%s': %s", file_path, e ? e->message : "unknown error");
 	}
 
-	// Load file lines if we need line_content.
-	vector<string> file_lines;
-	bool have_text = false;
-	if (per_line) {
-		try {
-			have_text = LoadFileLines(repo, commit, file_path, file_lines);
-		} catch (...) {
-			git_blame_free(blame);
-			git_commit_free(commit);
-			git_object_free(rev_obj);
-			throw;
-		}
-	}
-
-	string file_ext = ExtractFileExtension(file_path);
 	uint32_t hunk_count = git_blame_get_hunk_count(blame);
+	result.hunks.reserve(hunk_count);
 	for (uint32_t i = 0; i < hunk_count; i++) {
 		const git_blame_hunk *hunk = git_blame_get_hunk_byindex(blame, i);
 		if (!hunk) {
 			continue;
 		}
 
-		string commit_hash = oid_to_hex(&hunk->final_commit_id);
-		string orig_commit_hash = oid_to_hex(&hunk->orig_commit_id);
-		string author_name = hunk->final_signature && hunk->final_signature->name ? hunk->final_signature->name : "";
-		string author_email = hunk->final_signature && hunk->final_signature->email ? hunk->final_signature->email : "";
-		timestamp_t author_date = timestamp_t(0);
+		GitBlameHunk out;
+		out.start_line = static_cast<int64_t>(hunk->final_start_line_number);
+		out.line_count = static_cast<int64_t>(hunk->lines_in_hunk);
+		out.orig_start_line = static_cast<int64_t>(hunk->orig_start_line_number);
+		git_oid_cpy(&out.commit_id, &hunk->final_commit_id);
+		git_oid_cpy(&out.orig_commit_id, &hunk->orig_commit_id);
 		if (hunk->final_signature) {
+			out.author_name = hunk->final_signature->name ? hunk->final_signature->name : "";
+			out.author_email = hunk->final_signature->email ? hunk->final_signature->email : "";
 			// libgit2 git_time is seconds since epoch (UTC).
-			author_date = Timestamp::FromEpochSeconds(hunk->final_signature->when.time);
-		}
-		string orig_path = hunk->orig_path ? string(hunk->orig_path) : file_path;
-		bool boundary = hunk->boundary != 0;
-
-		if (per_line) {
-			for (size_t offset = 0; offset < hunk->lines_in_hunk; offset++) {
-				int64_t line_no = static_cast<int64_t>(hunk->final_start_line_number + offset);
-				GitBlameRow row;
-				row.repo_path = repo_path;
-				row.file_path = file_path;
-				row.file_ext = file_ext;
-				row.revision = revision;
-				row.line_number = line_no;
-				if (have_text && line_no >= 1 && static_cast<size_t>(line_no) <= file_lines.size()) {
-					row.line_content = file_lines[line_no - 1];
-					row.line_content_is_null = false;
-				} else {
-					row.line_content_is_null = true;
-				}
-				row.commit_hash = commit_hash;
-				row.author_name = author_name;
-				row.author_email = author_email;
-				row.author_date = author_date;
-				row.orig_commit_hash = orig_commit_hash;
-				row.orig_path = orig_path;
-				row.orig_line_number = static_cast<int64_t>(hunk->orig_start_line_number + offset);
-				row.boundary = boundary;
-				rows.push_back(std::move(row));
-			}
-		} else {
-			GitBlameRow row;
-			row.repo_path = repo_path;
-			row.file_path = file_path;
-			row.file_ext = file_ext;
-			row.revision = revision;
-			row.start_line = static_cast<int64_t>(hunk->final_start_line_number);
-			row.line_count = static_cast<int64_t>(hunk->lines_in_hunk);
-			row.orig_start_line = static_cast<int64_t>(hunk->orig_start_line_number);
-			row.commit_hash = commit_hash;
-			row.author_name = author_name;
-			row.author_email = author_email;
-			row.author_date = author_date;
-			row.orig_commit_hash = orig_commit_hash;
-			row.orig_path = orig_path;
-			row.boundary = boundary;
-			rows.push_back(std::move(row));
+			out.author_date = Timestamp::FromEpochSeconds(hunk->final_signature->when.time);
 		}
+		out.orig_path = hunk->orig_path ? string(hunk->orig_path) : file_path;
+		out.boundary = hunk->boundary != 0;
+		result.hunks.push_back(std::move(out));
 	}
 
 	git_blame_free(blame);
-	git_commit_free(commit);
-	git_object_free(rev_obj);
 }
 
 //===--------------------------------------------------------------------===//
@@ -326,21 +245,83 @@ static void DefineHunksSchema(vector<LogicalType> &return_types, vector<string>
 	         "orig_commit_hash", "orig_path",   "orig_start_line", "boundary"};
 }
 
-static void OutputHunkRow(DataChunk &output, const GitBlameRow &row, idx_t row_idx) {
-	output.SetValue(0, row_idx, Value(row.repo_path));
-	output.SetValue(1, row_idx, Value(row.file_path));
-	output.SetValue(2, row_idx, Value(row.file_ext));
-	output.SetValue(3, row_idx, Value(row.revision));
-	output.SetValue(4, row_idx, Value::BIGINT(row.start_line));
-	output.SetValue(5, row_idx, Value::BIGINT(row.line_count));
-	output.SetValue(6, row_idx, Value(row.commit_hash));
-	output.SetValue(7, row_idx, Value(row.author_name));
-	output.SetValue(8, row_idx, Value(row.author_email));
-	output.SetValue(9, row_idx, Value::TIMESTAMP(row.author_date));
-	output.SetValue(10, row_idx, Value(row.orig_commit_hash));
-	output.SetValue(11, row_idx, Value(row.orig_path));
-	output.SetValue(12, row_idx, Value::BIGINT(row.orig_start_line));
-	output.SetValue(13, row_idx, Value::BOOLEAN(row.boundary));
+static void OutputHunkRow(DataChunk &output, const GitBlameResult &result, const GitBlameHunk &hunk, idx_t row_idx) {
+	output.SetValue(0, row_idx, Value(result.repo_path));
+	output.SetValue(1, row_idx, Value(result.file_path));
+	output.SetValue(2, row_idx, Value(result.file_ext));
+	output.SetValue(3, row_idx, Value(result.revision));
+	output.SetValue(4, row_idx, Value::BIGINT(hunk.start_line));
+	output.SetValue(5, row_idx, Value::BIGINT(hunk.line_count));
+	SetGitOid(output.data[6], row_idx, &hunk.commit_id);
+	output.SetValue(7, row_idx, Value(hunk.author_name));
+	output.SetValue(8, row_idx, Value(hunk.author_email));
+	output.SetValue(9, row_idx, Value::TIMESTAMP(hunk.author_date));
+	SetGitOid(output.data[10], row_idx, &hunk.orig_commit_id);
+	output.SetValue(11, row_idx, Value(hunk.orig_path));
+	output.SetValue(12, row_idx, Value::BIGINT(hunk.orig_start_line));
+	output.SetValue(13, row_idx, Value::BOOLEAN(hunk.boundary));
+}
+
+//===--------------------------------------------------------------------===//
+// git_blame per-line schema and row emission (shared by all four functions)
+//===--------------------------------------------------------------------===//
+
+static void DefineBlameSchema(vector<LogicalType> &return_types, vector<string> &names) {
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR,   LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::BIGINT,  LogicalType::VARCHAR,   LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::VARCHAR, LogicalType::TIMESTAMP, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::BIGINT,  LogicalType::BOOLEAN};
+	names = {"repo_path",        "file_path",   "file_ext",         "revision",     "line_number",
+	         "line_content",     "commit_hash", "author_name",      "author_email", "author_date",
+	         "orig_commit_hash", "orig_path",   "orig_line_number", "boundary"};
+}
+
+// line_content is written straight into the output vector from the line view
+// (one copy into the vector's string heap) instead of via a Value.
+static void OutputBlameRow(DataChunk &output, const GitBlameResult &result, const GitBlameHunk &hunk, idx_t offset,
+                           idx_t row_idx) {
+	int64_t line_no = hunk.start_line + static_cast<int64_t>(offset);
+	output.SetValue(0, row_idx, Value(result.repo_path));
+	output.SetValue(1, row_idx, Value(result.file_path));
+	output.SetValue(2, row_idx, Value(result.file_ext));
+	output.SetValue(3, row_idx, Value(result.revision));
+	output.SetValue(4, row_idx, Value::BIGINT(line_no));
+	auto &content_vec = output.data[5];
+	if (result.have_text && line_no >= 1 && static_cast<idx_t>(line_no) <= result.lines.size()) {
+		FlatVector::GetData<string_t>(content_vec)[row_idx] =
+		    StringVector::AddString(content_vec, result.lines[static_cast<idx_t>(line_no - 1)]);
+	} else {
+		FlatVector::SetNull(content_vec, row_idx, true);
+	}
+	SetGitOid(output.data[6], row_idx, &hunk.commit_id);
+	output.SetValue(7, row_idx, Value(hunk.author_name));
+	output.SetValue(8, row_idx, Value(hunk.author_email));
+	output.SetValue(9, row_idx, Value::TIMESTAMP(hunk.author_date));
+	SetGitOid(output.data[10], row_idx, &hunk.orig_commit_id);
+	output.SetValue(11, row_idx, Value(hunk.orig_path));
+	output.SetValue(12, row_idx, Value::BIGINT(hunk.orig_start_line + static_cast<int64_t>(offset)));
+	output.SetValue(13, row_idx, Value::BOOLEAN(hunk.boundary));
+}
+
+// Emits up to STANDARD_VECTOR_SIZE rows of `result` starting at `cursor` and
+// advances it. Returns the number of rows written; 0 means `result` is done.
+static idx_t EmitBlameRows(DataChunk &output, const GitBlameResult &result, GitBlameCursor &cursor, bool per_line) {
+	idx_t output_count = 0;
+	while (output_count < STANDARD_VECTOR_SIZE && cursor.hunk < result.hunks.size()) {
+		const auto &hunk = result.hunks[cursor.hunk];
+		if (!per_line) {
+			OutputHunkRow(output, result, hunk, output_count++);
+			cursor.hunk++;
+			continue;
+		}
+		if (cursor.line >= static_cast<idx_t>(hunk.line_count)) {
+			cursor.hunk++;
+			cursor.line = 0;
+			continue;
+		}
+		OutputBlameRow(output, result, hunk, cursor.line++, output_count++);
+	}
+	return output_count;
 }
 
 //===--------------------------------------------------------------------===//
@@ -354,16 +335,25 @@ struct GitBlameBindData : public TableFunctionData {
 	GitBlameOptions opts;
 	bool per_line = true; // false for *_hunks variants
 	bool is_lateral = false;
-	vector<GitBlameRow> rows; // Materialized at bind time for static forms
+	unique_ptr<GitBlameResult> result; // Computed at bind time for static forms
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+
+	// Result cache (static forms): the key, and the cached rows that replace
+	// `result` on a hit
+	string result_cache_key;
+	shared_ptr<const ColumnDataCollection> cached_result;
+};
+
+struct GitBlameGlobalState : public GlobalTableFunctionState {
+	GitResultCacheScan result_cache;
 };
 
 struct GitBlameLocalState : public LocalTableFunctionState {
-	idx_t current_index = 0;
+	GitBlameCursor cursor;
 
 	// LATERAL processing state (unused in static form)
-	vector<GitBlameRow> current_rows;
+	unique_ptr<GitBlameResult> current_result;
 	idx_t current_input_row = 0;
-	idx_t current_output_row = 0;
 	bool initialized_row = false;
 };
 
@@ -410,6 +400,27 @@ static void ApplyBlameNamedParams(const TableFunctionBindInput &input, GitBlameB
 	}
 }
 
+// Static forms: sets the result cache key of a blame at a resolved commit
+// and looks it up; true on a hit, when the blame need not be computed. With
+// use_mailmap the result also depends on the current .mailmap, so it is not
+// cached.
+static bool LookupCachedBlame(ClientContext &context, git_repository *repo, const char *func_name,
+                              const vector<LogicalType> &return_types, GitBlameBindData &bind_data) {
+	auto cache = GitResultCache::Get(context);
+	git_oid commit_id;
+	if (!cache || bind_data.opts.use_mailmap || !ResolveCommitId(repo, bind_data.revision, commit_id)) {
+		return false;
+	}
+	auto &opts = bind_data.opts;
+	bind_data.result_cache_key = GitResultCacheKey(
+	    func_name, return_types,
+	    {bind_data.repo_path, bind_data.file_path, bind_data.revision, oid_to_hex(&commit_id),
+	     to_string(opts.min_line), to_string(opts.max_line), opts.ignore_whitespace ? "ws" : "",
+	     opts.first_parent ? "first_parent" : ""});
+	bind_data.cached_result = cache->Lookup(bind_data.result_cache_key, return_types);
+	return bind_data.cached_result != nullptr;
+}
+
 static unique_ptr<FunctionData> GitBlameHunksBind(ClientContext &context, TableFunctionBindInput &input,
                                                   vector<LogicalType> &return_types, vector<string> &names) {
 	DefineHunksSchema(return_types, names);
@@ -456,6 +467,8 @@ static unique_ptr<FunctionData> GitBlameHunksBind(ClientContext &context, TableF
 	bind_data->file_path = resolved_file_path;
 	bind_data->revision = resolved_revision;
 
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+
 	git_repository *repo = nullptr;
 	int error = git_repository_open(&repo, bind_data->repo_path.c_str());
 	if (error != 0) {
@@ -464,8 +477,11 @@ static unique_ptr<FunctionData> GitBlameHunksBind(ClientContext &context, TableF
 		                      e ? e->message : "unknown error");
 	}
 	try {
-		CollectBlameRows(repo, bind_data->repo_path, bind_data->file_path, bind_data->revision, bind_data->opts,
-		                 /*per_line=*/false, bind_data->rows);
+		if (!LookupCachedBlame(context, repo, "git_blame_hunks", return_types, *bind_data)) {
+			bind_data->result = make_uniq<GitBlameResult>();
+			CollectBlame(repo, bind_data->repo_path, bind_data->file_path, bind_data->revision, bind_data->opts,
+			             /*load_text=*/false, *bind_data->result);
+		}
 	} catch (...) {
 		git_repository_free(repo);
 		throw;
@@ -476,7 +492,13 @@ static unique_ptr<FunctionData> GitBlameHunksBind(ClientContext &context, TableF
 }
 
 static unique_ptr<GlobalTableFunctionState> GitBlameInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-	return make_uniq<GlobalTableFunctionState>();
+	auto &bind_data = input.bind_data->Cast<GitBlameBindData>();
+	auto state = make_uniq<GitBlameGlobalState>();
+	if (!bind_data.result_cache_key.empty()) {
+		state->result_cache.Initialize(GitResultCache::Get(context), bind_data.result_cache_key,
+		                               bind_data.cached_result);
+	}
+	return std::move(state);
 }
 
 static unique_ptr<LocalTableFunctionState> GitBlameLocalInit(ExecutionContext &context, TableFunctionInitInput &input,
@@ -487,51 +509,20 @@ static unique_ptr<LocalTableFunctionState> GitBlameLocalInit(ExecutionContext &c
 static void GitBlameHunksFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<GitBlameBindData>();
 	auto &local_state = data_p.local_state->Cast<GitBlameLocalState>();
-
-	idx_t output_count = 0;
-	while (local_state.current_index < bind_data.rows.size() && output_count < STANDARD_VECTOR_SIZE) {
-		OutputHunkRow(output, bind_data.rows[local_state.current_index], output_count);
-		local_state.current_index++;
-		output_count++;
+	auto &global_state = data_p.global_state->Cast<GitBlameGlobalState>();
+	if (global_state.result_cache.IsHit()) {
+		global_state.result_cache.Replay(output);
+		return;
 	}
-	output.SetCardinality(output_count);
+
+	output.SetCardinality(EmitBlameRows(output, *bind_data.result, local_state.cursor, /*per_line=*/false));
+	global_state.result_cache.Record(output);
 }
 
 //===--------------------------------------------------------------------===//
-// git_blame per-line schema + exec
+// git_blame per-line exec
 //===--------------------------------------------------------------------===//
 
-static void DefineBlameSchema(vector<LogicalType> &return_types, vector<string> &names) {
-	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR,   LogicalType::VARCHAR, LogicalType::VARCHAR,
-	                LogicalType::BIGINT,  LogicalType::VARCHAR,   LogicalType::VARCHAR, LogicalType::VARCHAR,
-	                LogicalType::VARCHAR, LogicalType::TIMESTAMP, LogicalType::VARCHAR, LogicalType::VARCHAR,
-	                LogicalType::BIGINT,  LogicalType::BOOLEAN};
-	names = {"repo_path",        "file_path",   "file_ext",         "revision",     "line_number",
-	         "line_content",     "commit_hash", "author_name",      "author_email", "author_date",
-	         "orig_commit_hash", "orig_path",   "orig_line_number", "boundary"};
-}
-
-static void OutputBlameRow(DataChunk &output, const GitBlameRow &row, idx_t row_idx) {
-	output.SetValue(0, row_idx, Value(row.repo_path));
-	output.SetValue(1, row_idx, Value(row.file_path));
-	output.SetValue(2, row_idx, Value(row.file_ext));
-	output.SetValue(3, row_idx, Value(row.revision));
-	output.SetValue(4, row_idx, Value::BIGINT(row.line_number));
-	if (row.line_content_is_null) {
-		output.SetValue(5, row_idx, Value());
-	} else {
-		output.SetValue(5, row_idx, Value(row.line_content));
-	}
-	output.SetValue(6, row_idx, Value(row.commit_hash));
-	output.SetValue(7, row_idx, Value(row.author_name));
-	output.SetValue(8, row_idx, Value(row.author_email));
-	output.SetValue(9, row_idx, Value::TIMESTAMP(row.author_date));
-	output.SetValue(10, row_idx, Value(row.orig_commit_hash));
-	output.SetValue(11, row_idx, Value(row.orig_path));
-	output.SetValue(12, row_idx, Value::BIGINT(row.orig_line_number));
-	output.SetValue(13, row_idx, Value::BOOLEAN(row.boundary));
-}
-
 static unique_ptr<FunctionData> GitBlameBind(ClientContext &context, TableFunctionBindInput &input,
                                              vector<LogicalType> &return_types, vector<string> &names) {
 	DefineBlameSchema(return_types, names);
@@ -577,6 +568,8 @@ static unique_ptr<FunctionData> GitBlameBind(ClientContext &context, TableFuncti
 	bind_data->file_path = resolved_file_path;
 	bind_data->revision = resolved_revision;
 
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+
 	git_repository *repo = nullptr;
 	int error = git_repository_open(&repo, bind_data->repo_path.c_str());
 	if (error != 0) {
@@ -585,8 +578,11 @@ static unique_ptr<FunctionData> GitBlameBind(ClientContext &context, TableFuncti
 		                      e ? e->message : "unknown error");
 	}
 	try {
-		CollectBlameRows(repo, bind_data->repo_path, bind_data->file_path, bind_data->revision, bind_data->opts,
-		                 /*per_line=*/true, bind_data->rows);
+		if (!LookupCachedBlame(context, repo, "git_blame", return_types, *bind_data)) {
+			bind_data->result = make_uniq<GitBlameResult>();
+			CollectBlame(repo, bind_data->repo_path, bind_data->file_path, bind_data->revision, bind_data->opts,
+			             /*load_text=*/true, *bind_data->result);
+		}
 	} catch (...) {
 		git_repository_free(repo);
 		throw;
@@ -599,14 +595,14 @@ static unique_ptr<FunctionData> GitBlameBind(ClientContext &context, TableFuncti
 static void GitBlameFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<GitBlameBindData>();
 	auto &local_state = data_p.local_state->Cast<GitBlameLocalState>();
-
-	idx_t output_count = 0;
-	while (local_state.current_index < bind_data.rows.size() && output_count < STANDARD_VECTOR_SIZE) {
-		OutputBlameRow(output, bind_data.rows[local_state.current_index], output_count);
-		local_state.current_index++;
-		output_count++;
+	auto &global_state = data_p.global_state->Cast<GitBlameGlobalState>();
+	if (global_state.result_cache.IsHit()) {
+		global_state.result_cache.Replay(output);
+		return;
 	}
-	output.SetCardinality(output_count);
+
+	output.SetCardinality(EmitBlameRows(output, *bind_data.result, local_state.cursor, /*per_line=*/true));
+	global_state.result_cache.Record(output);
 }
 
 //===--------------------------------------------------------------------===//
@@ -637,7 +633,9 @@ static unique_ptr<FunctionData> GitBlameLateralBind(ClientContext &context, Tabl
 static unique_ptr<FunctionData> GitBlameHunksEachBind(ClientContext &context, TableFunctionBindInput &input,
                                                       vector<LogicalType> &return_types, vector<string> &names) {
 	DefineHunksSchema(return_types, names);
-	return GitBlameLateralBind(context, input, /*per_line=*/false);
+	auto bind_data = GitBlameLateralBind(context, input, /*per_line=*/false);
+	bind_data->Cast<GitBlameBindData>().gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return bind_data;
 }
 
 // Resolve a LATERAL input path (URI or plain path) + optional per-row revision
@@ -709,7 +707,7 @@ static OperatorResultType GitBlameEachImpl(ExecutionContext &context, TableFunct
 				continue;
 			}
 
-			state.current_rows.clear();
+			auto result = make_uniq<GitBlameResult>();
 			git_repository *repo = nullptr;
 			int error = git_repository_open(&repo, repo_path.c_str());
 			if (error != 0) {
@@ -717,8 +715,7 @@ static OperatorResultType GitBlameEachImpl(ExecutionContext &context, TableFunct
 				continue;
 			}
 			try {
-				// Populate identity fields on each row via caller post-process below.
-				CollectBlameRows(repo, repo_path, file_path, revision, bind_data.opts, per_line, state.current_rows);
+				CollectBlame(repo, repo_path, file_path, revision, bind_data.opts, per_line, *result);
 			} catch (...) {
 				git_repository_free(repo);
 				state.current_input_row++;
@@ -726,25 +723,18 @@ static OperatorResultType GitBlameEachImpl(ExecutionContext &context, TableFunct
 			}
 			git_repository_free(repo);
 
+			state.current_result = std::move(result);
 			state.initialized_row = true;
-			state.current_output_row = 0;
+			state.cursor.Reset();
 		}
 
-		idx_t output_count = 0;
-		while (output_count < STANDARD_VECTOR_SIZE && state.current_output_row < state.current_rows.size()) {
-			if (per_line) {
-				OutputBlameRow(output, state.current_rows[state.current_output_row], output_count);
-			} else {
-				OutputHunkRow(output, state.current_rows[state.current_output_row], output_count);
-			}
-			state.current_output_row++;
-			output_count++;
-		}
+		idx_t output_count = EmitBlameRows(output, *state.current_result, state.cursor, per_line);
 		output.SetCardinality(output_count);
-
-		if (state.current_output_row >= state.current_rows.size()) {
+	
+		if (state.cursor.hunk >= state.current_result->hunks.size()) {
 			state.current_input_row++;
 			state.initialized_row = false;
+			state.current_result.reset();
 		}
 
 		if (output_count > 0) {
@@ -761,7 +751,9 @@ static OperatorResultType GitBlameHunksEachFunction(ExecutionContext &context, T
 static unique_ptr<FunctionData> GitBlameEachBind(ClientContext &context, TableFunctionBindInput &input,
                                                  vector<LogicalType> &return_types, vector<string> &names) {
 	DefineBlameSchema(return_types, names);
-	return GitBlameLateralBind(context, input, /*per_line=*/true);
+	auto bind_data = GitBlameLateralBind(context, input, /*per_line=*/true);
+	bind_data->Cast<GitBlameBindData>().gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return bind_data;
 }
 
 static OperatorResultType GitBlameEachFunction(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
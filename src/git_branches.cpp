@@ -1,7 +1,9 @@
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_utils.hpp"
 #include "git_context_manager.hpp"
+#include "git_commit_dag.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/types/value.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
@@ -61,7 +63,22 @@ unique_ptr<FunctionData> GitBranchesBind(ClientContext &context, TableFunctionBi
 
 	names = {"repo_path", "branch_name", "commit_hash", "is_current", "is_remote"};
 
-	return make_uniq<GitBranchesFunctionData>(params.repo_path_or_uri, resolved_repo_path);
+	auto bind_data = make_uniq<GitBranchesFunctionData>(params.repo_path_or_uri, resolved_repo_path);
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "compare_to" && !kv.second.IsNull()) {
+			bind_data->compare_to = kv.second.GetValue<string>();
+		}
+	}
+	if (!bind_data->compare_to.empty()) {
+		return_types.push_back(LogicalType::BIGINT);  // ahead
+		return_types.push_back(LogicalType::BIGINT);  // behind
+		return_types.push_back(LogicalType::BOOLEAN); // is_merged
+		names.push_back("ahead");
+		names.push_back("behind");
+		names.push_back("is_merged");
+	}
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
 }
 
 //===--------------------------------------------------------------------===//
@@ -86,7 +103,9 @@ unique_ptr<FunctionData> GitBranchesEachBind(ClientContext &context, TableFuncti
 	names = {"repo_path", "branch_name", "commit_hash", "is_current", "is_remote"};
 
 	// For LATERAL functions, store the ref parameter (defaults to "HEAD" from ParseLateralGitParams)
-	return make_uniq<GitBranchesFunctionData>(params.ref);
+	auto bind_data = make_uniq<GitBranchesFunctionData>(params.ref);
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
 }
 
 //===--------------------------------------------------------------------===//
@@ -97,6 +116,98 @@ unique_ptr<GlobalTableFunctionState> GitBranchesInitGlobal(ClientContext &contex
 	return make_uniq<GlobalTableFunctionState>();
 }
 
+// commit_hash of a row; a symbolic branch gets '', which FinalizeGitOidColumns
+// turns into NULL for GITOID output.
+static void SetBranchTarget(Vector &hashes, idx_t row_idx, const GitBranchesRow &row) {
+	if (row.has_commit) {
+		SetGitOid(hashes, row_idx, &row.commit_id);
+	} else {
+		hashes.SetValue(row_idx, Value(""));
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// compare_to: ahead/behind and merged status for every branch
+//===--------------------------------------------------------------------===//
+
+static void ProcessBranchesForInOut(git_repository *repo, const string &repo_path, vector<GitBranchesRow> &rows);
+
+// Fills ahead/behind/is_merged of every row against `compare_to` with
+// multi-tip walks over the commit DAG instead of one graph walk per branch.
+static void ComputeBranchComparisons(git_repository *repo, const string &compare_to, vector<GitBranchesRow> &rows) {
+	git_object *obj = nullptr;
+	git_object *commit = nullptr;
+	if (git_revparse_single(&obj, repo, compare_to.c_str()) != 0 ||
+	    git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) != 0) {
+		const git_error *e = git_error_last();
+		git_object_free(obj);
+		throw IOException("git_branches: unable to resolve compare_to '%s': %s", compare_to,
+		                  e ? e->message : "unknown error");
+	}
+	git_object_free(obj);
+
+	GitCommitDag dag(repo);
+	idx_t base = dag.Node(*git_object_id(commit));
+	git_object_free(commit);
+
+	git_odb *odb = nullptr;
+	if (git_repository_odb(&odb, repo) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_branches: failed to open object database: %s", e ? e->message : "unknown error");
+	}
+
+	// Branches whose tip is not a commit (or is unreadable) keep NULL counts.
+	vector<idx_t> tips;
+	vector<idx_t> tip_rows;
+	for (idx_t i = 0; i < rows.size(); i++) {
+		git_object_t type;
+		size_t size;
+		if (!rows[i].has_commit) {
+			continue;
+		}
+		auto &tip_id = rows[i].commit_id;
+		if (git_odb_read_header(&size, &type, odb, &tip_id) == 0 && type == GIT_OBJECT_COMMIT) {
+			tips.push_back(dag.Node(tip_id));
+			tip_rows.push_back(i);
+		}
+	}
+	git_odb_free(odb);
+
+	vector<GitAheadBehind> counts;
+	ComputeAheadBehind(dag, base, tips, counts);
+	for (idx_t i = 0; i < tips.size(); i++) {
+		auto &row = rows[tip_rows[i]];
+		row.ahead = counts[i].ahead;
+		row.behind = counts[i].behind;
+		row.is_merged = counts[i].ahead == 0;
+	}
+}
+
+static void EmitComparedBranches(const GitBranchesFunctionData &bind_data, GitBranchesLocalState &local_state,
+                                 DataChunk &output) {
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE && local_state.current_output_row < local_state.current_rows.size()) {
+		auto &row = local_state.current_rows[local_state.current_output_row++];
+		output.SetValue(0, count, Value(bind_data.repo_path));
+		output.SetValue(1, count, Value(row.branch_name));
+		SetBranchTarget(output.data[2], count, row);
+		output.SetValue(3, count, Value::BOOLEAN(row.is_current));
+		output.SetValue(4, count, Value::BOOLEAN(row.is_remote));
+		if (row.ahead >= 0) {
+			output.SetValue(5, count, Value::BIGINT(row.ahead));
+			output.SetValue(6, count, Value::BIGINT(row.behind));
+			output.SetValue(7, count, Value::BOOLEAN(row.is_merged));
+		} else {
+			output.SetValue(5, count, Value());
+			output.SetValue(6, count, Value());
+			output.SetValue(7, count, Value());
+		}
+		count++;
+	}
+	output.SetCardinality(count);
+	FinalizeGitOidColumns(output, bind_data.gitoid_columns);
+}
+
 //===--------------------------------------------------------------------===//
 // Git Branches Function
 //===--------------------------------------------------------------------===//
@@ -105,6 +216,22 @@ void GitBranchesFunction(ClientContext &context, TableFunctionInput &data_p, Dat
 	auto &bind_data = data_p.bind_data->Cast<GitBranchesFunctionData>();
 	auto &local_state = data_p.local_state->Cast<GitBranchesLocalState>();
 
+	if (!bind_data.compare_to.empty()) {
+		if (!local_state.initialized) {
+			int error = git_repository_open(&local_state.repo, bind_data.resolved_repo_path.c_str());
+			if (error != 0) {
+				const git_error *e = git_error_last();
+				throw IOException("Failed to open git repository '%s': %s", bind_data.resolved_repo_path,
+				                  e ? e->message : "Unknown error");
+			}
+			ProcessBranchesForInOut(local_state.repo, bind_data.repo_path, local_state.current_rows);
+			ComputeBranchComparisons(local_state.repo, bind_data.compare_to, local_state.current_rows);
+			local_state.initialized = true;
+		}
+		EmitComparedBranches(bind_data, local_state, output);
+		return;
+	}
+
 	if (!local_state.initialized) {
 		int error = git_repository_open(&local_state.repo, bind_data.resolved_repo_path.c_str());
 		if (error != 0) {
@@ -138,9 +265,7 @@ void GitBranchesFunction(ClientContext &context, TableFunctionInput &data_p, Dat
 		// Get commit hash
 		const git_oid *oid = git_reference_target(ref);
 		if (oid) {
-			char hash_str[GIT_OID_HEXSZ + 1];
-			git_oid_tostr(hash_str, sizeof(hash_str), oid);
-			output.SetValue(2, count, Value(hash_str));
+			SetGitOid(output.data[2], count, oid);
 		} else {
 			output.SetValue(2, count, Value(""));
 		}
@@ -158,6 +283,7 @@ void GitBranchesFunction(ClientContext &context, TableFunctionInput &data_p, Dat
 	}
 
 	output.SetCardinality(count);
+	FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 }
 
 //===--------------------------------------------------------------------===//
@@ -194,11 +320,8 @@ static void ProcessBranchesForInOut(git_repository *repo, const string &repo_pat
 		// Get commit hash
 		const git_oid *oid = git_reference_target(ref);
 		if (oid) {
-			char hash_str[GIT_OID_HEXSZ + 1];
-			git_oid_tostr(hash_str, sizeof(hash_str), oid);
-			row.commit_hash = hash_str;
-		} else {
-			row.commit_hash = "";
+			git_oid_cpy(&row.commit_id, oid);
+			row.has_commit = true;
 		}
 
 		// Check if current branch
@@ -330,7 +453,7 @@ static OperatorResultType GitBranchesEachFunction(ExecutionContext &context, Tab
 
 			output.SetValue(0, output_count, Value(resolved_repo_path));
 			output.SetValue(1, output_count, Value(row.branch_name));
-			output.SetValue(2, output_count, Value(row.commit_hash));
+			SetBranchTarget(output.data[2], output_count, row);
 			output.SetValue(3, output_count, Value(row.is_current));
 			output.SetValue(4, output_count, Value(row.is_remote));
 
@@ -339,6 +462,7 @@ static OperatorResultType GitBranchesEachFunction(ExecutionContext &context, Tab
 		}
 
 		output.SetCardinality(output_count);
+		FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 
 		if (state.current_output_row >= state.current_rows.size()) {
 			state.current_input_row++;
@@ -359,6 +483,7 @@ void RegisterGitBranchesFunction(ExtensionLoader &loader) {
 	                                GitBranchesInitGlobal);
 	git_branches_func.init_local = GitBranchesLocalInit;
 	git_branches_func.named_parameters["repo_path"] = LogicalType::VARCHAR;
+	git_branches_func.named_parameters["compare_to"] = LogicalType::VARCHAR;
 	loader.RegisterFunction(git_branches_func);
 
 	// Zero-argument version (defaults to current directory)
@@ -366,6 +491,7 @@ void RegisterGitBranchesFunction(ExtensionLoader &loader) {
 	                                     GitBranchesInitGlobal);
 	git_branches_func_zero.init_local = GitBranchesLocalInit;
 	git_branches_func_zero.named_parameters["repo_path"] = LogicalType::VARCHAR;
+	git_branches_func_zero.named_parameters["compare_to"] = LogicalType::VARCHAR;
 	loader.RegisterFunction(git_branches_func_zero);
 
 	// LATERAL git_branches_each function (repository path comes from LATERAL context) - ONLY for dynamic input
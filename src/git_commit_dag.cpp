@@ -0,0 +1,219 @@
+#include "git_commit_dag.hpp"
+
+#include "duckdb/common/bit_utils.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+
+namespace duckdb {
+
+static constexpr idx_t AHEAD_BEHIND_TIPS_PER_WALK = 63;
+
+bool ReadCommitHeader(git_odb *odb, const git_oid &oid, vector<git_oid> &parents, int64_t &commit_time) {
+	git_odb_object *obj = nullptr;
+	if (git_odb_read(&obj, odb, &oid) != 0) {
+		return false;
+	}
+	if (git_odb_object_type(obj) != GIT_OBJECT_COMMIT) {
+		git_odb_object_free(obj);
+		return false;
+	}
+	auto data = static_cast<const char *>(git_odb_object_data(obj));
+	size_t size = git_odb_object_size(obj);
+	commit_time = 0;
+
+	// "tree", then one "parent" line per parent, "author", "committer", ...
+	size_t pos = 0;
+	while (pos < size) {
+		auto eol = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+		if (!eol || eol == data + pos) {
+			break; // end of the header block
+		}
+		const char *line = data + pos;
+		size_t length = eol - line;
+		if (length >= 7 + GIT_OID_HEXSZ && memcmp(line, "parent ", 7) == 0) {
+			git_oid parent;
+			if (git_oid_fromstrn(&parent, line + 7, GIT_OID_HEXSZ) == 0) {
+				parents.push_back(parent);
+			}
+		} else if (length > 10 && memcmp(line, "committer ", 10) == 0) {
+			// "committer Name <email> 1700000000 +0100"
+			const char *email_end = line + length;
+			while (email_end > line && *(email_end - 1) != '>') {
+				email_end--;
+			}
+			commit_time = strtoll(email_end, nullptr, 10);
+			break;
+		}
+		pos = eol - data + 1;
+	}
+	git_odb_object_free(obj);
+	return true;
+}
+
+GitCommitDag::GitCommitDag(git_repository *repo) {
+	git_repository_odb(&odb, repo);
+	graph = GitCommitGraphFile::Open(string(git_repository_commondir(repo)) + "objects/");
+}
+
+GitCommitDag::~GitCommitDag() {
+	git_odb_free(odb);
+}
+
+idx_t GitCommitDag::Node(const git_oid &oid) {
+	auto it = index.find(oid);
+	if (it != index.end()) {
+		return it->second;
+	}
+	idx_t node = nodes.size();
+	DagNode entry;
+	git_oid_cpy(&entry.id, &oid);
+	idx_t pos;
+	if (graph && graph->Find(oid, pos)) {
+		entry.graph_pos = pos;
+		entry.generation = graph->Generation(pos);
+		entry.commit_time = graph->CommitTime(pos);
+	}
+	nodes.push_back(std::move(entry));
+	index.emplace(oid, node);
+	return node;
+}
+
+const vector<idx_t> &GitCommitDag::Parents(idx_t node) {
+	if (nodes[node].parents_loaded) {
+		return nodes[node].parents;
+	}
+
+	vector<idx_t> parents;
+	vector<idx_t> positions;
+	if (nodes[node].graph_pos != DConstants::INVALID_INDEX && graph->Parents(nodes[node].graph_pos, positions)) {
+		for (auto pos : positions) {
+			git_oid parent_id;
+			graph->CommitId(pos, parent_id);
+			parents.push_back(Node(parent_id));
+		}
+	} else if (odb) {
+		vector<git_oid> parent_ids;
+		int64_t commit_time;
+		git_oid id;
+		git_oid_cpy(&id, &nodes[node].id);
+		if (ReadCommitHeader(odb, id, parent_ids, commit_time)) {
+			nodes[node].commit_time = commit_time;
+			for (auto &parent_id : parent_ids) {
+				parents.push_back(Node(parent_id));
+			}
+		}
+	}
+	nodes[node].parents = std::move(parents);
+	nodes[node].parents_loaded = true;
+	return nodes[node].parents;
+}
+
+uint32_t GitCommitDag::Generation(idx_t node) {
+	if (nodes[node].generation != 0) {
+		return nodes[node].generation;
+	}
+	// Post-order over parents without a known generation.
+	vector<idx_t> stack {node};
+	while (!stack.empty()) {
+		idx_t current = stack.back();
+		if (nodes[current].generation != 0) {
+			stack.pop_back();
+			continue;
+		}
+		vector<idx_t> parents = Parents(current);
+		uint32_t max_parent = 0;
+		bool ready = true;
+		for (auto parent : parents) {
+			uint32_t generation = nodes[parent].generation;
+			if (generation == 0) {
+				stack.push_back(parent);
+				ready = false;
+			} else {
+				max_parent = MaxValue(max_parent, generation);
+			}
+		}
+		if (ready) {
+			nodes[current].generation = max_parent + 1;
+			stack.pop_back();
+		}
+	}
+	return nodes[node].generation;
+}
+
+int64_t GitCommitDag::CommitTime(idx_t node) {
+	Parents(node);
+	return nodes[node].commit_time;
+}
+
+static void AheadBehindWalk(GitCommitDag &dag, idx_t base, const vector<idx_t> &tips, idx_t first, idx_t count,
+                            vector<GitAheadBehind> &out) {
+	const uint64_t base_bit = 1;
+	const uint64_t all_bits = (count + 1 == 64) ? ~uint64_t(0) : ((uint64_t(1) << (count + 1)) - 1);
+
+	unordered_map<idx_t, uint64_t> reached; // node -> bits of the tips (and base) that reach it
+	std::priority_queue<std::pair<uint32_t, idx_t>> queue;
+	idx_t active = 0; // queued commits not yet reached by everything
+
+	auto enqueue = [&](idx_t node, uint64_t bits) {
+		auto entry = reached.find(node);
+		if (entry == reached.end()) {
+			reached.emplace(node, bits);
+			queue.emplace(dag.Generation(node), node);
+			if (bits != all_bits) {
+				active++;
+			}
+			return;
+		}
+		uint64_t before = entry->second;
+		entry->second |= bits;
+		if (before != all_bits && entry->second == all_bits) {
+			active--;
+		}
+	};
+
+	enqueue(base, base_bit);
+	for (idx_t i = 0; i < count; i++) {
+		enqueue(tips[first + i], uint64_t(1) << (i + 1));
+	}
+
+	while (!queue.empty() && active > 0) {
+		idx_t node = queue.top().second;
+		queue.pop();
+		uint64_t bits = reached[node];
+		if (bits != all_bits) {
+			active--;
+		}
+
+		// Reached from the base: behind every tip that does not reach it.
+		// Otherwise: ahead for every tip that does. Fully reached commits
+		// count for nothing but still pass their bits on to their parents.
+		uint64_t counted = (bits & base_bit) ? (all_bits & ~bits) : (bits & ~base_bit);
+		while (counted) {
+			idx_t bit = static_cast<idx_t>(CountZeros<uint64_t>::Trailing(counted));
+			auto &result = out[first + bit - 1];
+			if (bits & base_bit) {
+				result.behind++;
+			} else {
+				result.ahead++;
+			}
+			counted &= counted - 1;
+		}
+
+		vector<idx_t> parents = dag.Parents(node);
+		for (auto parent : parents) {
+			enqueue(parent, bits);
+		}
+	}
+}
+
+void ComputeAheadBehind(GitCommitDag &dag, idx_t base, const vector<idx_t> &tips, vector<GitAheadBehind> &out) {
+	out.assign(tips.size(), GitAheadBehind());
+	for (idx_t first = 0; first < tips.size(); first += AHEAD_BEHIND_TIPS_PER_WALK) {
+		idx_t count = MinValue<idx_t>(AHEAD_BEHIND_TIPS_PER_WALK, tips.size() - first);
+		AheadBehindWalk(dag, base, tips, first, count, out);
+	}
+}
+
+} // namespace duckdb
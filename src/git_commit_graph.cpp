@@ -0,0 +1,224 @@
+#include "duckdb.hpp"
+#include "git_functions.hpp"
+#include "git_context_manager.hpp"
+#include "git_commit_dag.hpp"
+#include "git_oid_type.hpp"
+#include "git_utils.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/function/function_set.hpp"
+#include "duckdb/common/exception.hpp"
+
+#include <git2.h>
+#include <algorithm>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// git_commit_graph — the commit DAG with dense integer ids
+//
+// Commits reachable from the start revision (or every ref) are numbered
+// 0..n-1 in topological order, parents before children: ids are sorted by
+// generation number, ties broken by object id, so the numbering is stable
+// for an unchanged history. Each row carries the parent ids as a LIST, which
+// is the CSR form of the edge list (UNNEST it for plain edges); the
+// (commit_id, commit_hash) columns are the id -> object id mapping.
+//===--------------------------------------------------------------------===//
+
+struct GitCommitGraphFunctionData : public TableFunctionData {
+	string repo_path;
+	string ref;
+	bool all_refs = false;
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+};
+
+struct GitCommitGraphGlobalState : public GlobalTableFunctionState {
+	vector<git_oid> ids;              // by commit_id
+	vector<uint32_t> generation;      // by commit_id
+	vector<uint32_t> parent_offsets;  // parents of commit_id i: parents[parent_offsets[i] .. parent_offsets[i + 1])
+	vector<int32_t> parents;
+	idx_t offset = 0;
+};
+
+static void CollectStartCommits(git_repository *repo, const GitCommitGraphFunctionData &bind_data,
+                                vector<git_oid> &tips) {
+	if (bind_data.all_refs) {
+		git_reference_iterator *it = nullptr;
+		if (git_reference_iterator_new(&it, repo) != 0) {
+			return;
+		}
+		git_reference *ref;
+		while (!git_reference_next(&ref, it)) {
+			git_object *commit = nullptr;
+			if (git_reference_peel(&commit, ref, GIT_OBJECT_COMMIT) == 0) {
+				tips.push_back(*git_object_id(commit));
+				git_object_free(commit);
+			}
+			git_reference_free(ref);
+		}
+		git_reference_iterator_free(it);
+		return;
+	}
+
+	git_object *obj = nullptr;
+	git_object *commit = nullptr;
+	if (git_revparse_single(&obj, repo, bind_data.ref.c_str()) != 0 ||
+	    git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) != 0) {
+		const git_error *e = git_error_last();
+		git_object_free(obj);
+		throw IOException("git_commit_graph: unable to parse ref '%s': %s", bind_data.ref,
+		                  e ? e->message : "unable to parse OID");
+	}
+	tips.push_back(*git_object_id(commit));
+	git_object_free(commit);
+	git_object_free(obj);
+}
+
+static void BuildCommitGraph(git_repository *repo, const vector<git_oid> &tips, GitCommitGraphGlobalState &state) {
+	GitCommitDag dag(repo);
+	for (auto &tip : tips) {
+		dag.Node(tip);
+	}
+	for (idx_t node = 0; node < dag.Size(); node++) {
+		dag.Parents(node);
+	}
+
+	idx_t count = dag.Size();
+	vector<uint32_t> order(count);
+	vector<uint32_t> node_generation(count);
+	for (idx_t node = 0; node < count; node++) {
+		order[node] = static_cast<uint32_t>(node);
+		node_generation[node] = dag.Generation(node);
+	}
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		if (node_generation[a] != node_generation[b]) {
+			return node_generation[a] < node_generation[b];
+		}
+		return git_oid_cmp(&dag.Id(a), &dag.Id(b)) < 0;
+	});
+	vector<int32_t> rank(count);
+	for (idx_t i = 0; i < count; i++) {
+		rank[order[i]] = static_cast<int32_t>(i);
+	}
+
+	state.ids.resize(count);
+	state.generation.resize(count);
+	state.parent_offsets.resize(count + 1);
+	for (idx_t i = 0; i < count; i++) {
+		uint32_t node = order[i];
+		git_oid_cpy(&state.ids[i], &dag.Id(node));
+		state.generation[i] = node_generation[node];
+		state.parent_offsets[i] = static_cast<uint32_t>(state.parents.size());
+		for (auto parent : dag.Parents(node)) {
+			state.parents.push_back(rank[parent]);
+		}
+	}
+	state.parent_offsets[count] = static_cast<uint32_t>(state.parents.size());
+}
+
+static unique_ptr<FunctionData> GitCommitGraphBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	return_types = {
+	    LogicalType::VARCHAR,                   // repo_path
+	    LogicalType::INTEGER,                   // commit_id
+	    LogicalType::VARCHAR,                   // commit_hash
+	    LogicalType::INTEGER,                   // generation
+	    LogicalType::LIST(LogicalType::INTEGER) // parent_ids
+	};
+	names = {"repo_path", "commit_id", "commit_hash", "generation", "parent_ids"};
+
+	auto params = ParseUnifiedGitParams(input, 1);
+	auto bind_data = make_uniq<GitCommitGraphFunctionData>();
+	try {
+		auto ctx = GitContextManager::Instance().ProcessGitUri(params.repo_path_or_uri, params.ref);
+		bind_data->repo_path = ctx.repo_path;
+		bind_data->ref = ctx.final_ref;
+	} catch (const std::exception &e) {
+		throw BinderException("git_commit_graph: %s", e.what());
+	}
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "all_refs") {
+			bind_data->all_refs = BooleanValue::Get(kv.second);
+		}
+	}
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> GitCommitGraphInitGlobal(ClientContext &context,
+                                                                     TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<GitCommitGraphFunctionData>();
+	auto state = make_uniq<GitCommitGraphGlobalState>();
+
+	git_repository *repo = nullptr;
+	if (git_repository_open(&repo, bind_data.repo_path.c_str()) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_commit_graph: failed to open repository '%s': %s", bind_data.repo_path,
+		                  e ? e->message : "unknown error");
+	}
+	try {
+		vector<git_oid> tips;
+		CollectStartCommits(repo, bind_data, tips);
+		BuildCommitGraph(repo, tips, *state);
+	} catch (...) {
+		git_repository_free(repo);
+		throw;
+	}
+	git_repository_free(repo);
+	return std::move(state);
+}
+
+static void GitCommitGraphFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<GitCommitGraphFunctionData>();
+	auto &state = data_p.global_state->Cast<GitCommitGraphGlobalState>();
+
+	idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.ids.size() - state.offset);
+	auto id_data = FlatVector::GetData<int32_t>(output.data[1]);
+	auto generation_data = FlatVector::GetData<int32_t>(output.data[3]);
+	auto &parent_vector = output.data[4];
+	auto list_data = FlatVector::GetData<list_entry_t>(parent_vector);
+
+	idx_t first_edge = state.parent_offsets[state.offset];
+	idx_t edge_count = state.parent_offsets[state.offset + count] - first_edge;
+	ListVector::Reserve(parent_vector, edge_count);
+	auto child_data = FlatVector::GetData<int32_t>(ListVector::GetEntry(parent_vector));
+	memcpy(child_data, state.parents.data() + first_edge, edge_count * sizeof(int32_t));
+
+	for (idx_t i = 0; i < count; i++) {
+		idx_t commit_id = state.offset + i;
+		id_data[i] = static_cast<int32_t>(commit_id);
+		SetGitOid(output.data[2], i, &state.ids[commit_id]);
+		generation_data[i] = static_cast<int32_t>(state.generation[commit_id]);
+		list_data[i].offset = state.parent_offsets[commit_id] - first_edge;
+		list_data[i].length = state.parent_offsets[commit_id + 1] - state.parent_offsets[commit_id];
+	}
+	ListVector::SetListSize(parent_vector, edge_count);
+	output.data[0].Reference(Value(bind_data.repo_path));
+
+	state.offset += count;
+	output.SetCardinality(count);
+}
+
+void RegisterGitCommitGraphFunction(ExtensionLoader &loader) {
+	TableFunctionSet git_commit_graph_set("git_commit_graph");
+
+	// git_commit_graph()
+	TableFunction zero({}, GitCommitGraphFunction, GitCommitGraphBind, GitCommitGraphInitGlobal);
+	zero.named_parameters["all_refs"] = LogicalType::BOOLEAN;
+	git_commit_graph_set.AddFunction(zero);
+
+	// git_commit_graph(repo_path_or_uri)
+	TableFunction one({LogicalType::VARCHAR}, GitCommitGraphFunction, GitCommitGraphBind, GitCommitGraphInitGlobal);
+	one.named_parameters["all_refs"] = LogicalType::BOOLEAN;
+	git_commit_graph_set.AddFunction(one);
+
+	// git_commit_graph(repo_path_or_uri, ref)
+	TableFunction two({LogicalType::VARCHAR, LogicalType::VARCHAR}, GitCommitGraphFunction, GitCommitGraphBind,
+	                  GitCommitGraphInitGlobal);
+	two.named_parameters["all_refs"] = LogicalType::BOOLEAN;
+	git_commit_graph_set.AddFunction(two);
+
+	loader.RegisterFunction(git_commit_graph_set);
+}
+
+} // namespace duckdb
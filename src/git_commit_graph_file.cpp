@@ -0,0 +1,232 @@
+#include "git_commit_graph_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace duckdb {
+
+// https://git-scm.com/docs/gitformat-commit-graph
+static constexpr uint32_t GRAPH_SIGNATURE = 0x43475048; // "CGPH"
+static constexpr uint32_t CHUNK_OID_FANOUT = 0x4f494446;  // "OIDF"
+static constexpr uint32_t CHUNK_OID_LOOKUP = 0x4f49444c;  // "OIDL"
+static constexpr uint32_t CHUNK_COMMIT_DATA = 0x43444154; // "CDAT"
+static constexpr uint32_t CHUNK_EXTRA_EDGES = 0x45444745; // "EDGE"
+static constexpr idx_t GRAPH_HEADER_SIZE = 8;
+static constexpr idx_t CHUNK_LOOKUP_ENTRY_SIZE = 12;
+static constexpr idx_t FANOUT_SIZE = 256 * 4;
+static constexpr idx_t COMMIT_DATA_SIZE = GIT_OID_RAWSZ + 16;
+static constexpr uint32_t PARENT_NONE = 0x70000000;
+static constexpr uint32_t PARENT_EXTRA_EDGES = 0x80000000;
+static constexpr uint32_t PARENT_LAST_EDGE = 0x80000000;
+
+static uint32_t ReadBE32(const uint8_t *p) {
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static uint64_t ReadBE64(const uint8_t *p) {
+	return (uint64_t(ReadBE32(p)) << 32) | ReadBE32(p + 4);
+}
+
+static bool ReadGraphFile(const string &path, string &out) {
+	FILE *f = fopen(path.c_str(), "rb");
+	if (!f) {
+		return false;
+	}
+	out.clear();
+	char buffer[256 * 1024];
+	size_t n;
+	while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+		out.append(buffer, n);
+	}
+	bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
+
+bool GitCommitGraphFile::LoadLayer(const string &path, Layer &layer) {
+	if (!ReadGraphFile(path, layer.data) || layer.data.size() < GRAPH_HEADER_SIZE) {
+		return false;
+	}
+	auto bytes = reinterpret_cast<const uint8_t *>(layer.data.data());
+	idx_t size = layer.data.size();
+	// Version 1, SHA-1 object ids.
+	if (ReadBE32(bytes) != GRAPH_SIGNATURE || bytes[4] != 1 || bytes[5] != 1) {
+		return false;
+	}
+	idx_t num_chunks = bytes[6];
+	if (GRAPH_HEADER_SIZE + (num_chunks + 1) * CHUNK_LOOKUP_ENTRY_SIZE > size) {
+		return false;
+	}
+
+	idx_t oids_size = 0, commit_data_size = 0, edges_size = 0;
+	for (idx_t i = 0; i < num_chunks; i++) {
+		const uint8_t *entry = bytes + GRAPH_HEADER_SIZE + i * CHUNK_LOOKUP_ENTRY_SIZE;
+		uint32_t id = ReadBE32(entry);
+		uint64_t offset = ReadBE64(entry + 4);
+		uint64_t next_offset = ReadBE64(entry + CHUNK_LOOKUP_ENTRY_SIZE + 4);
+		if (offset > next_offset || next_offset > size) {
+			return false;
+		}
+		idx_t chunk_size = next_offset - offset;
+		switch (id) {
+		case CHUNK_OID_FANOUT:
+			if (chunk_size != FANOUT_SIZE) {
+				return false;
+			}
+			layer.fanout = bytes + offset;
+			break;
+		case CHUNK_OID_LOOKUP:
+			layer.oids = bytes + offset;
+			oids_size = chunk_size;
+			break;
+		case CHUNK_COMMIT_DATA:
+			layer.commit_data = bytes + offset;
+			commit_data_size = chunk_size;
+			break;
+		case CHUNK_EXTRA_EDGES:
+			layer.edges = bytes + offset;
+			edges_size = chunk_size;
+			break;
+		default:
+			break; // generation data, bloom filters, base graphs: not needed
+		}
+	}
+	if (!layer.fanout || !layer.oids || !layer.commit_data) {
+		return false;
+	}
+	layer.count = ReadBE32(layer.fanout + FANOUT_SIZE - 4);
+	layer.edge_count = edges_size / 4;
+	return oids_size == layer.count * GIT_OID_RAWSZ && commit_data_size == layer.count * COMMIT_DATA_SIZE;
+}
+
+unique_ptr<GitCommitGraphFile> GitCommitGraphFile::Open(const string &objects_dir) {
+	auto graph = make_uniq<GitCommitGraphFile>();
+
+	vector<string> paths;
+	string chain;
+	string chain_dir = objects_dir + "info/commit-graphs/";
+	if (ReadGraphFile(chain_dir + "commit-graph-chain", chain)) {
+		for (auto &line : StringUtil::Split(chain, '\n')) {
+			StringUtil::Trim(line);
+			if (!line.empty()) {
+				paths.push_back(chain_dir + "graph-" + line + ".graph");
+			}
+		}
+	} else {
+		paths.push_back(objects_dir + "info/commit-graph");
+	}
+
+	for (auto &path : paths) {
+		auto layer = make_uniq<Layer>();
+		if (!LoadLayer(path, *layer)) {
+			return nullptr;
+		}
+		layer->base = graph->total_count;
+		graph->total_count += layer->count;
+		graph->layers.push_back(std::move(layer));
+	}
+	if (graph->layers.empty()) {
+		return nullptr;
+	}
+	return graph;
+}
+
+const GitCommitGraphFile::Layer &GitCommitGraphFile::LayerOf(idx_t pos, idx_t &local) const {
+	for (idx_t i = layers.size(); i > 0; i--) {
+		auto &layer = *layers[i - 1];
+		if (pos >= layer.base) {
+			local = pos - layer.base;
+			return layer;
+		}
+	}
+	local = pos;
+	return *layers[0];
+}
+
+bool GitCommitGraphFile::Find(const git_oid &oid, idx_t &pos) const {
+	uint8_t first = oid.id[0];
+	for (auto &layer_ptr : layers) {
+		auto &layer = *layer_ptr;
+		idx_t lo = first == 0 ? 0 : ReadBE32(layer.fanout + (first - 1) * 4);
+		idx_t hi = ReadBE32(layer.fanout + first * 4);
+		while (lo < hi) {
+			idx_t mid = lo + (hi - lo) / 2;
+			int cmp = memcmp(layer.oids + mid * GIT_OID_RAWSZ, oid.id, GIT_OID_RAWSZ);
+			if (cmp == 0) {
+				pos = layer.base + mid;
+				return true;
+			}
+			if (cmp < 0) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+	}
+	return false;
+}
+
+void GitCommitGraphFile::CommitId(idx_t pos, git_oid &out) const {
+	idx_t local;
+	auto &layer = LayerOf(pos, local);
+	git_oid_fromraw(&out, layer.oids + local * GIT_OID_RAWSZ);
+}
+
+void GitCommitGraphFile::TreeId(idx_t pos, git_oid &out) const {
+	idx_t local;
+	auto &layer = LayerOf(pos, local);
+	git_oid_fromraw(&out, layer.commit_data + local * COMMIT_DATA_SIZE);
+}
+
+uint32_t GitCommitGraphFile::Generation(idx_t pos) const {
+	idx_t local;
+	auto &layer = LayerOf(pos, local);
+	return ReadBE32(layer.commit_data + local * COMMIT_DATA_SIZE + GIT_OID_RAWSZ + 8) >> 2;
+}
+
+int64_t GitCommitGraphFile::CommitTime(idx_t pos) const {
+	idx_t local;
+	auto &layer = LayerOf(pos, local);
+	const uint8_t *data = layer.commit_data + local * COMMIT_DATA_SIZE + GIT_OID_RAWSZ + 8;
+	return static_cast<int64_t>((uint64_t(ReadBE32(data) & 0x3) << 32) | ReadBE32(data + 4));
+}
+
+bool GitCommitGraphFile::Parents(idx_t pos, vector<idx_t> &parents) const {
+	idx_t local;
+	auto &layer = LayerOf(pos, local);
+	const uint8_t *data = layer.commit_data + local * COMMIT_DATA_SIZE + GIT_OID_RAWSZ;
+	uint32_t parent1 = ReadBE32(data);
+	uint32_t parent2 = ReadBE32(data + 4);
+	if (parent1 == PARENT_NONE) {
+		return true;
+	}
+	if (parent1 >= total_count) {
+		return false;
+	}
+	parents.push_back(parent1);
+	if (parent2 == PARENT_NONE) {
+		return true;
+	}
+	if (!(parent2 & PARENT_EXTRA_EDGES)) {
+		if (parent2 >= total_count) {
+			return false;
+		}
+		parents.push_back(parent2);
+		return true;
+	}
+	// Octopus merge: parents 2..n are listed in the EDGE chunk, last one flagged.
+	for (idx_t edge = parent2 & ~PARENT_EXTRA_EDGES; edge < layer.edge_count; edge++) {
+		uint32_t value = ReadBE32(layer.edges + edge * 4);
+		uint32_t parent = value & ~PARENT_LAST_EDGE;
+		if (parent >= total_count) {
+			return false;
+		}
+		parents.push_back(parent);
+		if (value & PARENT_LAST_EDGE) {
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace duckdb
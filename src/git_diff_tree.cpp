@@ -4,12 +4,18 @@
 #include "git_path.hpp"
 #include "git_context_manager.hpp"
 #include "git_utils.hpp"
+#include "git_repo_pool.hpp"
+#include "git_result_cache.hpp"
+#include "text_utils.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/common/exception.hpp"
 
 #include <git2.h>
+#include <atomic>
+#include <unordered_map>
 
 namespace duckdb {
 
@@ -17,12 +23,46 @@ namespace duckdb {
 // GitDiffTreeRow
 //===--------------------------------------------------------------------===//
 
+// Output shape selected by the `patch` named parameter.
+enum class GitDiffPatchMode : uint8_t {
+	NONE,  // one row per file, no line counts (default)
+	STAT,  // one row per file with insertions/deletions/is_binary
+	HUNKS, // one row per hunk (files without hunks keep a single row)
+};
+
+struct GitDiffTreeHunk {
+	int64_t old_start = 0;
+	int64_t old_lines = 0;
+	int64_t new_start = 0;
+	int64_t new_lines = 0;
+	string header;
+	int64_t insertions = 0;
+	int64_t deletions = 0;
+};
+
 struct GitDiffTreeRow {
 	string repo_path;
 	string file_path;
 	string file_ext;
 	string status;   // "added", "deleted", "modified", "renamed", "copied", "typechange"
 	string old_path; // rename/copy source (empty otherwise)
+
+	// Delta sides, copied out of the git_diff so patches can be built on
+	// worker threads without sharing the diff object.
+	git_oid old_id {};
+	git_oid new_id {};
+	uint16_t old_mode = 0;
+	uint16_t new_mode = 0;
+	bool new_valid_id = false;
+
+	// Patch output (STAT/HUNKS modes). has_patch is false when no patch could
+	// be produced (submodules, unreadable workdir files); the stats are NULL then.
+	bool has_patch = false;
+	bool is_binary = false;
+	int64_t insertions = 0;
+	int64_t deletions = 0;
+	vector<GitDiffTreeHunk> hunks;
+	bool has_hunk = false; // HUNKS mode: row carries hunks[0]
 };
 
 //===--------------------------------------------------------------------===//
@@ -35,8 +75,11 @@ struct GitDiffTreeFunctionData : public TableFunctionData {
 	string ref2; // When non-empty, diff ref..ref2 (commit-to-commit mode)
 	string path_filter;
 	bool include_untracked;
+	GitDiffPatchMode patch_mode = GitDiffPatchMode::NONE;
+	GitDiffRenameOptions renames;
 	vector<GitDiffTreeRow> rows;
 	bool is_lateral;
+	vector<LogicalType> return_types; // Output columns, part of result cache keys
 
 	GitDiffTreeFunctionData(const string &repo_path, const string &ref, const string &ref2, const string &path_filter,
 	                        bool include_untracked, bool is_lateral = false)
@@ -119,17 +162,24 @@ static void ResolveRefToTree(git_repository *repo, const string &ref, git_object
 	}
 }
 
-static void CollectDiffDeltas(git_diff *diff, const string &repo_path, vector<GitDiffTreeRow> &rows) {
-	// Enable rename/copy detection
-	git_diff_find_options find_opts = GIT_DIFF_FIND_OPTIONS_INIT;
-	find_opts.flags = GIT_DIFF_FIND_RENAMES | GIT_DIFF_FIND_COPIES;
-	git_diff_find_similar(diff, &find_opts);
+static void CollectDiffDeltas(git_repository *repo, git_diff *diff, const string &repo_path,
+                              const GitDiffRenameOptions &renames, vector<GitDiffTreeRow> &rows) {
+	auto exact_renames = DetectRenames(repo, diff, renames, "git_diff_tree");
+	size_t num_deltas = git_diff_num_deltas(diff);
+	// Exact renames: the deletion each added delta absorbs, and its content id
+	vector<idx_t> rename_source(num_deltas, DConstants::INVALID_INDEX);
+	vector<bool> absorbed(num_deltas, false);
+	vector<git_oid> rename_ids(num_deltas);
+	for (auto &rename : exact_renames) {
+		rename_source[rename.added] = rename.deleted;
+		absorbed[rename.deleted] = true;
+		git_oid_cpy(&rename_ids[rename.added], &rename.id);
+	}
 
 	// Iterate diff deltas
-	size_t num_deltas = git_diff_num_deltas(diff);
 	for (size_t i = 0; i < num_deltas; i++) {
 		const git_diff_delta *delta = git_diff_get_delta(diff, i);
-		if (!delta) {
+		if (!delta || absorbed[i]) {
 			continue;
 		}
 
@@ -156,12 +206,245 @@ static void CollectDiffDeltas(git_diff *diff, const string &repo_path, vector<Gi
 			row.old_path = delta->old_file.path;
 		}
 
+		git_oid_cpy(&row.old_id, &delta->old_file.id);
+		git_oid_cpy(&row.new_id, &delta->new_file.id);
+		row.old_mode = delta->old_file.mode;
+		row.new_mode = delta->new_file.mode;
+		row.new_valid_id = (delta->new_file.flags & GIT_DIFF_FLAG_VALID_ID) != 0;
+
+		if (rename_source[i] != DConstants::INVALID_INDEX) {
+			const git_diff_delta *source = git_diff_get_delta(diff, rename_source[i]);
+			row.status = "renamed";
+			row.old_path = source->old_file.path ? source->old_file.path : "";
+			git_oid_cpy(&row.old_id, &source->old_file.id);
+			row.old_mode = source->old_file.mode;
+			git_oid_cpy(&row.new_id, &rename_ids[i]);
+			row.new_valid_id = true;
+		}
+
 		rows.push_back(std::move(row));
 	}
 }
 
-static void CollectDiffRows(git_repository *repo, const string &repo_path, const string &ref, const string &ref2,
-                            const string &path_filter, bool include_untracked, vector<GitDiffTreeRow> &rows) {
+//===--------------------------------------------------------------------===//
+// Patch generation (patch := true | 'stat' | 'hunks')
+//===--------------------------------------------------------------------===//
+
+static GitDiffPatchMode ParsePatchMode(const Value &value, const char *func_name) {
+	if (value.IsNull()) {
+		return GitDiffPatchMode::NONE;
+	}
+	if (value.type().id() == LogicalTypeId::BOOLEAN) {
+		return value.GetValue<bool>() ? GitDiffPatchMode::STAT : GitDiffPatchMode::NONE;
+	}
+	auto mode = StringUtil::Lower(value.ToString());
+	if (mode == "stat" || mode == "true") {
+		return GitDiffPatchMode::STAT;
+	}
+	if (mode == "hunks") {
+		return GitDiffPatchMode::HUNKS;
+	}
+	if (mode == "none" || mode == "false") {
+		return GitDiffPatchMode::NONE;
+	}
+	throw BinderException("%s: patch must be true, false, 'stat' or 'hunks' (got '%s')", func_name, value.ToString());
+}
+
+static bool IsBlobMode(uint16_t mode) {
+	return mode == 0 || mode == GIT_FILEMODE_BLOB || mode == GIT_FILEMODE_BLOB_EXECUTABLE || mode == GIT_FILEMODE_LINK;
+}
+
+// Reads a worktree file the way libgit2's workdir diff sees it: through the
+// clean filters (CRLF conversion, ident, filter drivers) for `rel_path`.
+static bool ReadWorkdirFile(git_repository *repo, const string &rel_path, string &out) {
+	git_filter_list *filters = nullptr;
+	if (git_filter_list_load(&filters, repo, nullptr, rel_path.c_str(), GIT_FILTER_TO_ODB, GIT_FILTER_DEFAULT) != 0) {
+		return false;
+	}
+	git_buf buffer = {nullptr, 0, 0};
+	// A null filter list passes the file through unchanged.
+	int error = git_filter_list_apply_to_file(&buffer, filters, repo, rel_path.c_str());
+	git_filter_list_free(filters);
+	if (error == 0) {
+		out.assign(buffer.ptr ? buffer.ptr : "", buffer.size);
+	}
+	git_buf_dispose(&buffer);
+	return error == 0;
+}
+
+static string FormatHunkHeader(const git_diff_hunk *hunk) {
+	size_t len = hunk->header_len;
+	while (len > 0 && (hunk->header[len - 1] == '\n' || hunk->header[len - 1] == '\r')) {
+		len--;
+	}
+	if (IsValidUTF8(hunk->header, len)) {
+		return string(hunk->header, len);
+	}
+	// Function context in a non-UTF-8 file: keep only the range part.
+	return StringUtil::Format("@@ -%d,%d +%d,%d @@", hunk->old_start, hunk->old_lines, hunk->new_start,
+	                          hunk->new_lines);
+}
+
+// Builds the patch for one delta from its blob ids. Old sides always come from
+// the object database; in workdir mode the new side is read from disk unless
+// its id is already known (index stat match) and present in the odb. Failures
+// leave has_patch false so the row reports NULL stats instead of aborting.
+static void ComputeRowPatch(git_repository *repo, bool new_side_is_workdir, GitDiffPatchMode mode,
+                            GitDiffTreeRow &row) {
+	if (!IsBlobMode(row.old_mode) || !IsBlobMode(row.new_mode)) {
+		return;
+	}
+
+	git_diff_options opts = GIT_DIFF_OPTIONS_INIT;
+	// Line counts do not depend on context; only hunk rows need git's default.
+	opts.context_lines = mode == GitDiffPatchMode::HUNKS ? 3 : 0;
+
+	git_blob *old_blob = nullptr;
+	git_blob *new_blob = nullptr;
+	if (row.old_mode != 0 && !git_oid_is_zero(&row.old_id)) {
+		if (git_blob_lookup(&old_blob, repo, &row.old_id) != 0) {
+			return;
+		}
+	}
+	auto old_guard = MakeGitBlob(old_blob);
+
+	string new_buffer;
+	bool use_buffer = false;
+	if (row.new_mode != 0) {
+		bool have_new_blob = false;
+		if ((!new_side_is_workdir || row.new_valid_id) && !git_oid_is_zero(&row.new_id)) {
+			have_new_blob = git_blob_lookup(&new_blob, repo, &row.new_id) == 0;
+		}
+		if (!have_new_blob) {
+			if (!new_side_is_workdir || !git_repository_workdir(repo) || row.new_mode == GIT_FILEMODE_LINK ||
+			    !ReadWorkdirFile(repo, row.file_path, new_buffer)) {
+				return;
+			}
+			use_buffer = true;
+		}
+	}
+	auto new_guard = MakeGitBlob(new_blob);
+
+	const char *old_as_path = row.old_path.empty() ? row.file_path.c_str() : row.old_path.c_str();
+	git_patch *patch = nullptr;
+	int error;
+	if (use_buffer) {
+		error = git_patch_from_blob_and_buffer(&patch, old_blob, old_as_path, new_buffer.data(), new_buffer.size(),
+		                                       row.file_path.c_str(), &opts);
+	} else {
+		error = git_patch_from_blobs(&patch, old_blob, old_as_path, new_blob, row.file_path.c_str(), &opts);
+	}
+	if (error != 0 || !patch) {
+		return;
+	}
+
+	const git_diff_delta *delta = git_patch_get_delta(patch);
+	row.is_binary = delta && (delta->flags & GIT_DIFF_FLAG_BINARY) != 0;
+
+	size_t context = 0, additions = 0, deletions = 0;
+	git_patch_line_stats(&context, &additions, &deletions, patch);
+	row.insertions = static_cast<int64_t>(additions);
+	row.deletions = static_cast<int64_t>(deletions);
+
+	if (mode == GitDiffPatchMode::HUNKS) {
+		size_t num_hunks = git_patch_num_hunks(patch);
+		row.hunks.reserve(num_hunks);
+		for (size_t h = 0; h < num_hunks; h++) {
+			const git_diff_hunk *hunk = nullptr;
+			size_t lines_in_hunk = 0;
+			if (git_patch_get_hunk(&hunk, &lines_in_hunk, patch, h) != 0) {
+				continue;
+			}
+			GitDiffTreeHunk out;
+			out.old_start = hunk->old_start;
+			out.old_lines = hunk->old_lines;
+			out.new_start = hunk->new_start;
+			out.new_lines = hunk->new_lines;
+			out.header = FormatHunkHeader(hunk);
+			for (size_t l = 0; l < lines_in_hunk; l++) {
+				const git_diff_line *line = nullptr;
+				if (git_patch_get_line_in_hunk(&line, patch, h, l) != 0) {
+					continue;
+				}
+				if (line->origin == GIT_DIFF_LINE_ADDITION) {
+					out.insertions++;
+				} else if (line->origin == GIT_DIFF_LINE_DELETION) {
+					out.deletions++;
+				}
+			}
+			row.hunks.push_back(std::move(out));
+		}
+	}
+
+	git_patch_free(patch);
+	row.has_patch = true;
+}
+
+// Computes patches for every row. Deltas are independent, so they are handed
+// out to DuckDB's scheduler threads through a shared counter; each worker uses
+// its thread's pooled repository handle since libgit2 objects are not shared
+// across threads.
+static void ComputeDiffPatches(ClientContext &context, git_repository *repo, const string &repo_path,
+                               bool new_side_is_workdir, GitDiffPatchMode mode, vector<GitDiffTreeRow> &rows) {
+	idx_t num_workers = MinValue<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads(), rows.size());
+	if (num_workers <= 1) {
+		for (auto &row : rows) {
+			ComputeRowPatch(repo, new_side_is_workdir, mode, row);
+		}
+		return;
+	}
+
+	std::atomic<idx_t> next_row(0);
+	RunParallelWorkers(context, num_workers, [&](idx_t worker) {
+		git_repository *worker_repo = GitRepoPool::GetRepository(repo_path);
+		if (!worker_repo) {
+			const git_error *e = git_error_last();
+			throw IOException("git_diff_tree: failed to open repository '%s': %s", repo_path,
+			                  e ? e->message : "unknown error");
+		}
+		while (true) {
+			idx_t i = next_row.fetch_add(1);
+			if (i >= rows.size()) {
+				break;
+			}
+			ComputeRowPatch(worker_repo, new_side_is_workdir, mode, rows[i]);
+		}
+	});
+}
+
+// HUNKS mode: replace each file row by one row per hunk. Files without hunks
+// (binary, pure renames, mode changes) keep a single row with NULL hunk columns.
+static void ExpandHunkRows(vector<GitDiffTreeRow> &rows) {
+	vector<GitDiffTreeRow> expanded;
+	expanded.reserve(rows.size());
+	for (auto &row : rows) {
+		if (row.hunks.empty()) {
+			expanded.push_back(std::move(row));
+			continue;
+		}
+		for (auto &hunk : row.hunks) {
+			GitDiffTreeRow hunk_row;
+			hunk_row.repo_path = row.repo_path;
+			hunk_row.file_path = row.file_path;
+			hunk_row.file_ext = row.file_ext;
+			hunk_row.status = row.status;
+			hunk_row.old_path = row.old_path;
+			hunk_row.has_patch = true;
+			hunk_row.is_binary = row.is_binary;
+			hunk_row.insertions = hunk.insertions;
+			hunk_row.deletions = hunk.deletions;
+			hunk_row.has_hunk = true;
+			hunk_row.hunks.push_back(std::move(hunk));
+			expanded.push_back(std::move(hunk_row));
+		}
+	}
+	rows = std::move(expanded);
+}
+
+static void CollectDiffRows(ClientContext &context, git_repository *repo, const string &repo_path, const string &ref,
+                            const string &ref2, const string &path_filter, bool include_untracked,
+                            const GitDiffRenameOptions &renames, GitDiffPatchMode patch_mode,
+                            vector<GitDiffTreeRow> &rows) {
 	git_object *obj = nullptr;
 	git_commit *commit = nullptr;
 	git_tree *tree = nullptr;
@@ -217,19 +500,35 @@ static void CollectDiffRows(git_repository *repo, const string &repo_path, const
 		throw IOException("git_diff_tree: failed to compute diff: %s", e ? e->message : "unknown error");
 	}
 
-	CollectDiffDeltas(diff, repo_path, rows);
+	try {
+		CollectDiffDeltas(repo, diff, repo_path, renames, rows);
+	} catch (...) {
+		git_diff_free(diff);
+		git_tree_free(tree);
+		git_commit_free(commit);
+		git_object_free(obj);
+		throw;
+	}
 
 	git_diff_free(diff);
 	git_tree_free(tree);
 	git_commit_free(commit);
 	git_object_free(obj);
+
+	if (patch_mode != GitDiffPatchMode::NONE) {
+		ComputeDiffPatches(context, repo, repo_path, /*new_side_is_workdir=*/ref2.empty(), patch_mode, rows);
+		if (patch_mode == GitDiffPatchMode::HUNKS) {
+			ExpandHunkRows(rows);
+		}
+	}
 }
 
 //===--------------------------------------------------------------------===//
 // Schema
 //===--------------------------------------------------------------------===//
 
-static void DefineGitDiffTreeSchema(vector<LogicalType> &return_types, vector<string> &names) {
+static void DefineGitDiffTreeSchema(vector<LogicalType> &return_types, vector<string> &names,
+                                    GitDiffPatchMode patch_mode = GitDiffPatchMode::NONE) {
 	return_types = {
 	    LogicalType::VARCHAR, // repo_path
 	    LogicalType::VARCHAR, // file_path
@@ -238,23 +537,20 @@ static void DefineGitDiffTreeSchema(vector<LogicalType> &return_types, vector<st
 	    LogicalType::VARCHAR  // old_path
 	};
 	names = {"repo_path", "file_path", "file_ext", "status", "old_path"};
-}
-
-static vector<LogicalType> GetGitDiffTreeSchema() {
-	vector<LogicalType> return_types;
-	vector<string> names;
-	DefineGitDiffTreeSchema(return_types, names);
-	return return_types;
-}
 
-static vector<string> GetGitDiffTreeColumnNames() {
-	vector<LogicalType> return_types;
-	vector<string> names;
-	DefineGitDiffTreeSchema(return_types, names);
-	return names;
+	if (patch_mode == GitDiffPatchMode::HUNKS) {
+		return_types.insert(return_types.end(), {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+		                                         LogicalType::BIGINT, LogicalType::VARCHAR});
+		names.insert(names.end(), {"old_start", "old_lines", "new_start", "new_lines", "hunk_header"});
+	}
+	if (patch_mode != GitDiffPatchMode::NONE) {
+		return_types.insert(return_types.end(), {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BOOLEAN});
+		names.insert(names.end(), {"insertions", "deletions", "is_binary"});
+	}
 }
 
-static void OutputGitDiffTreeRow(DataChunk &output, const GitDiffTreeRow &row, idx_t row_idx) {
+static void OutputGitDiffTreeRow(DataChunk &output, const GitDiffTreeRow &row, idx_t row_idx,
+                                 GitDiffPatchMode patch_mode) {
 	output.SetValue(0, row_idx, Value(row.repo_path));
 	output.SetValue(1, row_idx, Value(row.file_path));
 	output.SetValue(2, row_idx, Value(row.file_ext));
@@ -264,6 +560,33 @@ static void OutputGitDiffTreeRow(DataChunk &output, const GitDiffTreeRow &row, i
 	} else {
 		output.SetValue(4, row_idx, Value());
 	}
+
+	idx_t col = 5;
+	if (patch_mode == GitDiffPatchMode::HUNKS) {
+		if (row.has_hunk) {
+			const auto &hunk = row.hunks[0];
+			output.SetValue(col++, row_idx, Value::BIGINT(hunk.old_start));
+			output.SetValue(col++, row_idx, Value::BIGINT(hunk.old_lines));
+			output.SetValue(col++, row_idx, Value::BIGINT(hunk.new_start));
+			output.SetValue(col++, row_idx, Value::BIGINT(hunk.new_lines));
+			output.SetValue(col++, row_idx, Value(hunk.header));
+		} else {
+			for (idx_t i = 0; i < 5; i++) {
+				output.SetValue(col++, row_idx, Value());
+			}
+		}
+	}
+	if (patch_mode != GitDiffPatchMode::NONE) {
+		if (row.has_patch) {
+			output.SetValue(col++, row_idx, Value::BIGINT(row.insertions));
+			output.SetValue(col++, row_idx, Value::BIGINT(row.deletions));
+			output.SetValue(col++, row_idx, Value::BOOLEAN(row.is_binary));
+		} else {
+			output.SetValue(col++, row_idx, Value());
+			output.SetValue(col++, row_idx, Value());
+			output.SetValue(col++, row_idx, Value());
+		}
+	}
 }
 
 //===--------------------------------------------------------------------===//
@@ -272,9 +595,6 @@ static void OutputGitDiffTreeRow(DataChunk &output, const GitDiffTreeRow &row, i
 
 static unique_ptr<FunctionData> GitDiffTreeBind(ClientContext &context, TableFunctionBindInput &input,
                                                 vector<LogicalType> &return_types, vector<string> &names) {
-	return_types = GetGitDiffTreeSchema();
-	names = GetGitDiffTreeColumnNames();
-
 	string repo_path = ".";
 	string ref = "HEAD";
 	string ref2;
@@ -310,24 +630,64 @@ static unique_ptr<FunctionData> GitDiffTreeBind(ClientContext &context, TableFun
 	}
 
 	// Parse named parameters
+	GitDiffPatchMode patch_mode = GitDiffPatchMode::NONE;
+	GitDiffRenameOptions renames;
 	for (const auto &kv : input.named_parameters) {
 		if (kv.first == "path") {
 			path_filter = kv.second.GetValue<string>();
 		} else if (kv.first == "untracked") {
 			include_untracked = kv.second.GetValue<bool>();
+		} else if (kv.first == "patch") {
+			patch_mode = ParsePatchMode(kv.second, "git_diff_tree");
+		} else {
+			ApplyRenameParam(kv.first, kv.second, renames, "git_diff_tree");
 		}
 	}
+	DefineGitDiffTreeSchema(return_types, names, patch_mode);
 
-	return make_uniq<GitDiffTreeFunctionData>(repo_path, ref, ref2, path_filter, include_untracked);
+	auto bind_data = make_uniq<GitDiffTreeFunctionData>(repo_path, ref, ref2, path_filter, include_untracked);
+	bind_data->patch_mode = patch_mode;
+	bind_data->renames = renames;
+	bind_data->return_types = return_types;
+	return std::move(bind_data);
 }
 
 //===--------------------------------------------------------------------===//
 // Init Global
 //===--------------------------------------------------------------------===//
 
+struct GitDiffTreeGlobalState : public GlobalTableFunctionState {
+	GitResultCacheScan result_cache; // commit-to-commit diffs only
+};
+
+// Looks a commit-to-commit diff up in the result cache; true on a hit. Diffs
+// against the working directory are never cached.
+static bool BeginCachedDiffTree(ClientContext &context, git_repository *repo,
+                                const GitDiffTreeFunctionData &bind_data, GitDiffTreeGlobalState &state) {
+	auto cache = GitResultCache::Get(context);
+	git_oid old_id;
+	git_oid new_id;
+	if (!cache || bind_data.ref2.empty() || !ResolveCommitId(repo, bind_data.ref, old_id) ||
+	    !ResolveCommitId(repo, bind_data.ref2, new_id)) {
+		return false;
+	}
+	char old_hex[GIT_OID_HEXSZ + 1];
+	char new_hex[GIT_OID_HEXSZ + 1];
+	git_oid_tostr(old_hex, sizeof(old_hex), &old_id);
+	git_oid_tostr(new_hex, sizeof(new_hex), &new_id);
+	auto &renames = bind_data.renames;
+	auto key = GitResultCacheKey(
+	    "git_diff_tree", bind_data.return_types,
+	    {bind_data.repo_path, old_hex, new_hex, bind_data.path_filter, to_string(static_cast<int>(bind_data.patch_mode)),
+	     to_string(static_cast<int>(renames.mode)), to_string(renames.rename_limit),
+	     to_string(renames.similarity_threshold)});
+	return state.result_cache.Begin(cache, std::move(key), bind_data.return_types);
+}
+
 static unique_ptr<GlobalTableFunctionState> GitDiffTreeInitGlobal(ClientContext &context,
                                                                   TableFunctionInitInput &input) {
 	auto &bind_data = const_cast<GitDiffTreeFunctionData &>(input.bind_data->Cast<GitDiffTreeFunctionData>());
+	auto state = make_uniq<GitDiffTreeGlobalState>();
 
 	if (!bind_data.is_lateral) {
 		git_repository *repo = nullptr;
@@ -339,8 +699,10 @@ static unique_ptr<GlobalTableFunctionState> GitDiffTreeInitGlobal(ClientContext
 		}
 
 		try {
-			CollectDiffRows(repo, bind_data.repo_path, bind_data.ref, bind_data.ref2, bind_data.path_filter,
-			                bind_data.include_untracked, bind_data.rows);
+			if (!BeginCachedDiffTree(context, repo, bind_data, *state)) {
+				CollectDiffRows(context, repo, bind_data.repo_path, bind_data.ref, bind_data.ref2, bind_data.path_filter,
+				                bind_data.include_untracked, bind_data.renames, bind_data.patch_mode, bind_data.rows);
+			}
 		} catch (...) {
 			git_repository_free(repo);
 			throw;
@@ -349,7 +711,7 @@ static unique_ptr<GlobalTableFunctionState> GitDiffTreeInitGlobal(ClientContext
 		git_repository_free(repo);
 	}
 
-	return make_uniq<GlobalTableFunctionState>();
+	return std::move(state);
 }
 
 //===--------------------------------------------------------------------===//
@@ -359,18 +721,24 @@ static unique_ptr<GlobalTableFunctionState> GitDiffTreeInitGlobal(ClientContext
 static void GitDiffTreeFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<GitDiffTreeFunctionData>();
 	auto &local_state = data_p.local_state->Cast<GitDiffTreeLocalState>();
+	auto &global_state = data_p.global_state->Cast<GitDiffTreeGlobalState>();
+	if (global_state.result_cache.IsHit()) {
+		global_state.result_cache.Replay(output);
+		return;
+	}
 
 	idx_t output_count = 0;
 	const idx_t max_output = STANDARD_VECTOR_SIZE;
 
 	while (local_state.current_index < bind_data.rows.size() && output_count < max_output) {
 		auto &row = bind_data.rows[local_state.current_index];
-		OutputGitDiffTreeRow(output, row, output_count);
+		OutputGitDiffTreeRow(output, row, output_count, bind_data.patch_mode);
 		local_state.current_index++;
 		output_count++;
 	}
 
 	output.SetCardinality(output_count);
+	global_state.result_cache.Record(output);
 }
 
 //===--------------------------------------------------------------------===//
@@ -388,9 +756,6 @@ GitDiffTreeLocalInit(ExecutionContext &context, TableFunctionInitInput &input, G
 
 static unique_ptr<FunctionData> GitDiffTreeEachBind(ClientContext &context, TableFunctionBindInput &input,
                                                     vector<LogicalType> &return_types, vector<string> &names) {
-	return_types = GetGitDiffTreeSchema();
-	names = GetGitDiffTreeColumnNames();
-
 	string ref = "HEAD";
 	string ref2;
 	string path_filter;
@@ -406,15 +771,25 @@ static unique_ptr<FunctionData> GitDiffTreeEachBind(ClientContext &context, Tabl
 		ref2 = input.inputs[2].GetValue<string>();
 	}
 
+	GitDiffPatchMode patch_mode = GitDiffPatchMode::NONE;
+	GitDiffRenameOptions renames;
 	for (const auto &kv : input.named_parameters) {
 		if (kv.first == "path") {
 			path_filter = kv.second.GetValue<string>();
 		} else if (kv.first == "untracked") {
 			include_untracked = kv.second.GetValue<bool>();
+		} else if (kv.first == "patch") {
+			patch_mode = ParsePatchMode(kv.second, "git_diff_tree_each");
+		} else {
+			ApplyRenameParam(kv.first, kv.second, renames, "git_diff_tree_each");
 		}
 	}
+	DefineGitDiffTreeSchema(return_types, names, patch_mode);
 
-	return make_uniq<GitDiffTreeFunctionData>(".", ref, ref2, path_filter, include_untracked, true);
+	auto bind_data = make_uniq<GitDiffTreeFunctionData>(".", ref, ref2, path_filter, include_untracked, true);
+	bind_data->patch_mode = patch_mode;
+	bind_data->renames = renames;
+	return std::move(bind_data);
 }
 
 static OperatorResultType GitDiffTreeEachFunction(ExecutionContext &context, TableFunctionInput &data_p,
@@ -465,8 +840,9 @@ static OperatorResultType GitDiffTreeEachFunction(ExecutionContext &context, Tab
 			}
 
 			try {
-				CollectDiffRows(repo, resolved_repo_path, bind_data.ref, bind_data.ref2, bind_data.path_filter,
-				                bind_data.include_untracked, state.current_rows);
+				CollectDiffRows(context.client, repo, resolved_repo_path, bind_data.ref, bind_data.ref2,
+				                bind_data.path_filter, bind_data.include_untracked, bind_data.renames,
+				                bind_data.patch_mode, state.current_rows);
 			} catch (...) {
 				git_repository_free(repo);
 				state.current_input_row++;
@@ -481,7 +857,8 @@ static OperatorResultType GitDiffTreeEachFunction(ExecutionContext &context, Tab
 		// Output rows
 		idx_t output_count = 0;
 		while (output_count < STANDARD_VECTOR_SIZE && state.current_output_row < state.current_rows.size()) {
-			OutputGitDiffTreeRow(output, state.current_rows[state.current_output_row], output_count);
+			OutputGitDiffTreeRow(output, state.current_rows[state.current_output_row], output_count,
+			                     bind_data.patch_mode);
 			output_count++;
 			state.current_output_row++;
 		}
@@ -511,6 +888,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_zero.init_local = GitDiffTreeLocalInit;
 	git_diff_tree_zero.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_zero.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_zero.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_zero.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_zero.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_zero.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_set.AddFunction(git_diff_tree_zero);
 
 	// Single parameter: git_diff_tree(repo_path)
@@ -519,6 +900,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_single.init_local = GitDiffTreeLocalInit;
 	git_diff_tree_single.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_single.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_single.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_single.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_single.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_single.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_set.AddFunction(git_diff_tree_single);
 
 	// Two parameters: git_diff_tree(repo_path, ref)
@@ -527,6 +912,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_two.init_local = GitDiffTreeLocalInit;
 	git_diff_tree_two.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_two.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_two.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_two.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_two.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_two.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_set.AddFunction(git_diff_tree_two);
 
 	// Three parameters: git_diff_tree(repo_path, from_ref, to_ref) — commit-to-commit diff
@@ -535,6 +924,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_three.init_local = GitDiffTreeLocalInit;
 	git_diff_tree_three.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_three.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_three.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_three.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_three.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_three.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_set.AddFunction(git_diff_tree_three);
 
 	loader.RegisterFunction(git_diff_tree_set);
@@ -547,6 +940,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_each_single.in_out_function = GitDiffTreeEachFunction;
 	git_diff_tree_each_single.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_each_single.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_each_single.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_each_single.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_each_single.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_each_single.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_each_set.AddFunction(git_diff_tree_each_single);
 
 	TableFunction git_diff_tree_each_two({LogicalType::VARCHAR, LogicalType::VARCHAR}, nullptr, GitDiffTreeEachBind,
@@ -554,6 +951,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_each_two.in_out_function = GitDiffTreeEachFunction;
 	git_diff_tree_each_two.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_each_two.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_each_two.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_each_two.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_each_two.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_each_two.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_each_set.AddFunction(git_diff_tree_each_two);
 
 	TableFunction git_diff_tree_each_three({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR}, nullptr,
@@ -561,6 +962,10 @@ void RegisterGitDiffTreeFunction(ExtensionLoader &loader) {
 	git_diff_tree_each_three.in_out_function = GitDiffTreeEachFunction;
 	git_diff_tree_each_three.named_parameters["path"] = LogicalType::VARCHAR;
 	git_diff_tree_each_three.named_parameters["untracked"] = LogicalType::BOOLEAN;
+	git_diff_tree_each_three.named_parameters["patch"] = LogicalType::ANY;
+	git_diff_tree_each_three.named_parameters["renames"] = LogicalType::VARCHAR;
+	git_diff_tree_each_three.named_parameters["rename_limit"] = LogicalType::BIGINT;
+	git_diff_tree_each_three.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
 	git_diff_tree_each_set.AddFunction(git_diff_tree_each_three);
 
 	loader.RegisterFunction(git_diff_tree_each_set);
@@ -30,6 +30,11 @@ void RegisterGitUriFunction(ExtensionLoader &loader);
 void RegisterGitStatusFunction(ExtensionLoader &loader);
 void RegisterGitDiffTreeFunction(ExtensionLoader &loader);
 void RegisterGitBlameFunction(ExtensionLoader &loader);
+void RegisterGitLogChangesFunction(ExtensionLoader &loader);
+void RegisterGitRefsFunction(ExtensionLoader &loader);
+void RegisterGitCommitGraphFunction(ExtensionLoader &loader);
+void RegisterGitReachabilityFunctions(ExtensionLoader &loader);
+void RegisterGitTableDiffFunction(ExtensionLoader &loader);
 
 void RegisterGitFunctions(ExtensionLoader &loader) {
 	RegisterGitLogFunction(loader);
@@ -42,6 +47,11 @@ void RegisterGitFunctions(ExtensionLoader &loader) {
 	RegisterGitStatusFunction(loader);
 	RegisterGitDiffTreeFunction(loader);
 	RegisterGitBlameFunction(loader);
+	RegisterGitLogChangesFunction(loader);
+	RegisterGitRefsFunction(loader);
+	RegisterGitCommitGraphFunction(loader);
+	RegisterGitReachabilityFunctions(loader);
+	RegisterGitTableDiffFunction(loader);
 }
 
 } // namespace duckdb
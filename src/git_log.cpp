@@ -1,4 +1,5 @@
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_utils.hpp"
 #include "git_context_manager.hpp"
@@ -49,6 +50,7 @@ unique_ptr<FunctionData> GitLogBind(ClientContext &context, TableFunctionBindInp
 		auto ctx = GitContextManager::Instance().ProcessGitUri(params.repo_path_or_uri, params.ref);
 		auto result = make_uniq<GitLogFunctionData>(params.repo_path_or_uri, ctx.repo_path);
 		result->file_path = ctx.file_path;
+		result->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
 		return std::move(result);
 	} catch (const std::exception &e) {
 		throw BinderException("git_log: %s", e.what());
@@ -116,9 +118,7 @@ void GitLogFunction(ClientContext &context, TableFunctionInput &data_p, DataChun
 		output.SetValue(0, count, Value(bind_data.repo_path));
 
 		// Get commit hash
-		char hash_str[GIT_OID_HEXSZ + 1];
-		git_oid_tostr(hash_str, sizeof(hash_str), &oid);
-		output.SetValue(1, count, Value(hash_str));
+		SetGitOid(output.data[1], count, &oid);
 
 		// Get author info
 		const git_signature *author = git_commit_author(commit);
@@ -145,10 +145,7 @@ void GitLogFunction(ClientContext &context, TableFunctionInput &data_p, DataChun
 		output.SetValue(9, count, Value::INTEGER(parent_count));
 
 		// Get tree hash
-		const git_oid *tree_oid = git_commit_tree_id(commit);
-		char tree_hash[GIT_OID_HEXSZ + 1];
-		git_oid_tostr(tree_hash, sizeof(tree_hash), tree_oid);
-		output.SetValue(10, count, Value(tree_hash));
+		SetGitOid(output.data[10], count, git_commit_tree_id(commit));
 
 		git_commit_free(commit);
 		count++;
@@ -206,9 +203,7 @@ static void ProcessLogCommitForInOut(git_repository *repo, const string &resolve
 		row.repo_path = resolved_repo_path;
 
 		// Get commit hash
-		char hash_str[GIT_OID_HEXSZ + 1];
-		git_oid_tostr(hash_str, sizeof(hash_str), &commit_oid);
-		row.commit_hash = hash_str;
+		git_oid_cpy(&row.commit_id, &commit_oid);
 
 		// Get author info
 		const git_signature *author = git_commit_author(commit);
@@ -232,10 +227,7 @@ static void ProcessLogCommitForInOut(git_repository *repo, const string &resolve
 		row.parent_count = git_commit_parentcount(commit);
 
 		// Get tree hash
-		const git_oid *tree_oid = git_commit_tree_id(commit);
-		char tree_hash[GIT_OID_HEXSZ + 1];
-		git_oid_tostr(tree_hash, sizeof(tree_hash), tree_oid);
-		row.tree_hash = tree_hash;
+		git_oid_cpy(&row.tree_id, git_commit_tree_id(commit));
 
 		// File path filtering: if a specific file is requested, only include commits that modified it
 		if (!file_path.empty()) {
@@ -354,7 +346,7 @@ static OperatorResultType GitLogEachFunction(ExecutionContext &context, TableFun
 
 			// Fill output row with git log data
 			output.SetValue(0, output_count, Value(resolved_repo_path));
-			output.SetValue(1, output_count, Value(row.commit_hash));
+			SetGitOid(output.data[1], output_count, &row.commit_id);
 			output.SetValue(2, output_count, Value(row.author_name));
 			output.SetValue(3, output_count, Value(row.author_email));
 			output.SetValue(4, output_count, Value(row.committer_name));
@@ -363,7 +355,7 @@ static OperatorResultType GitLogEachFunction(ExecutionContext &context, TableFun
 			output.SetValue(7, output_count, Value::TIMESTAMP(row.commit_date));
 			output.SetValue(8, output_count, Value(row.message));
 			output.SetValue(9, output_count, Value::INTEGER(row.parent_count));
-			output.SetValue(10, output_count, Value(row.tree_hash));
+			SetGitOid(output.data[10], output_count, &row.tree_id);
 
 			output_count++;
 			state.current_output_row++;
@@ -407,7 +399,9 @@ unique_ptr<FunctionData> GitLogEachBind(ClientContext &context, TableFunctionBin
 	         "author_date", "commit_date", "message",     "parent_count", "tree_hash"};
 
 	// For LATERAL functions, store the ref parameter (defaults to "HEAD" from ParseLateralGitParams)
-	return make_uniq<GitLogFunctionData>(params.ref);
+	auto result = make_uniq<GitLogFunctionData>(params.ref);
+	result->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(result);
 }
 
 void RegisterGitLogFunction(ExtensionLoader &loader) {
@@ -0,0 +1,669 @@
+#include "duckdb.hpp"
+#include "git_functions.hpp"
+#include "git_oid_type.hpp"
+#include "git_path.hpp"
+#include "git_utils.hpp"
+#include "git_commit_dag.hpp"
+#include "git_repo_pool.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/function/function_set.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <git2.h>
+#include <atomic>
+#include <queue>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// git_log_changes — one row per (commit, parent, changed file) over a range.
+//
+// History is walked lazily on the scanning thread (GitLogChangesWalk), so the
+// first rows come out without reading the whole history. Commits are diffed
+// in windows: each window of commit ids is split into contiguous batches that
+// DuckDB's scheduler threads diff against their parents (each with its own
+// pooled repository handle), and the window's rows are emitted in walk order
+// before the next window is started. Memory therefore stays bounded by one
+// window.
+//===--------------------------------------------------------------------===//
+
+// Commits per worker batch. Batches are contiguous in walk order, so on linear
+// history the parent of one commit is usually the next commit of the batch and
+// its tree is served from the batch's tree cache.
+static constexpr idx_t LOG_CHANGES_BATCH_SIZE = 64;
+
+enum class GitLogChangesParents : uint8_t {
+	FIRST, // diff against the first parent only (default)
+	ALL,   // one diff per parent; parent_index tells them apart
+};
+
+struct GitLogChangeRow {
+	git_oid commit_id;
+	git_oid parent_id;
+	bool has_parent = false; // false for root commits
+	int32_t parent_index = 0;
+	string file_path;
+	string file_ext;
+	string old_path; // rename/copy source (empty otherwise)
+	string status;
+	git_oid old_blob_id;
+	git_oid new_blob_id;
+	bool has_old_blob = false; // false when the file did not exist on the old side
+	bool has_new_blob = false; // false when the file does not exist on the new side
+	int64_t old_size = -1;
+	int64_t new_size = -1;
+};
+
+struct GitLogChangesFunctionData : public TableFunctionData {
+	string repo_path;
+	string range = "HEAD";
+	string path_filter;
+	GitLogChangesParents parents = GitLogChangesParents::FIRST;
+	GitDiffRenameOptions renames;
+	idx_t max_threads = 1;
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+};
+
+//===--------------------------------------------------------------------===//
+// Walk
+//===--------------------------------------------------------------------===//
+
+// Streaming history walk, newest first. Commits are popped by generation
+// number when the repository has a commit-graph file (a topological order:
+// a commit comes out after all of its children) and by committer time
+// otherwise, like `git log`. For "A..B" the commits reachable from A are
+// queued too, marked uninteresting; a commit's mark is final when it is
+// popped, and the walk ends as soon as only uninteresting commits are left.
+class GitLogChangesWalk {
+public:
+	explicit GitLogChangesWalk(git_repository *repo) : dag(repo) {
+	}
+
+	void Push(const git_oid &oid, bool uninteresting) {
+		Enqueue(dag.Node(oid), uninteresting);
+	}
+
+	bool Next(git_oid &out) {
+		while (!queue.empty() && interesting_queued > 0) {
+			idx_t node = queue.top().node;
+			queue.pop();
+			flags[node] &= ~QUEUED;
+			bool uninteresting = flags[node] & UNINTERESTING;
+			if (!uninteresting) {
+				interesting_queued--;
+			}
+			vector<idx_t> parents = dag.Parents(node);
+			for (auto parent : parents) {
+				Enqueue(parent, uninteresting);
+			}
+			if (!uninteresting) {
+				git_oid_cpy(&out, &dag.Id(node));
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	static constexpr uint8_t SEEN = 1;
+	static constexpr uint8_t QUEUED = 2;
+	static constexpr uint8_t UNINTERESTING = 4;
+
+	struct Entry {
+		uint32_t generation;
+		int64_t commit_time;
+		idx_t node;
+		bool operator<(const Entry &other) const {
+			if (generation != other.generation) {
+				return generation < other.generation;
+			}
+			if (commit_time != other.commit_time) {
+				return commit_time < other.commit_time;
+			}
+			return node > other.node; // ties: first seen first
+		}
+	};
+
+	void Enqueue(idx_t node, bool uninteresting) {
+		if (flags.size() < dag.Size()) {
+			flags.resize(dag.Size(), 0);
+		}
+		uint8_t &node_flags = flags[node];
+		if (node_flags & SEEN) {
+			if (uninteresting && !(node_flags & UNINTERESTING)) {
+				node_flags |= UNINTERESTING;
+				if (node_flags & QUEUED) {
+					interesting_queued--;
+				}
+			}
+			return;
+		}
+		node_flags = SEEN | QUEUED | (uninteresting ? UNINTERESTING : 0);
+		if (!uninteresting) {
+			interesting_queued++;
+		}
+		// Without a commit-graph a generation number would need every
+		// ancestor, so only the commit time is used then
+		uint32_t generation = dag.HasCommitGraph() ? dag.Generation(node) : 0;
+		queue.push(Entry {generation, dag.CommitTime(node), node});
+	}
+
+	GitCommitDag dag;
+	vector<uint8_t> flags; // by dag node
+	std::priority_queue<Entry> queue;
+	idx_t interesting_queued = 0;
+};
+
+struct GitLogChangesLocalState : public LocalTableFunctionState {
+	git_repository *repo = nullptr;
+	unique_ptr<GitLogChangesWalk> walk;
+	bool initialized = false;
+	bool walk_done = false;
+
+	// Rows of the current window, in walk order
+	vector<GitLogChangeRow> rows;
+	idx_t current_index = 0;
+
+	~GitLogChangesLocalState() override {
+		walk.reset();
+		if (repo) {
+			git_repository_free(repo);
+		}
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+
+static string ExtractFileExtension(const string &path) {
+	size_t dot_pos = path.find_last_of('.');
+	if (dot_pos == string::npos || dot_pos == path.length() - 1) {
+		return "";
+	}
+	return path.substr(dot_pos);
+}
+
+static string oid_to_hex(const git_oid *oid) {
+	char hex[GIT_OID_HEXSZ + 1];
+	git_oid_tostr(hex, sizeof(hex), oid);
+	return string(hex);
+}
+
+static string DeltaStatusToString(git_delta_t delta) {
+	switch (delta) {
+	case GIT_DELTA_ADDED:
+		return "added";
+	case GIT_DELTA_DELETED:
+		return "deleted";
+	case GIT_DELTA_MODIFIED:
+		return "modified";
+	case GIT_DELTA_RENAMED:
+		return "renamed";
+	case GIT_DELTA_COPIED:
+		return "copied";
+	case GIT_DELTA_TYPECHANGE:
+		return "typechange";
+	default:
+		return "unknown";
+	}
+}
+
+// Blob size from the object header only (no content inflation for loose
+// objects; packed objects resolve just the delta chain's header).
+static int64_t ReadBlobSize(git_odb *odb, const git_diff_file &file) {
+	if (!odb || git_oid_is_zero(&file.id) || file.mode == GIT_FILEMODE_COMMIT) {
+		return -1;
+	}
+	size_t size = 0;
+	git_object_t type;
+	if (git_odb_read_header(&size, &type, odb, &file.id) != 0) {
+		return -1;
+	}
+	return static_cast<int64_t>(size);
+}
+
+//===--------------------------------------------------------------------===//
+// Batch diffing
+//===--------------------------------------------------------------------===//
+
+// Per-batch tree cache keyed by commit id. Trees are loaded at most once per
+// batch even though each one is used both as a "new" and as a parent tree.
+class GitCommitTreeCache {
+public:
+	explicit GitCommitTreeCache(git_repository *repo) : repo(repo) {
+	}
+	~GitCommitTreeCache() {
+		for (auto &entry : trees) {
+			git_tree_free(entry.second);
+		}
+	}
+
+	// Tree of a commit that is not loaded yet
+	git_tree *Get(const git_oid *commit_id) {
+		auto entry = trees.find(Key(commit_id));
+		if (entry != trees.end()) {
+			return entry->second;
+		}
+		git_commit *commit = nullptr;
+		if (git_commit_lookup(&commit, repo, commit_id) != 0) {
+			return nullptr;
+		}
+		auto tree = Get(commit);
+		git_commit_free(commit);
+		return tree;
+	}
+
+	// Tree of a loaded commit
+	git_tree *Get(const git_commit *commit) {
+		auto key = Key(git_commit_id(commit));
+		auto entry = trees.find(key);
+		if (entry != trees.end()) {
+			return entry->second;
+		}
+		git_tree *tree = nullptr;
+		if (git_commit_tree(&tree, commit) != 0) {
+			return nullptr;
+		}
+		trees.emplace(std::move(key), tree);
+		return tree;
+	}
+
+private:
+	static string Key(const git_oid *commit_id) {
+		return string(reinterpret_cast<const char *>(commit_id->id), GIT_OID_RAWSZ);
+	}
+
+	git_repository *repo;
+	unordered_map<string, git_tree *> trees;
+};
+
+static void DiffCommitAgainstParent(git_repository *repo, git_odb *odb, const GitLogChangesFunctionData &bind_data,
+                                    const git_oid &commit_id, git_tree *tree, git_tree *parent_tree,
+                                    const git_oid *parent_id, int32_t parent_index, vector<GitLogChangeRow> &rows) {
+	git_diff_options diff_opts = GIT_DIFF_OPTIONS_INIT;
+	diff_opts.flags = GIT_DIFF_INCLUDE_TYPECHANGE;
+	char *pathspec_cstr = nullptr;
+	if (!bind_data.path_filter.empty()) {
+		pathspec_cstr = const_cast<char *>(bind_data.path_filter.c_str());
+		diff_opts.pathspec.count = 1;
+		diff_opts.pathspec.strings = &pathspec_cstr;
+	}
+
+	git_diff *diff = nullptr;
+	if (git_diff_tree_to_tree(&diff, repo, parent_tree, tree, &diff_opts) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_log_changes: failed to diff commit %s: %s", oid_to_hex(&commit_id),
+		                  e ? e->message : "unknown error");
+	}
+	vector<GitExactRename> exact_renames;
+	try {
+		exact_renames = DetectRenames(repo, diff, bind_data.renames, "git_log_changes");
+	} catch (...) {
+		git_diff_free(diff);
+		throw;
+	}
+
+	size_t num_deltas = git_diff_num_deltas(diff);
+	// Exact renames: the deletion each added delta absorbs
+	vector<const git_diff_delta *> rename_source(num_deltas, nullptr);
+	vector<bool> absorbed(num_deltas, false);
+	for (auto &rename : exact_renames) {
+		rename_source[rename.added] = git_diff_get_delta(diff, rename.deleted);
+		absorbed[rename.deleted] = true;
+	}
+
+	for (size_t i = 0; i < num_deltas; i++) {
+		const git_diff_delta *delta = git_diff_get_delta(diff, i);
+		if (!delta || absorbed[i]) {
+			continue;
+		}
+
+		GitLogChangeRow row;
+		git_oid_cpy(&row.commit_id, &commit_id);
+		if (parent_id) {
+			git_oid_cpy(&row.parent_id, parent_id);
+			row.has_parent = true;
+		}
+		row.parent_index = parent_index;
+		row.status = DeltaStatusToString(delta->status);
+		if (delta->status == GIT_DELTA_DELETED) {
+			row.file_path = delta->old_file.path ? delta->old_file.path : "";
+		} else {
+			row.file_path = delta->new_file.path ? delta->new_file.path : "";
+		}
+		row.file_ext = ExtractFileExtension(row.file_path);
+		if ((delta->status == GIT_DELTA_RENAMED || delta->status == GIT_DELTA_COPIED) && delta->old_file.path) {
+			row.old_path = delta->old_file.path;
+		}
+		if (delta->status != GIT_DELTA_ADDED) {
+			git_oid_cpy(&row.old_blob_id, &delta->old_file.id);
+			row.has_old_blob = true;
+			row.old_size = ReadBlobSize(odb, delta->old_file);
+		}
+		if (delta->status != GIT_DELTA_DELETED) {
+			git_oid_cpy(&row.new_blob_id, &delta->new_file.id);
+			row.has_new_blob = true;
+			row.new_size = ReadBlobSize(odb, delta->new_file);
+		}
+		if (rename_source[i]) {
+			auto &source = rename_source[i]->old_file;
+			row.status = "renamed";
+			row.old_path = source.path ? source.path : "";
+			git_oid_cpy(&row.old_blob_id, &source.id);
+			row.has_old_blob = true;
+			row.old_size = ReadBlobSize(odb, source);
+		}
+		rows.push_back(std::move(row));
+	}
+
+	git_diff_free(diff);
+}
+
+// Diffs commits[begin, end) against their parents into out[begin, end).
+// Commits that cannot be loaded produce no rows.
+static void DiffCommitBatch(git_repository *repo, const GitLogChangesFunctionData &bind_data,
+                            const vector<git_oid> &commits, idx_t begin, idx_t end,
+                            vector<vector<GitLogChangeRow>> &out) {
+	git_odb *odb = nullptr;
+	if (git_repository_odb(&odb, repo) != 0) {
+		odb = nullptr;
+	}
+	GitCommitTreeCache tree_cache(repo);
+
+	for (idx_t i = begin; i < end; i++) {
+		git_commit *commit = nullptr;
+		if (git_commit_lookup(&commit, repo, &commits[i]) != 0) {
+			continue;
+		}
+		auto commit_guard = MakeGitCommit(commit);
+		git_tree *tree = tree_cache.Get(commit);
+		if (!tree) {
+			continue;
+		}
+
+		unsigned parent_count = git_commit_parentcount(commit);
+		if (parent_count == 0) {
+			DiffCommitAgainstParent(repo, odb, bind_data, commits[i], tree, nullptr, nullptr, 0, out[i]);
+			continue;
+		}
+		if (bind_data.parents == GitLogChangesParents::FIRST) {
+			parent_count = 1;
+		}
+		for (unsigned p = 0; p < parent_count; p++) {
+			const git_oid *parent_id = git_commit_parent_id(commit, p);
+			git_tree *parent_tree = parent_id ? tree_cache.Get(parent_id) : nullptr;
+			if (!parent_tree) {
+				continue;
+			}
+			DiffCommitAgainstParent(repo, odb, bind_data, commits[i], tree, parent_tree, parent_id,
+			                        static_cast<int32_t>(p), out[i]);
+		}
+	}
+
+	if (odb) {
+		git_odb_free(odb);
+	}
+}
+
+// Pulls the next window of commit ids off the walk and diffs it, in parallel
+// across batches, into local_state.rows.
+static void FillNextWindow(ClientContext &context, const GitLogChangesFunctionData &bind_data,
+                           GitLogChangesLocalState &local_state) {
+	local_state.rows.clear();
+	local_state.current_index = 0;
+
+	idx_t num_threads = MaxValue<idx_t>(bind_data.max_threads, 1);
+	idx_t window_size = num_threads * LOG_CHANGES_BATCH_SIZE;
+	vector<git_oid> commits;
+	commits.reserve(window_size);
+	git_oid oid;
+	while (commits.size() < window_size) {
+		if (!local_state.walk->Next(oid)) {
+			local_state.walk_done = true;
+			break;
+		}
+		commits.push_back(oid);
+	}
+	if (commits.empty()) {
+		return;
+	}
+
+	vector<vector<GitLogChangeRow>> per_commit(commits.size());
+	idx_t num_batches = (commits.size() + LOG_CHANGES_BATCH_SIZE - 1) / LOG_CHANGES_BATCH_SIZE;
+	if (num_batches <= 1) {
+		DiffCommitBatch(local_state.repo, bind_data, commits, 0, commits.size(), per_commit);
+	} else {
+		std::atomic<idx_t> next_batch(0);
+		RunParallelWorkers(context, MinValue<idx_t>(num_threads, num_batches), [&](idx_t worker) {
+			git_repository *worker_repo = GitRepoPool::GetRepository(bind_data.repo_path);
+			if (!worker_repo) {
+				const git_error *e = git_error_last();
+				throw IOException("git_log_changes: failed to open repository '%s': %s", bind_data.repo_path,
+				                  e ? e->message : "unknown error");
+			}
+			while (true) {
+				idx_t batch = next_batch.fetch_add(1);
+				if (batch >= num_batches) {
+					break;
+				}
+				idx_t begin = batch * LOG_CHANGES_BATCH_SIZE;
+				idx_t end = MinValue<idx_t>(begin + LOG_CHANGES_BATCH_SIZE, commits.size());
+				DiffCommitBatch(worker_repo, bind_data, commits, begin, end, per_commit);
+			}
+		});
+	}
+
+	for (auto &commit_rows : per_commit) {
+		for (auto &row : commit_rows) {
+			local_state.rows.push_back(std::move(row));
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Bind / Init / Function
+//===--------------------------------------------------------------------===//
+
+static unique_ptr<FunctionData> GitLogChangesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	return_types = {
+	    LogicalType::VARCHAR, // repo_path
+	    LogicalType::VARCHAR, // commit_hash
+	    LogicalType::VARCHAR, // parent_hash
+	    LogicalType::INTEGER, // parent_index
+	    LogicalType::VARCHAR, // file_path
+	    LogicalType::VARCHAR, // file_ext
+	    LogicalType::VARCHAR, // old_path
+	    LogicalType::VARCHAR, // status
+	    LogicalType::VARCHAR, // old_blob_hash
+	    LogicalType::VARCHAR, // new_blob_hash
+	    LogicalType::BIGINT,  // old_size
+	    LogicalType::BIGINT   // new_size
+	};
+	names = {"repo_path", "commit_hash",   "parent_hash",   "parent_index", "file_path", "file_ext",
+	         "old_path",  "status",        "old_blob_hash", "new_blob_hash", "old_size",  "new_size"};
+
+	auto bind_data = make_uniq<GitLogChangesFunctionData>();
+	// Unlike git_diff_tree (one pair of trees), a history scan would score
+	// rename candidates for every commit, which dominates its cost, so
+	// detection is opt-in here; 'exact' is the cheap alternative.
+	bind_data->renames.mode = GitDiffRenameMode::OFF;
+
+	string first_param = input.inputs.empty() ? "." : input.inputs[0].GetValue<string>();
+	try {
+		auto git_path = GitPath::Parse("git://" + first_param + "@HEAD");
+		bind_data->repo_path = git_path.repository_path;
+	} catch (const std::exception &e) {
+		throw BinderException("git_log_changes: failed to resolve repository path '%s': %s", first_param, e.what());
+	}
+
+	if (input.inputs.size() > 1 && !input.inputs[1].IsNull()) {
+		bind_data->range = input.inputs[1].GetValue<string>();
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "path") {
+			bind_data->path_filter = kv.second.GetValue<string>();
+		} else if (kv.first == "parents") {
+			auto parents = StringUtil::Lower(kv.second.GetValue<string>());
+			if (parents == "first") {
+				bind_data->parents = GitLogChangesParents::FIRST;
+			} else if (parents == "all") {
+				bind_data->parents = GitLogChangesParents::ALL;
+			} else {
+				throw BinderException("git_log_changes: parents must be 'first' or 'all' (got '%s')", parents);
+			}
+		} else {
+			ApplyRenameParam(kv.first, kv.second, bind_data->renames, "git_log_changes");
+		}
+	}
+
+	bind_data->max_threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> GitLogChangesInitGlobal(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	return make_uniq<GlobalTableFunctionState>();
+}
+
+static unique_ptr<LocalTableFunctionState> GitLogChangesLocalInit(ExecutionContext &context,
+                                                                  TableFunctionInitInput &input,
+                                                                  GlobalTableFunctionState *global_state) {
+	return make_uniq<GitLogChangesLocalState>();
+}
+
+// Peels a parsed revision to the commit it names.
+static bool PeelToCommit(git_object *obj, git_oid &out) {
+	git_object *commit = nullptr;
+	if (git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) != 0) {
+		return false;
+	}
+	git_oid_cpy(&out, git_object_id(commit));
+	git_object_free(commit);
+	return true;
+}
+
+// Pushes `range` onto the walk: "A..B" walks B excluding everything reachable
+// from A; anything else is a single revision.
+static void PushRange(git_repository *repo, GitLogChangesWalk &walk, const string &range) {
+	git_revspec revspec;
+	int error = git_revparse(&revspec, repo, range.c_str());
+	if (error == 0) {
+		git_oid from_id, to_id;
+		if (revspec.flags & GIT_REVSPEC_MERGE_BASE) {
+			git_object_free(revspec.from);
+			git_object_free(revspec.to);
+			throw IOException("git_log_changes: unable to resolve range '%s': symmetric differences (A...B) are not "
+			                  "supported",
+			                  range);
+		}
+		if (revspec.flags & GIT_REVSPEC_RANGE) {
+			if (!PeelToCommit(revspec.from, from_id) || !PeelToCommit(revspec.to, to_id)) {
+				error = -1;
+			} else {
+				walk.Push(to_id, false);
+				walk.Push(from_id, true);
+			}
+		} else if (!PeelToCommit(revspec.from, from_id)) {
+			error = -1;
+		} else {
+			walk.Push(from_id, false);
+		}
+		git_object_free(revspec.from);
+		git_object_free(revspec.to);
+	}
+	if (error != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_log_changes: unable to resolve range '%s': %s", range,
+		                  e ? e->message : "unknown error");
+	}
+}
+
+static void GitLogChangesFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<GitLogChangesFunctionData>();
+	auto &local_state = data_p.local_state->Cast<GitLogChangesLocalState>();
+
+	if (!local_state.initialized) {
+		int error = git_repository_open(&local_state.repo, bind_data.repo_path.c_str());
+		if (error != 0) {
+			const git_error *e = git_error_last();
+			throw IOException("git_log_changes: failed to open repository '%s': %s", bind_data.repo_path,
+			                  e ? e->message : "unknown error");
+		}
+		local_state.walk = make_uniq<GitLogChangesWalk>(local_state.repo);
+		PushRange(local_state.repo, *local_state.walk, bind_data.range);
+		local_state.initialized = true;
+	}
+
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (local_state.current_index >= local_state.rows.size()) {
+			if (local_state.walk_done) {
+				break;
+			}
+			FillNextWindow(context, bind_data, local_state);
+			continue;
+		}
+
+		const auto &row = local_state.rows[local_state.current_index++];
+		output.SetValue(0, count, Value(bind_data.repo_path));
+		SetGitOid(output.data[1], count, &row.commit_id);
+		SetGitOid(output.data[2], count, row.has_parent ? &row.parent_id : nullptr);
+		output.SetValue(3, count, Value::INTEGER(row.parent_index));
+		output.SetValue(4, count, Value(row.file_path));
+		output.SetValue(5, count, Value(row.file_ext));
+		output.SetValue(6, count, row.old_path.empty() ? Value() : Value(row.old_path));
+		output.SetValue(7, count, Value(row.status));
+		SetGitOid(output.data[8], count, row.has_old_blob ? &row.old_blob_id : nullptr);
+		SetGitOid(output.data[9], count, row.has_new_blob ? &row.new_blob_id : nullptr);
+		output.SetValue(10, count, row.old_size < 0 ? Value() : Value::BIGINT(row.old_size));
+		output.SetValue(11, count, row.new_size < 0 ? Value() : Value::BIGINT(row.new_size));
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterGitLogChangesFunction(ExtensionLoader &loader) {
+	TableFunctionSet git_log_changes_set("git_log_changes");
+
+	auto declare_named_params = [](TableFunction &fn) {
+		fn.named_parameters["path"] = LogicalType::VARCHAR;
+		fn.named_parameters["parents"] = LogicalType::VARCHAR;
+		fn.named_parameters["renames"] = LogicalType::VARCHAR;
+		fn.named_parameters["rename_limit"] = LogicalType::BIGINT;
+		fn.named_parameters["similarity_threshold"] = LogicalType::BIGINT;
+	};
+
+	// git_log_changes()
+	TableFunction zero({}, GitLogChangesFunction, GitLogChangesBind, GitLogChangesInitGlobal);
+	zero.init_local = GitLogChangesLocalInit;
+	declare_named_params(zero);
+	git_log_changes_set.AddFunction(zero);
+
+	// git_log_changes(repo_path)
+	TableFunction one({LogicalType::VARCHAR}, GitLogChangesFunction, GitLogChangesBind, GitLogChangesInitGlobal);
+	one.init_local = GitLogChangesLocalInit;
+	declare_named_params(one);
+	git_log_changes_set.AddFunction(one);
+
+	// git_log_changes(repo_path, range)
+	TableFunction two({LogicalType::VARCHAR, LogicalType::VARCHAR}, GitLogChangesFunction, GitLogChangesBind,
+	                  GitLogChangesInitGlobal);
+	two.init_local = GitLogChangesLocalInit;
+	declare_named_params(two);
+	git_log_changes_set.AddFunction(two);
+
+	loader.RegisterFunction(git_log_changes_set);
+}
+
+} // namespace duckdb
@@ -0,0 +1,222 @@
+#include "git_oid_type.hpp"
+
+#include "duckdb/common/vector_operations/unary_executor.hpp"
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/function/cast/cast_function_set.hpp"
+#include "duckdb/function/cast/vector_cast_helpers.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+static constexpr const char *GITOID_SETTING = "duck_tails_gitoid";
+static constexpr const char *GITOID_TYPE_NAME = "GITOID";
+static constexpr const char HEX_DIGITS[] = "0123456789abcdef";
+
+LogicalType GitOidLogicalType() {
+	auto type = LogicalType(LogicalTypeId::BLOB);
+	type.SetAlias(GITOID_TYPE_NAME);
+	return type;
+}
+
+static inline int HexValue(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+// Decodes 40 hex digits into out[20]; false on any non-hex digit.
+static inline bool DecodeOidHex(const char *hex, char *out) {
+	for (idx_t i = 0; i < GIT_OID_RAWSZ; i++) {
+		int hi = HexValue(hex[2 * i]);
+		int lo = HexValue(hex[2 * i + 1]);
+		if ((hi | lo) < 0) {
+			return false;
+		}
+		out[i] = static_cast<char>((hi << 4) | lo);
+	}
+	return true;
+}
+
+static inline void EncodeOidHex(const char *raw, char *out) {
+	for (idx_t i = 0; i < GIT_OID_RAWSZ; i++) {
+		auto byte = static_cast<uint8_t>(raw[i]);
+		out[2 * i] = HEX_DIGITS[byte >> 4];
+		out[2 * i + 1] = HEX_DIGITS[byte & 0xF];
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Casts
+//===--------------------------------------------------------------------===//
+
+static bool GitOidToVarcharCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	bool all_converted = true;
+	UnaryExecutor::ExecuteWithNulls<string_t, string_t>(
+	    source, result, count, [&](string_t oid, ValidityMask &mask, idx_t idx) {
+		    if (oid.GetSize() != GIT_OID_RAWSZ) {
+			    string error = StringUtil::Format("Invalid GITOID of %llu bytes", oid.GetSize());
+			    HandleCastError::AssignError(error, parameters);
+			    all_converted = false;
+			    mask.SetInvalid(idx);
+			    return string_t();
+		    }
+		    auto hex = StringVector::EmptyString(result, GIT_OID_HEXSZ);
+		    EncodeOidHex(oid.GetData(), hex.GetDataWriteable());
+		    hex.Finalize();
+		    return hex;
+	    });
+	return all_converted;
+}
+
+static bool VarcharToGitOidCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	bool all_converted = true;
+	UnaryExecutor::ExecuteWithNulls<string_t, string_t>(
+	    source, result, count, [&](string_t hex, ValidityMask &mask, idx_t idx) {
+		    auto oid = StringVector::EmptyString(result, GIT_OID_RAWSZ);
+		    if (hex.GetSize() != GIT_OID_HEXSZ || !DecodeOidHex(hex.GetData(), oid.GetDataWriteable())) {
+			    string error = StringUtil::Format("Could not convert '%s' to GITOID: expected %d hex digits",
+			                                      hex.GetString(), GIT_OID_HEXSZ);
+			    HandleCastError::AssignError(error, parameters);
+			    all_converted = false;
+			    mask.SetInvalid(idx);
+			    return string_t();
+		    }
+		    oid.Finalize();
+		    return oid;
+	    });
+	return all_converted;
+}
+
+//===--------------------------------------------------------------------===//
+// gitoid_has_prefix(oid, hex_prefix)
+//===--------------------------------------------------------------------===//
+
+static bool OidHasHexPrefix(const string_t &oid, const string_t &prefix) {
+	idx_t length = prefix.GetSize();
+	if (oid.GetSize() != GIT_OID_RAWSZ || length > GIT_OID_HEXSZ) {
+		return false;
+	}
+	auto raw = reinterpret_cast<const uint8_t *>(oid.GetData());
+	auto hex = prefix.GetData();
+	for (idx_t i = 0; i < length; i++) {
+		int digit = HexValue(hex[i]);
+		int nibble = (i % 2 == 0) ? (raw[i / 2] >> 4) : (raw[i / 2] & 0xF);
+		if (digit != nibble) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void GitOidHasPrefixFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<string_t, string_t, bool>(args.data[0], args.data[1], result, args.size(),
+	                                                  OidHasHexPrefix);
+}
+
+//===--------------------------------------------------------------------===//
+// Table function support
+//===--------------------------------------------------------------------===//
+
+vector<column_t> ApplyGitOidColumns(ClientContext &context, const vector<string> &names,
+                                    vector<LogicalType> &return_types) {
+	vector<column_t> columns;
+	Value value;
+	if (!context.TryGetCurrentSetting(GITOID_SETTING, value) || value.IsNull() || !BooleanValue::Get(value)) {
+		return columns;
+	}
+	for (column_t i = 0; i < names.size() && i < return_types.size(); i++) {
+		if (return_types[i].id() == LogicalTypeId::VARCHAR && StringUtil::EndsWith(names[i], "_hash")) {
+			return_types[i] = GitOidLogicalType();
+			columns.push_back(i);
+		}
+	}
+	return columns;
+}
+
+void SetGitOid(Vector &vector, idx_t row, const git_oid *oid) {
+	if (!oid) {
+		FlatVector::SetNull(vector, row, true);
+		return;
+	}
+	auto raw = reinterpret_cast<const char *>(oid->id);
+	auto data = FlatVector::GetData<string_t>(vector);
+	if (vector.GetType().id() == LogicalTypeId::BLOB) {
+		data[row] = StringVector::AddStringOrBlob(vector, raw, GIT_OID_RAWSZ);
+		return;
+	}
+	auto hex = StringVector::EmptyString(vector, GIT_OID_HEXSZ);
+	EncodeOidHex(raw, hex.GetDataWriteable());
+	hex.Finalize();
+	data[row] = hex;
+}
+
+void FinalizeGitOidColumns(DataChunk &output, const vector<column_t> &columns) {
+	idx_t count = output.size();
+	for (auto column : columns) {
+		auto &hashes = output.data[column];
+		if (hashes.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+			if (ConstantVector::IsNull(hashes)) {
+				continue;
+			}
+			auto data = ConstantVector::GetData<string_t>(hashes);
+			if (data->GetSize() == GIT_OID_RAWSZ) {
+				continue; // written raw by SetGitOid
+			}
+			char raw[GIT_OID_RAWSZ];
+			if (data->GetSize() != GIT_OID_HEXSZ || !DecodeOidHex(data->GetData(), raw)) {
+				ConstantVector::SetNull(hashes, true);
+				continue;
+			}
+			*data = StringVector::AddStringOrBlob(hashes, raw, GIT_OID_RAWSZ);
+			continue;
+		}
+		hashes.Flatten(count);
+		auto data = FlatVector::GetData<string_t>(hashes);
+		auto &validity = FlatVector::Validity(hashes);
+		for (idx_t i = 0; i < count; i++) {
+			if (!validity.RowIsValid(i) || data[i].GetSize() == GIT_OID_RAWSZ) {
+				continue;
+			}
+			char raw[GIT_OID_RAWSZ];
+			if (data[i].GetSize() != GIT_OID_HEXSZ || !DecodeOidHex(data[i].GetData(), raw)) {
+				validity.SetInvalid(i);
+				continue;
+			}
+			data[i] = StringVector::AddStringOrBlob(hashes, raw, GIT_OID_RAWSZ);
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterGitOidType(ExtensionLoader &loader) {
+	auto gitoid = GitOidLogicalType();
+	loader.RegisterType(GITOID_TYPE_NAME, gitoid);
+
+	// Hex strings convert implicitly so `commit_hash = '...'` and joins against
+	// VARCHAR hashes bind; the reverse direction is explicit (::VARCHAR).
+	loader.RegisterCastFunction(LogicalType::VARCHAR, gitoid, BoundCastInfo(VarcharToGitOidCast), 1);
+	loader.RegisterCastFunction(gitoid, LogicalType::VARCHAR, BoundCastInfo(GitOidToVarcharCast));
+
+	ScalarFunction has_prefix("gitoid_has_prefix", {gitoid, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                          GitOidHasPrefixFunction);
+	loader.RegisterFunction(has_prefix);
+
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(GITOID_SETTING, "Emit the *_hash columns of the git table functions as GITOID",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+} // namespace duckdb
@@ -1,15 +1,19 @@
 #include "duckdb.hpp"
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_path.hpp"
 #include "git_context_manager.hpp"
 #include "git_utils.hpp"
+#include "git_commit_dag.hpp"
+#include "git_result_cache.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/common/exception.hpp"
 
 #include <git2.h>
+#include <queue>
 
 namespace duckdb {
 
@@ -35,8 +39,8 @@ static void DefineGitParentsSchema(vector<LogicalType> &return_types, vector<str
 static void OutputGitParentsRow(DataChunk &output, idx_t row_idx, const GitParentsRow &row, const string &repo_path) {
 	idx_t col = 0;
 	output.SetValue(col++, row_idx, Value(repo_path));                 // repo_path
-	output.SetValue(col++, row_idx, Value(row.commit_hash));           // commit_hash
-	output.SetValue(col++, row_idx, Value(row.parent_hash));           // parent_hash
+	SetGitOid(output.data[col++], row_idx, &row.commit_id);           // commit_hash
+	SetGitOid(output.data[col++], row_idx, &row.parent_id);           // parent_hash
 	output.SetValue(col++, row_idx, Value::INTEGER(row.parent_index)); // parent_index
 }
 
@@ -78,95 +82,181 @@ unique_ptr<FunctionData> GitParentsBind(ClientContext &context, TableFunctionBin
 	// Use helper to define schema with repo_path as first column
 	DefineGitParentsSchema(return_types, names);
 
-	return make_uniq<GitParentsFunctionData>(final_ref, resolved_repo_path, all_refs);
+	auto bind_data = make_uniq<GitParentsFunctionData>(final_ref, resolved_repo_path, all_refs);
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	bind_data->return_types = return_types;
+	return std::move(bind_data);
+}
+
+//===--------------------------------------------------------------------===//
+// Parent walk
+//
+// Commits come out in topological order (a commit before all of its
+// parents), as with GIT_SORT_TOPOLOGICAL | GIT_SORT_TIME: the walk pops the
+// highest generation number first and the newest committer date among equal
+// generations. With a commit-graph file, generations are stored there, so
+// the walk streams: the first chunk is produced without reading the whole
+// history. Without one, the first generation lookup computes the levels of
+// every ancestor, which costs one pass over the history before the first
+// row, as git's --topo-order does. Parents and dates come from the
+// commit-graph when the commit is in it and from the commit header
+// otherwise; commits are never fully parsed. Memory grows with the number
+// of commits visited (one small node each, kept to skip commits reached
+// again through merges).
+//===--------------------------------------------------------------------===//
+
+struct GitParentsWalkEntry {
+	uint32_t generation;
+	int64_t commit_time;
+	idx_t node;
+
+	bool operator<(const GitParentsWalkEntry &other) const {
+		if (generation != other.generation) {
+			return generation < other.generation;
+		}
+		if (commit_time != other.commit_time) {
+			return commit_time < other.commit_time;
+		}
+		return node > other.node; // ties: first seen first
+	}
+};
+
+struct GitParentsGlobalState : public GlobalTableFunctionState {
+	~GitParentsGlobalState() override {
+		dag.reset();
+		git_repository_free(repo);
+	}
+
+	git_repository *repo = nullptr;
+	unique_ptr<GitCommitDag> dag;
+	std::priority_queue<GitParentsWalkEntry> queue;
+	vector<bool> seen; // by dag node
+
+	// Commit currently being emitted
+	git_oid commit_id;
+	vector<git_oid> current_parents;
+	idx_t next_parent = 0;
+
+	GitResultCacheScan result_cache; // single start commit only
+};
+
+static void PushNode(GitParentsGlobalState &state, idx_t node) {
+	if (state.seen.size() < state.dag->Size()) {
+		state.seen.resize(state.dag->Size(), false);
+	}
+	if (state.seen[node]) {
+		return;
+	}
+	state.seen[node] = true;
+	auto &dag = *state.dag;
+	state.queue.push(GitParentsWalkEntry {dag.Generation(node), dag.CommitTime(node), node});
+}
+
+static void PushCommit(GitParentsGlobalState &state, const git_oid &oid) {
+	PushNode(state, state.dag->Node(oid));
+}
+
+// Moves to the next commit with parents; false when the walk is done.
+static bool NextCommit(GitParentsGlobalState &state) {
+	auto &dag = *state.dag;
+	while (!state.queue.empty()) {
+		idx_t node = state.queue.top().node;
+		state.queue.pop();
+
+		// Copy: pushing parents may add nodes
+		vector<idx_t> parents = dag.Parents(node);
+		state.current_parents.clear();
+		for (auto parent : parents) {
+			state.current_parents.push_back(dag.Id(parent));
+			PushNode(state, parent);
+		}
+		if (!state.current_parents.empty()) {
+			git_oid_cpy(&state.commit_id, &dag.Id(node));
+			state.next_parent = 0;
+			return true;
+		}
+	}
+	return false;
 }
 
 unique_ptr<GlobalTableFunctionState> GitParentsInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-	auto &bind_data = const_cast<GitParentsFunctionData &>(input.bind_data->Cast<GitParentsFunctionData>());
+	auto &bind_data = input.bind_data->Cast<GitParentsFunctionData>();
+	auto state = make_uniq<GitParentsGlobalState>();
 
 	// libgit2 is initialized at extension load time
 
-	git_repository *repo = nullptr;
-	int error = git_repository_open(&repo, bind_data.repo_path.c_str());
+	int error = git_repository_open(&state->repo, bind_data.repo_path.c_str());
 	if (error != 0) {
 		const git_error *e = git_error_last();
 		throw IOException("git_parents: failed to open git repository '%s': %s", bind_data.repo_path,
 		                  e ? e->message : "Unknown error");
 	}
-
-	git_revwalk *walk = nullptr;
-	git_revwalk_new(&walk, repo);
-	git_revwalk_sorting(walk, GIT_SORT_TOPOLOGICAL | GIT_SORT_TIME);
+	state->dag = make_uniq<GitCommitDag>(state->repo);
 
 	if (bind_data.all_refs) {
 		git_reference_iterator *it = nullptr;
-		git_reference_iterator_new(&it, repo);
+		git_reference_iterator_new(&it, state->repo);
 		git_reference *ref;
 		while (!git_reference_next(&ref, it)) {
-			const git_oid *target = git_reference_target(ref);
-			if (target) {
-				git_revwalk_push(walk, target);
+			git_object *commit = nullptr;
+			if (git_reference_peel(&commit, ref, GIT_OBJECT_COMMIT) == 0) {
+				PushCommit(*state, *git_object_id(commit));
+				git_object_free(commit);
 			}
+			git_reference_free(ref);
 		}
 		git_reference_iterator_free(it);
 	} else {
 		git_object *obj = nullptr;
-		if (git_revparse_single(&obj, repo, bind_data.ref.c_str()) != 0) {
+		git_object *commit = nullptr;
+		if (git_revparse_single(&obj, state->repo, bind_data.ref.c_str()) != 0 ||
+		    git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) != 0) {
 			const git_error *e = git_error_last();
-			git_revwalk_free(walk);
-			git_repository_free(repo);
+			git_object_free(obj);
 			throw IOException("git_parents: unable to parse ref '%s': %s", bind_data.ref,
 			                  e ? e->message : "unable to parse OID");
 		}
-		git_oid oid = *git_object_id(obj);
-		git_revwalk_push(walk, &oid);
-		git_object_free(obj);
-	}
-
-	vector<GitParentsRow> rows;
-	git_oid oid;
-	while (!git_revwalk_next(&oid, walk)) {
-		git_commit *commit = nullptr;
-		if (git_commit_lookup(&commit, repo, &oid) != 0) {
-			continue;
+		auto cache = GitResultCache::Get(context);
+		if (cache) {
+			auto key = GitResultCacheKey("git_parents", bind_data.return_types,
+			                             {bind_data.repo_path, oid_to_hex(git_object_id(commit))});
+			state->result_cache.Begin(cache, std::move(key), bind_data.return_types);
 		}
-
-		unsigned int parent_count = git_commit_parentcount(commit);
-		for (unsigned int i = 0; i < parent_count; i++) {
-			const git_oid *parent_oid = git_commit_parent_id(commit, i);
-			rows.push_back(GitParentsRow {oid_to_hex(&oid), oid_to_hex(parent_oid), static_cast<int32_t>(i)});
+		if (!state->result_cache.IsHit()) {
+			PushCommit(*state, *git_object_id(commit));
 		}
-		git_commit_free(commit);
+		git_object_free(commit);
+		git_object_free(obj);
 	}
 
-	// Store rows in bind_data
-	bind_data.rows = std::move(rows);
-
-	git_revwalk_free(walk);
-	git_repository_free(repo);
-
-	return make_uniq<GlobalTableFunctionState>();
+	return std::move(state);
 }
 
 void GitParentsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<GitParentsFunctionData>();
-	auto &local_state = data_p.local_state->Cast<GitParentsLocalState>();
-
-	idx_t remaining = bind_data.rows.size() - local_state.current_index;
-	if (remaining == 0) {
-		output.SetCardinality(0);
+	auto &state = data_p.global_state->Cast<GitParentsGlobalState>();
+	if (state.result_cache.IsHit()) {
+		state.result_cache.Replay(output);
 		return;
 	}
 
-	const idx_t count = MinValue<idx_t>(remaining, STANDARD_VECTOR_SIZE);
+	auto index_data = FlatVector::GetData<int32_t>(output.data[3]);
 
-	for (idx_t i = 0; i < count; i++) {
-		auto &row = bind_data.rows[local_state.current_index + i];
-		OutputGitParentsRow(output, i, row, bind_data.repo_path);
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (state.next_parent >= state.current_parents.size() && !NextCommit(state)) {
+			break;
+		}
+		SetGitOid(output.data[1], count, &state.commit_id);
+		SetGitOid(output.data[2], count, &state.current_parents[state.next_parent]);
+		index_data[count] = static_cast<int32_t>(state.next_parent);
+		state.next_parent++;
+		count++;
 	}
 
+	output.data[0].Reference(Value(bind_data.repo_path));
 	output.SetCardinality(count);
-	local_state.current_index += count;
+	state.result_cache.Record(output);
 }
 
 // Local init for git_parents_each
@@ -201,12 +291,14 @@ static bool ProcessParentsForCommit(const string &repo_path, const string &commi
 	}
 
 	git_commit *commit = reinterpret_cast<git_commit *>(obj);
-	string commit_hash = oid_to_hex(git_commit_id(commit));
 
 	unsigned int parent_count = git_commit_parentcount(commit);
 	for (unsigned int i = 0; i < parent_count; i++) {
-		const git_oid *parent_oid = git_commit_parent_id(commit, i);
-		rows.push_back(GitParentsRow {commit_hash, oid_to_hex(parent_oid), static_cast<int32_t>(i)});
+		GitParentsRow row;
+		git_oid_cpy(&row.commit_id, git_commit_id(commit));
+		git_oid_cpy(&row.parent_id, git_commit_parent_id(commit, i));
+		row.parent_index = static_cast<int32_t>(i);
+		rows.push_back(row);
 	}
 
 	git_commit_free(commit);
@@ -321,6 +413,7 @@ unique_ptr<FunctionData> GitParentsEachBind(ClientContext &context, TableFunctio
 	auto bind_data = make_uniq<GitParentsEachBindData>();
 	bind_data->repo_path = ".";  // Placeholder, actual repo paths come from runtime DataChunk
 	bind_data->ref = params.ref; // This will be "HEAD" by default from ParseLateralGitParams
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
 	return std::move(bind_data);
 }
 
@@ -0,0 +1,513 @@
+#include "git_reachability.hpp"
+#include "git_commit_dag.hpp"
+#include "git_context_manager.hpp"
+#include "git_repo_pool.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <mutex>
+#include <queue>
+
+namespace duckdb {
+
+// Repositories whose index stays cached; older ones are rebuilt on next use.
+static constexpr idx_t MAX_CACHED_INDEXES = 16;
+
+//===--------------------------------------------------------------------===//
+// Index construction
+//===--------------------------------------------------------------------===//
+
+// Hash of every ref name and target. With `tips`, also collects the commit
+// each ref (and HEAD) peels to.
+hash_t GitReachabilityIndex::RefFingerprint(git_repository *repo, vector<git_oid> *tips) {
+	hash_t result = 0;
+	git_reference_iterator *iter = nullptr;
+	if (git_reference_iterator_new(&iter, repo) != 0) {
+		return result;
+	}
+	git_reference *ref = nullptr;
+	while (git_reference_next(&ref, iter) == 0) {
+		const char *name = git_reference_name(ref);
+		result = CombineHash(result, Hash(name, strlen(name)));
+		if (git_reference_type(ref) == GIT_REFERENCE_DIRECT) {
+			auto target = git_reference_target(ref);
+			result = CombineHash(result, Hash(reinterpret_cast<const char *>(target->id), GIT_OID_RAWSZ));
+		} else {
+			const char *target = git_reference_symbolic_target(ref);
+			result = CombineHash(result, Hash(target, strlen(target)));
+		}
+		if (tips) {
+			git_object *commit = nullptr;
+			if (git_reference_peel(&commit, ref, GIT_OBJECT_COMMIT) == 0) {
+				tips->push_back(*git_object_id(commit));
+				git_object_free(commit);
+			}
+		}
+		git_reference_free(ref);
+	}
+	git_reference_iterator_free(iter);
+
+	// A detached HEAD is not under refs/.
+	git_oid head;
+	if (git_reference_name_to_id(&head, repo, "HEAD") == 0) {
+		result = CombineHash(result, Hash(reinterpret_cast<const char *>(head.id), GIT_OID_RAWSZ));
+		if (tips) {
+			git_object *obj = nullptr;
+			git_object *commit = nullptr;
+			if (git_object_lookup(&obj, repo, &head, GIT_OBJECT_ANY) == 0 &&
+			    git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) == 0) {
+				tips->push_back(*git_object_id(commit));
+			}
+			git_object_free(commit);
+			git_object_free(obj);
+		}
+	}
+	return result;
+}
+
+void GitReachabilityIndex::Build(git_repository *repo, const vector<git_oid> &tips) {
+	// Load the whole reachable DAG (from the commit-graph where possible).
+	GitCommitDag dag(repo);
+	for (auto &tip : tips) {
+		dag.Node(tip);
+	}
+	for (idx_t node = 0; node < dag.Size(); node++) {
+		dag.Parents(node);
+	}
+
+	idx_t count = dag.Size();
+	ids.resize(count);
+	generation.resize(count);
+	commit_time.resize(count);
+	parent_offsets.resize(count + 1);
+	index.reserve(count);
+	for (idx_t node = 0; node < count; node++) {
+		ids[node] = dag.Id(node);
+		index.emplace(ids[node], static_cast<uint32_t>(node));
+		generation[node] = dag.Generation(node);
+		commit_time[node] = dag.CommitTime(node);
+		parent_offsets[node] = static_cast<uint32_t>(parents.size());
+		for (auto parent : dag.Parents(node)) {
+			parents.push_back(static_cast<uint32_t>(parent));
+		}
+	}
+	parent_offsets[count] = static_cast<uint32_t>(parents.size());
+
+	// Depth-first labelling over parent edges, rooted at the tips.
+	pre.assign(count, 0);
+	post.assign(count, 0);
+	low.assign(count, 0);
+	vector<bool> visited(count, false);
+	vector<std::pair<uint32_t, uint32_t>> stack; // node, next parent slot
+	uint32_t pre_counter = 0;
+	uint32_t post_counter = 0;
+	for (uint32_t root = 0; root < tips.size() && root < count; root++) {
+		if (visited[root]) {
+			continue;
+		}
+		visited[root] = true;
+		pre[root] = pre_counter++;
+		stack.emplace_back(root, parent_offsets[root]);
+		while (!stack.empty()) {
+			auto &top = stack.back();
+			uint32_t node = top.first;
+			if (top.second < parent_offsets[node + 1]) {
+				uint32_t parent = parents[top.second++];
+				if (!visited[parent]) {
+					visited[parent] = true;
+					pre[parent] = pre_counter++;
+					stack.emplace_back(parent, parent_offsets[parent]);
+				}
+				continue;
+			}
+			// All parents are finished (the graph is acyclic).
+			post[node] = post_counter++;
+			low[node] = post[node];
+			for (uint32_t i = parent_offsets[node]; i < parent_offsets[node + 1]; i++) {
+				low[node] = MinValue(low[node], low[parents[i]]);
+			}
+			stack.pop_back();
+		}
+	}
+}
+
+struct GitCachedReachabilityIndex {
+	// Held while building so concurrent threads of one query build it once
+	std::mutex build_lock;
+	shared_ptr<const GitReachabilityIndex> index;
+	optional_ptr<GitWatchedRepo> watched;
+	uint64_t ref_generation = 0; // of `watched` when the fingerprint last matched
+	uint64_t last_used = 0;
+};
+
+struct GitReachabilityIndexCache {
+	std::mutex lock;
+	unordered_map<string, shared_ptr<GitCachedReachabilityIndex>> entries;
+	uint64_t use_counter = 0;
+};
+
+static GitReachabilityIndexCache &IndexCache() {
+	static GitReachabilityIndexCache cache;
+	return cache;
+}
+
+shared_ptr<const GitReachabilityIndex> GitReachabilityIndex::Get(git_repository *repo, const string &repo_path,
+                                                                 optional_ptr<GitWatchedRepo> watched) {
+	auto &cache = IndexCache();
+	shared_ptr<GitCachedReachabilityIndex> cached;
+	{
+		std::lock_guard<std::mutex> guard(cache.lock);
+		auto &slot = cache.entries[repo_path];
+		if (!slot) {
+			slot = make_shared_ptr<GitCachedReachabilityIndex>();
+		}
+		slot->last_used = ++cache.use_counter;
+		cached = slot;
+		// Evicted entries stay alive for the threads still using them
+		while (cache.entries.size() > MAX_CACHED_INDEXES) {
+			auto oldest = cache.entries.begin();
+			for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+				if (it->second->last_used < oldest->second->last_used) {
+					oldest = it;
+				}
+			}
+			cache.entries.erase(oldest);
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(cached->build_lock);
+	// Read before the refs: a change racing with the fingerprint moves it again.
+	uint64_t generation = watched ? watched->ref_generation.load() : 0;
+	if (watched && cached->index && cached->watched.get() == watched.get() && cached->ref_generation == generation) {
+		return cached->index;
+	}
+	vector<git_oid> tips;
+	hash_t fingerprint = RefFingerprint(repo, &tips);
+	cached->watched = watched;
+	cached->ref_generation = generation;
+	if (!cached->index || cached->index->fingerprint != fingerprint) {
+		auto built = make_shared_ptr<GitReachabilityIndex>();
+		built->fingerprint = fingerprint;
+		built->Build(repo, tips);
+		cached->index = built;
+	}
+	return cached->index;
+}
+
+//===--------------------------------------------------------------------===//
+// Queries
+//===--------------------------------------------------------------------===//
+
+void GitReachabilityIndex::StartWalk(GitReachabilityScratch &scratch) const {
+	if (scratch.mark.size() != ids.size() || ++scratch.epoch == 0) {
+		scratch.mark.assign(ids.size(), 0);
+		scratch.epoch = 1;
+	}
+	scratch.stack.clear();
+}
+
+bool GitReachabilityIndex::IsAncestor(uint32_t ancestor, uint32_t descendant, GitReachabilityScratch &scratch) const {
+	if (ancestor == descendant) {
+		return true;
+	}
+	if (generation[ancestor] >= generation[descendant] || !MayReach(descendant, ancestor)) {
+		return false;
+	}
+	if (TreeContains(descendant, ancestor)) {
+		return true;
+	}
+
+	// Undecided by the labels: walk parents, skipping every commit the labels rule out.
+	StartWalk(scratch);
+	scratch.mark[descendant] = scratch.epoch;
+	scratch.stack.push_back(descendant);
+	while (!scratch.stack.empty()) {
+		uint32_t node = scratch.stack.back();
+		scratch.stack.pop_back();
+		for (uint32_t i = parent_offsets[node]; i < parent_offsets[node + 1]; i++) {
+			uint32_t parent = parents[i];
+			if (parent == ancestor) {
+				return true;
+			}
+			if (scratch.mark[parent] == scratch.epoch) {
+				continue;
+			}
+			scratch.mark[parent] = scratch.epoch;
+			if (generation[parent] <= generation[ancestor] || !MayReach(parent, ancestor)) {
+				continue;
+			}
+			if (TreeContains(parent, ancestor)) {
+				return true;
+			}
+			scratch.stack.push_back(parent);
+		}
+	}
+	return false;
+}
+
+uint32_t GitReachabilityIndex::MergeBase(uint32_t a, uint32_t b, GitReachabilityScratch &scratch) const {
+	if (IsAncestor(a, b, scratch)) {
+		return a;
+	}
+	if (IsAncestor(b, a, scratch)) {
+		return b;
+	}
+
+	// Paint both sides down in decreasing generation order. A commit is only
+	// popped after every commit that can reach it, so one painted from both
+	// sides is a best common ancestor unless a best one found earlier
+	// reaches it (STALE, passed down from every base). The walk stops once
+	// only stale commits are queued.
+	static constexpr uint8_t FROM_A = 1;
+	static constexpr uint8_t FROM_B = 2;
+	static constexpr uint8_t STALE = 4;
+	if (scratch.paint.size() != ids.size()) {
+		scratch.paint.assign(ids.size(), 0);
+	}
+	for (auto node : scratch.painted) {
+		scratch.paint[node] = 0;
+	}
+	scratch.painted.clear();
+	scratch.bases.clear();
+
+	std::priority_queue<std::pair<uint32_t, uint32_t>> queue;
+	idx_t active = 0; // queued commits that are not stale
+	auto paint = [&](uint32_t node, uint8_t bits) {
+		uint8_t &current = scratch.paint[node];
+		if ((current & bits) == bits) {
+			return;
+		}
+		if (current == 0) {
+			scratch.painted.push_back(node);
+			queue.emplace(generation[node], node);
+			active++;
+		}
+		if (!(current & STALE) && (bits & STALE)) {
+			active--;
+		}
+		current |= bits;
+	};
+	paint(a, FROM_A);
+	paint(b, FROM_B);
+	while (!queue.empty() && active > 0) {
+		uint32_t node = queue.top().second;
+		queue.pop();
+		uint8_t bits = scratch.paint[node];
+		if (!(bits & STALE)) {
+			active--;
+		}
+		bits &= FROM_A | FROM_B | STALE;
+		if (bits == (FROM_A | FROM_B)) {
+			scratch.bases.push_back(node);
+			bits |= STALE;
+		}
+		for (uint32_t i = parent_offsets[node]; i < parent_offsets[node + 1]; i++) {
+			paint(parents[i], bits);
+		}
+	}
+
+	uint32_t best = NOT_FOUND;
+	for (auto base : scratch.bases) {
+		if (best == NOT_FOUND || commit_time[base] > commit_time[best]) {
+			best = base;
+		}
+	}
+	return best;
+}
+
+//===--------------------------------------------------------------------===//
+// git_is_ancestor() / git_merge_base() scalar functions
+//===--------------------------------------------------------------------===//
+
+struct GitReachabilityRepo {
+	git_repository *repo = nullptr; // thread-local handle from GitRepoPool
+	shared_ptr<const GitReachabilityIndex> index;
+	GitReachabilityScratch scratch;
+	unordered_map<string, git_oid> revisions; // symbolic revision -> commit
+};
+
+struct GitReachabilityLocalState : public FunctionLocalState {
+	bool watch_refs = false; // duck_tails_ref_watcher
+	bool prewarm = false;    // duck_tails_ref_watcher_prewarm
+	unordered_map<string, unique_ptr<GitReachabilityRepo>> repos;
+	string last_repo_arg;
+	GitReachabilityRepo *last_repo = nullptr;
+};
+
+static unique_ptr<FunctionLocalState> GitReachabilityInitLocal(ExpressionState &state,
+                                                               const BoundFunctionExpression &expr,
+                                                               FunctionData *bind_data) {
+	auto local = make_uniq<GitReachabilityLocalState>();
+	auto &context = state.GetContext();
+	local->watch_refs = RefWatcherEnabled(context);
+	local->prewarm = local->watch_refs && RefWatcherPrewarmEnabled(context);
+	return std::move(local);
+}
+
+static GitReachabilityRepo &GetReachabilityRepo(GitReachabilityLocalState &local, const string &function_name,
+                                                const string &repo_arg) {
+	if (local.last_repo && local.last_repo_arg == repo_arg) {
+		return *local.last_repo;
+	}
+	auto entry = local.repos.find(repo_arg);
+	if (entry == local.repos.end()) {
+		auto ctx = GitContextManager::Instance().ProcessGitUri(repo_arg);
+		auto repo = make_uniq<GitReachabilityRepo>();
+		repo->repo = GitRepoPool::GetRepository(ctx.repo_path);
+		if (!repo->repo) {
+			const git_error *e = git_error_last();
+			throw IOException("%s: failed to open git repository '%s': %s", function_name, ctx.repo_path,
+			                  e ? e->message : "unknown error");
+		}
+		// One index per repository and query: refs are checked once here, not per row.
+		optional_ptr<GitWatchedRepo> watched;
+		if (local.watch_refs) {
+			watched = GitRefWatcher::Instance().Watch(repo->repo, ctx.repo_path, local.prewarm);
+		}
+		repo->index = GitReachabilityIndex::Get(repo->repo, ctx.repo_path, watched);
+		entry = local.repos.emplace(repo_arg, std::move(repo)).first;
+	}
+	local.last_repo_arg = repo_arg;
+	local.last_repo = entry->second.get();
+	return *local.last_repo;
+}
+
+static git_oid ResolveCommit(GitReachabilityRepo &repo, const string &function_name, const string &revision) {
+	git_oid oid;
+	// A full id the index already holds is a known commit; any other id is
+	// looked up (and peeled) like a symbolic revision, so it must exist
+	if (revision.size() == GIT_OID_HEXSZ && git_oid_fromstr(&oid, revision.c_str()) == 0 &&
+	    repo.index->Find(oid) != GitReachabilityIndex::NOT_FOUND) {
+		return oid;
+	}
+	auto cached = repo.revisions.find(revision);
+	if (cached != repo.revisions.end()) {
+		return cached->second;
+	}
+	git_object *obj = nullptr;
+	git_object *commit = nullptr;
+	if (git_revparse_single(&obj, repo.repo, revision.c_str()) != 0 ||
+	    git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) != 0) {
+		const git_error *e = git_error_last();
+		git_object_free(obj);
+		throw IOException("%s: unable to resolve revision '%s': %s", function_name, revision,
+		                  e ? e->message : "unknown error");
+	}
+	git_oid_cpy(&oid, git_object_id(commit));
+	git_object_free(commit);
+	git_object_free(obj);
+	repo.revisions.emplace(revision, oid);
+	return oid;
+}
+
+template <class OP>
+static void ExecuteReachability(DataChunk &args, ExpressionState &state, Vector &result, const string &function_name,
+                                OP &&op) {
+	auto &local = ExecuteFunctionState::GetFunctionState(state)->Cast<GitReachabilityLocalState>();
+
+	UnifiedVectorFormat repo_format, a_format, b_format;
+	args.data[0].ToUnifiedFormat(args.size(), repo_format);
+	args.data[1].ToUnifiedFormat(args.size(), a_format);
+	args.data[2].ToUnifiedFormat(args.size(), b_format);
+	auto repo_data = UnifiedVectorFormat::GetData<string_t>(repo_format);
+	auto a_data = UnifiedVectorFormat::GetData<string_t>(a_format);
+	auto b_data = UnifiedVectorFormat::GetData<string_t>(b_format);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto repo_idx = repo_format.sel->get_index(i);
+		auto a_idx = a_format.sel->get_index(i);
+		auto b_idx = b_format.sel->get_index(i);
+		if (!repo_format.validity.RowIsValid(repo_idx) || !a_format.validity.RowIsValid(a_idx) ||
+		    !b_format.validity.RowIsValid(b_idx)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto &repo = GetReachabilityRepo(local, function_name, repo_data[repo_idx].GetString());
+		git_oid a = ResolveCommit(repo, function_name, a_data[a_idx].GetString());
+		git_oid b = ResolveCommit(repo, function_name, b_data[b_idx].GetString());
+		op(repo, a, b, i);
+	}
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+static void GitIsAncestorFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto result_data = FlatVector::GetData<bool>(result);
+	ExecuteReachability(args, state, result, "git_is_ancestor",
+	                    [&](GitReachabilityRepo &repo, const git_oid &a, const git_oid &b, idx_t row) {
+		                    uint32_t a_node = repo.index->Find(a);
+		                    uint32_t b_node = repo.index->Find(b);
+		                    if (a_node != GitReachabilityIndex::NOT_FOUND && b_node != GitReachabilityIndex::NOT_FOUND) {
+			                    result_data[row] = repo.index->IsAncestor(a_node, b_node, repo.scratch);
+			                    return;
+		                    }
+		                    // Commits no ref reached when the index was built.
+		                    result_data[row] =
+		                        git_oid_equal(&a, &b) || git_graph_descendant_of(repo.repo, &b, &a) == 1;
+	                    });
+}
+
+static void GitMergeBaseFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto result_data = FlatVector::GetData<string_t>(result);
+	ExecuteReachability(args, state, result, "git_merge_base",
+	                    [&](GitReachabilityRepo &repo, const git_oid &a, const git_oid &b, idx_t row) {
+		                    git_oid base;
+		                    uint32_t a_node = repo.index->Find(a);
+		                    uint32_t b_node = repo.index->Find(b);
+		                    if (a_node != GitReachabilityIndex::NOT_FOUND && b_node != GitReachabilityIndex::NOT_FOUND) {
+			                    uint32_t base_node = repo.index->MergeBase(a_node, b_node, repo.scratch);
+			                    if (base_node == GitReachabilityIndex::NOT_FOUND) {
+				                    FlatVector::SetNull(result, row, true);
+				                    return;
+			                    }
+			                    git_oid_cpy(&base, &repo.index->Id(base_node));
+		                    } else if (git_merge_base(&base, repo.repo, &a, &b) != 0) {
+			                    FlatVector::SetNull(result, row, true);
+			                    return;
+		                    }
+		                    char hex[GIT_OID_HEXSZ + 1];
+		                    git_oid_tostr(hex, sizeof(hex), &base);
+		                    result_data[row] = StringVector::AddString(result, hex, GIT_OID_HEXSZ);
+	                    });
+}
+
+void RegisterGitReachabilityFunctions(ExtensionLoader &loader) {
+	ScalarFunction is_ancestor("git_is_ancestor", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                           LogicalType::BOOLEAN, GitIsAncestorFunction);
+	is_ancestor.init_local_state = GitReachabilityInitLocal;
+	is_ancestor.SetStability(FunctionStability::CONSISTENT_WITHIN_QUERY);
+	loader.RegisterFunction(is_ancestor);
+
+	ScalarFunction merge_base("git_merge_base", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                          LogicalType::VARCHAR, GitMergeBaseFunction);
+	merge_base.init_local_state = GitReachabilityInitLocal;
+	merge_base.SetStability(FunctionStability::CONSISTENT_WITHIN_QUERY);
+	loader.RegisterFunction(merge_base);
+
+	// Rebuild the index of a prewarmed repository as soon as its refs settle,
+	// so the next query finds the new commits already labelled. The index
+	// cache is constructed before the watcher so that it outlives the
+	// watcher thread, which the watcher's destructor joins.
+	static std::once_flag prewarm_registered;
+	std::call_once(prewarm_registered, []() {
+		IndexCache();
+		GitRefWatcher::Instance().AddPrewarmCallback([](GitWatchedRepo &watched) {
+			auto repo = GitRepoPool::GetRepository(watched.repo_path);
+			if (!repo) {
+				return;
+			}
+			optional_ptr<GitWatchedRepo> tracked;
+			if (!watched.broken) {
+				tracked = &watched;
+			}
+			GitReachabilityIndex::Get(repo, watched.repo_path, tracked);
+		});
+	});
+}
+
+} // namespace duckdb
@@ -1,7 +1,11 @@
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_utils.hpp"
 #include "git_context_manager.hpp"
+#include "text_utils.hpp"
+#include "git_repo_pool.hpp"
+#include "worktree_hash.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/types/value.hpp"
 #include "duckdb/common/local_file_system.hpp"
@@ -11,61 +15,10 @@
 
 namespace duckdb {
 
-//===--------------------------------------------------------------------===//
-// UTF-8 Validation Helper
-//===--------------------------------------------------------------------===//
-
-// Simple UTF-8 validation to prevent verification crashes
-static bool IsValidUTF8(const char *data, size_t length) {
-	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
-	for (size_t i = 0; i < length;) {
-		unsigned char byte = bytes[i];
-
-		// ASCII (0-127)
-		if (byte <= 0x7F) {
-			i++;
-			continue;
-		}
-
-		// Multi-byte sequence
-		int num_bytes = 0;
-		if ((byte & 0xE0) == 0xC0) {
-			num_bytes = 2;
-		} else if ((byte & 0xF0) == 0xE0) {
-			num_bytes = 3;
-		} else if ((byte & 0xF8) == 0xF0) {
-			num_bytes = 4;
-		} else {
-			return false; // Invalid start byte
-		}
-
-		// Check if we have enough bytes
-		if (i + num_bytes > length) {
-			return false;
-		}
-
-		// Check continuation bytes
-		for (int j = 1; j < num_bytes; j++) {
-			if ((bytes[i + j] & 0xC0) != 0x80) {
-				return false;
-			}
-		}
-
-		i += num_bytes;
-	}
-	return true;
-}
-
 //===--------------------------------------------------------------------===//
 // Helper Functions
 //===--------------------------------------------------------------------===//
 
-static string oid_to_hex(const git_oid *oid) {
-	char hex[GIT_OID_HEXSZ + 1];
-	git_oid_tostr(hex, sizeof(hex), oid);
-	return string(hex);
-}
-
 static string ExtractFileExtension(const string &path) {
 	size_t dot_pos = path.find_last_of('.');
 	if (dot_pos == string::npos || dot_pos == path.length() - 1) {
@@ -128,14 +81,16 @@ struct GitReadBindData : public TableFunctionData {
 	string transcode;
 	string filters;
 	string repo_path;
-	string uri; // For static git_read function
-	string ref; // Fallback ref for GitContextManager
+	string uri;             // For static git_read function
+	string ref;             // Fallback ref for GitContextManager
+	bool fast_hash = false; // duck_tails_fast_hash: SHA-1 used for WORKDIR blob_hash
 
 	GitReadBindData(int64_t max_bytes, const string &decode_base64, const string &transcode, const string &filters,
 	                const string &repo_path, const string &uri = "", const string &ref = "HEAD")
 	    : max_bytes(max_bytes), decode_base64(decode_base64), transcode(transcode), filters(filters),
 	      repo_path(repo_path), uri(uri), ref(ref) {
 	}
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
 };
 
 // Global state for static git_read function
@@ -157,12 +112,14 @@ struct GitReadLocalState : public LocalTableFunctionState {
 	struct ReadResult {
 		string git_uri;     // Renamed from uri - complete git:// URI
 		string repo_path;   // NEW - repository filesystem path
-		string commit_hash; // NEW - Git commit hash
-		string tree_hash;   // NEW - Git tree hash containing the file
+		git_oid commit_id;  // NEW - Git commit hash
+		git_oid tree_id;    // NEW - Git tree hash containing the file
+		git_oid blob_id;    // NEW - Git blob hash of file content
+		bool has_commit;    // commit_hash/tree_hash are NULL for WORKDIR/INDEX reads
+		bool has_blob;      // blob_hash is '' when the file could not be hashed
 		string file_path;   // NEW - File path within repository
 		string file_ext;    // NEW - File extension (e.g., .js, .cpp, .md)
 		string ref;         // NEW - Git reference (SHA/branch/tag)
-		string blob_hash;   // NEW - Git blob hash of file content
 		int32_t mode;       // File mode
 		string kind;        // Object kind (blob, tree, etc.)
 		bool is_text;       // Whether content is text
@@ -174,9 +131,9 @@ struct GitReadLocalState : public LocalTableFunctionState {
 
 		// Constructor to ensure proper initialization
 		ReadResult()
-		    : git_uri(""), repo_path(""), commit_hash(""), tree_hash(""), file_path(""), file_ext(""), ref(""),
-		      blob_hash(""), mode(0), kind("blob"), is_text(true), encoding("utf8"), size_bytes(0), truncated(false),
-		      text(""), blob("") {
+		    : git_uri(""), repo_path(""), commit_id(), tree_id(), blob_id(), has_commit(false), has_blob(false),
+		      file_path(""), file_ext(""), ref(""), mode(0), kind("blob"), is_text(true), encoding("utf8"),
+		      size_bytes(0), truncated(false), text(""), blob("") {
 		}
 	};
 
@@ -194,6 +151,16 @@ static unique_ptr<GlobalTableFunctionState> GitReadInitGlobal(ClientContext &con
 	return make_uniq<GitReadGlobalState>();
 }
 
+// blob_hash of a result; a file that could not be hashed gets '', which
+// FinalizeGitOidColumns turns into NULL for GITOID output.
+static void SetBlobHash(Vector &hashes, idx_t row_idx, const GitReadLocalState::ReadResult &result) {
+	if (result.has_blob) {
+		SetGitOid(hashes, row_idx, &result.blob_id);
+	} else {
+		hashes.SetValue(row_idx, Value(""));
+	}
+}
+
 // Helper to populate text/blob content fields from raw data
 static void PopulateContentFields(const char *raw_content, size_t raw_size, int64_t max_bytes,
                                   GitReadLocalState::ReadResult &result) {
@@ -266,6 +233,13 @@ static void ProcessWorkdirRead(const string &repo_path, const string &file_path,
 	result.kind = "file";
 	result.mode = 0100644; // Regular file
 
+	// The content is already in memory, so hashing it costs one pass over the buffer.
+	git_repository *repo = GitRepoPool::GetRepository(repo_path);
+	if (repo && HashWorktreeContent(repo, abs_path, file_path, content.data(), content.size(), bind_data.fast_hash,
+	                                result.blob_id)) {
+		result.has_blob = true;
+	}
+
 	PopulateContentFields(content.data(), content.size(), bind_data.max_bytes, result);
 }
 
@@ -316,7 +290,8 @@ static void ProcessIndexRead(const string &repo_path, const string &file_path, c
 	result.file_path = file_path;
 	result.file_ext = ExtractFileExtension(file_path);
 	result.ref = "STAGED";
-	result.blob_hash = oid_to_hex(&entry->id);
+	git_oid_cpy(&result.blob_id, &entry->id);
+	result.has_blob = true;
 	result.kind = "file";
 	result.mode = entry->mode;
 
@@ -347,12 +322,11 @@ static void ProcessGitURI(const string &uri, const GitReadBindData &bind_data, G
 	// Initialize all fields with defaults
 	result.git_uri = uri;
 	result.repo_path = "";
-	result.commit_hash = "";
-	result.tree_hash = "";
+	result.has_commit = false;
 	result.file_path = "";
 	result.file_ext = "";
 	result.ref = "";
-	result.blob_hash = "";
+	result.has_blob = false;
 	result.mode = 0;
 	result.kind = "unknown";
 	result.is_text = false;
@@ -414,8 +388,9 @@ static void ProcessGitURI(const string &uri, const GitReadBindData &bind_data, G
 		}
 
 		// Populate hash fields
-		result.commit_hash = oid_to_hex(commit_oid);
-		result.tree_hash = oid_to_hex(git_tree_id(tree));
+		git_oid_cpy(&result.commit_id, commit_oid);
+		git_oid_cpy(&result.tree_id, git_tree_id(tree));
+		result.has_commit = true;
 
 		// Find the file in the tree
 		git_tree_entry *entry = nullptr;
@@ -433,8 +408,8 @@ static void ProcessGitURI(const string &uri, const GitReadBindData &bind_data, G
 		result.mode = static_cast<int32_t>(filemode);
 
 		// Get blob hash from tree entry
-		const git_oid *entry_oid = git_tree_entry_id(entry);
-		result.blob_hash = oid_to_hex(entry_oid);
+		git_oid_cpy(&result.blob_id, git_tree_entry_id(entry));
+		result.has_blob = true;
 
 		switch (filemode) {
 		case GIT_FILEMODE_BLOB:
@@ -667,7 +642,11 @@ static unique_ptr<FunctionData> GitReadBind(ClientContext &context, TableFunctio
 	names = {"git_uri", "repo_path", "commit_hash", "tree_hash", "file_path",  "file_ext",  "ref",  "blob_hash",
 	         "mode",    "kind",      "is_text",     "encoding",  "size_bytes", "truncated", "text", "blob"};
 
-	return make_uniq<GitReadBindData>(max_bytes, decode_base64, transcode, filters, repo_path, uri, fallback_ref);
+	auto bind_data =
+	    make_uniq<GitReadBindData>(max_bytes, decode_base64, transcode, filters, repo_path, uri, fallback_ref);
+	bind_data->fast_hash = FastHashEnabled(context);
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
 }
 
 // Static git_read execution function (processes single URI from bind data)
@@ -687,12 +666,12 @@ static void GitReadFunction(ClientContext &context, TableFunctionInput &input, D
 	// Fill output row using safe SetValue pattern (Our Fix #2)
 	output.SetValue(0, 0, Value(result.git_uri));                                            // git_uri
 	output.SetValue(1, 0, Value(result.repo_path));                                          // repo_path
-	output.SetValue(2, 0, result.commit_hash.empty() ? Value() : Value(result.commit_hash)); // commit_hash
-	output.SetValue(3, 0, result.tree_hash.empty() ? Value() : Value(result.tree_hash));     // tree_hash
+	SetGitOid(output.data[2], 0, result.has_commit ? &result.commit_id : nullptr);           // commit_hash
+	SetGitOid(output.data[3], 0, result.has_commit ? &result.tree_id : nullptr);             // tree_hash
 	output.SetValue(4, 0, Value(result.file_path));                                          // file_path
 	output.SetValue(5, 0, Value(result.file_ext));                                           // file_ext
 	output.SetValue(6, 0, Value(result.ref));                                                // ref
-	output.SetValue(7, 0, Value(result.blob_hash));                                          // blob_hash
+	SetBlobHash(output.data[7], 0, result);                                                  // blob_hash
 	output.SetValue(8, 0, Value::INTEGER(result.mode));                                      // mode
 	output.SetValue(9, 0, Value(result.kind));                                               // kind
 	output.SetValue(10, 0, Value::BOOLEAN(result.is_text));                                  // is_text
@@ -715,6 +694,7 @@ static void GitReadFunction(ClientContext &context, TableFunctionInput &input, D
 	}
 
 	output.SetCardinality(1);
+	FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 	gstate.finished = true;
 }
 
@@ -767,7 +747,11 @@ static unique_ptr<FunctionData> GitReadEachBind(ClientContext &context, TableFun
 	         "mode",    "kind",      "is_text",     "encoding",  "size_bytes", "truncated", "text", "blob"};
 
 	// LATERAL-only: never store URI in bind_data, it always comes from input DataChunk
-	return make_uniq<GitReadBindData>(max_bytes, decode_base64, transcode, filters, repo_path, "", fallback_ref);
+	auto bind_data =
+	    make_uniq<GitReadBindData>(max_bytes, decode_base64, transcode, filters, repo_path, "", fallback_ref);
+	bind_data->fast_hash = FastHashEnabled(context);
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
 }
 
 static unique_ptr<LocalTableFunctionState> GitReadLocalInit(ExecutionContext &context, TableFunctionInitInput &input,
@@ -863,18 +847,10 @@ static OperatorResultType GitReadEachFunction(ExecutionContext &context, TableFu
 			}
 			if (col_count > 1)
 				output.SetValue(1, i, Value(result.repo_path)); // repo_path
-			if (col_count > 2) {
-				if (result.commit_hash.empty()) {
-					output.SetValue(2, i, Value()); // NULL commit_hash for WORKDIR/INDEX
-				} else {
-					string safe_commit_hash;
-					safe_commit_hash.reserve(result.commit_hash.length() + 1);
-					safe_commit_hash.assign(result.commit_hash.begin(), result.commit_hash.end());
-					output.SetValue(2, i, Value(safe_commit_hash));
-				}
-			}
+			if (col_count > 2) // NULL commit_hash for WORKDIR/INDEX
+				SetGitOid(output.data[2], i, result.has_commit ? &result.commit_id : nullptr);
 			if (col_count > 3)
-				output.SetValue(3, i, result.tree_hash.empty() ? Value() : Value(result.tree_hash)); // tree_hash
+				SetGitOid(output.data[3], i, result.has_commit ? &result.tree_id : nullptr); // tree_hash
 			if (col_count > 4)
 				output.SetValue(4, i, Value(result.file_path)); // file_path
 			if (col_count > 5)
@@ -882,7 +858,7 @@ static OperatorResultType GitReadEachFunction(ExecutionContext &context, TableFu
 			if (col_count > 6)
 				output.SetValue(6, i, Value(result.ref)); // ref
 			if (col_count > 7)
-				output.SetValue(7, i, Value(result.blob_hash)); // blob_hash
+				SetBlobHash(output.data[7], i, result); // blob_hash
 			if (col_count > 8)
 				output.SetValue(8, i, Value::INTEGER(result.mode)); // mode
 			if (col_count > 9)
@@ -917,6 +893,7 @@ static OperatorResultType GitReadEachFunction(ExecutionContext &context, TableFu
 
 		// Set cardinality after all values are filled to ensure proper vector initialization
 		output.SetCardinality(count);
+		FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 
 		// Force vector verification and finalization for LATERAL chain safety
 		if (count > 0) {
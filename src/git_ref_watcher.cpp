@@ -0,0 +1,322 @@
+#include "git_ref_watcher.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+static constexpr const char *REF_WATCHER_SETTING = "duck_tails_ref_watcher";
+static constexpr const char *REF_WATCHER_PREWARM_SETTING = "duck_tails_ref_watcher_prewarm";
+
+// A push or fetch updates several refs in a row; prewarming waits until no
+// event arrived for this long so it runs once, on the final state.
+static constexpr int PREWARM_SETTLE_MS = 100;
+
+GitRefWatcher &GitRefWatcher::Instance() {
+	static GitRefWatcher instance;
+	return instance;
+}
+
+void GitRefWatcher::AddPrewarmCallback(PrewarmCallback callback) {
+	std::lock_guard<std::mutex> guard(lock);
+	prewarm_callbacks.push_back(std::move(callback));
+}
+
+void GitRefWatcher::Prewarm(const vector<GitWatchedRepo *> &moved) {
+	vector<PrewarmCallback> callbacks;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		callbacks = prewarm_callbacks;
+	}
+	for (auto repo : moved) {
+		for (auto &callback : callbacks) {
+			try {
+				callback(*repo);
+			} catch (const std::exception &) {
+				// The next query rebuilds (and reports errors) on its own
+			}
+		}
+	}
+}
+
+#ifdef __linux__
+
+GitRefWatcher::~GitRefWatcher() {
+	if (thread.joinable()) {
+		char byte = 0;
+		(void)!write(wake_fds[1], &byte, 1);
+		thread.join();
+	}
+	for (int fd : {inotify_fd, wake_fds[0], wake_fds[1]}) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+}
+
+optional_ptr<GitWatchedRepo> GitRefWatcher::Watch(git_repository *repo, const string &repo_path, bool prewarm) {
+	const char *git_dir = git_repository_path(repo);
+	const char *common_dir = git_repository_commondir(repo);
+	if (!git_dir || !common_dir) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	auto entry = repos.find(git_dir);
+	if (entry == repos.end()) {
+		if (!Start()) {
+			return nullptr;
+		}
+		auto watched = make_uniq<GitWatchedRepo>();
+		watched->repo_path = repo_path;
+		watched->git_dir = git_dir;
+		watched->common_dir = common_dir;
+		bool watching = AddWatch(watched->git_dir, false, *watched);
+		if (watching && watched->common_dir != watched->git_dir) {
+			watching = AddWatch(watched->common_dir, false, *watched);
+		}
+		if (watching) {
+			watching = AddRefsTree(watched->common_dir + "refs", *watched);
+		}
+		if (!watching) {
+			// Out of watches (max_user_watches) or unreadable: a partly
+			// watched repository would miss changes, so leave it to the caller
+			RemoveWatches(*watched);
+			return nullptr;
+		}
+		entry = repos.emplace(git_dir, std::move(watched)).first;
+	}
+	if (entry->second->broken) {
+		return nullptr;
+	}
+	if (prewarm) {
+		entry->second->prewarm = true;
+	}
+	return entry->second.get();
+}
+
+bool GitRefWatcher::Start() {
+	if (inotify_fd >= 0) {
+		return true;
+	}
+	if (failed) {
+		return false;
+	}
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd < 0 || pipe2(wake_fds, O_CLOEXEC) != 0) {
+		// Out of inotify instances or descriptors: stay off for this process
+		failed = true;
+		return false;
+	}
+	thread = std::thread([this]() { Run(); });
+	return true;
+}
+
+bool GitRefWatcher::AddWatch(const string &path, bool refs_dir, GitWatchedRepo &repo) {
+	// Git replaces files by renaming a .lock file over them, which shows up
+	// as IN_MOVED_TO of the final name
+	uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ONLYDIR;
+	int wd = inotify_add_watch(inotify_fd, path.c_str(), mask);
+	if (wd < 0) {
+		return false;
+	}
+	// Watching a directory twice (worktrees sharing refs/) returns the same descriptor
+	auto &target = targets[wd];
+	target.path = path;
+	target.refs_dir = refs_dir;
+	if (std::find(target.repos.begin(), target.repos.end(), &repo) == target.repos.end()) {
+		target.repos.push_back(&repo);
+	}
+	return true;
+}
+
+void GitRefWatcher::RemoveWatches(GitWatchedRepo &repo) {
+	for (auto target = targets.begin(); target != targets.end();) {
+		auto &target_repos = target->second.repos;
+		target_repos.erase(std::remove(target_repos.begin(), target_repos.end(), &repo), target_repos.end());
+		if (target_repos.empty()) {
+			inotify_rm_watch(inotify_fd, target->first);
+			target = targets.erase(target);
+		} else {
+			++target;
+		}
+	}
+}
+
+// False if the directory or one below it could not be watched. A directory
+// that vanished in the meantime is not a failure: its parent's event covers it.
+bool GitRefWatcher::AddRefsTree(const string &path, GitWatchedRepo &repo) {
+	if (!AddWatch(path, true, repo)) {
+		return errno == ENOENT || errno == ENOTDIR;
+	}
+	DIR *dir = opendir(path.c_str());
+	if (!dir) {
+		return errno == ENOENT || errno == ENOTDIR;
+	}
+	vector<string> subdirs;
+	while (auto entry = readdir(dir)) {
+		string name = entry->d_name;
+		if (name == "." || name == "..") {
+			continue;
+		}
+		bool is_dir = entry->d_type == DT_DIR;
+		if (entry->d_type == DT_UNKNOWN) {
+			struct stat st;
+			is_dir = stat((path + "/" + name).c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+		}
+		if (is_dir) {
+			subdirs.push_back(path + "/" + name);
+		}
+	}
+	closedir(dir);
+	bool watching = true;
+	for (auto &subdir : subdirs) {
+		watching = AddRefsTree(subdir, repo) && watching;
+	}
+	return watching;
+}
+
+static void BumpRefs(GitWatchedRepo &repo, vector<GitWatchedRepo *> &moved) {
+	repo.ref_generation++;
+	if (repo.prewarm && std::find(moved.begin(), moved.end(), &repo) == moved.end()) {
+		moved.push_back(&repo);
+	}
+}
+
+void GitRefWatcher::HandleEvents(const char *buffer, idx_t length, vector<GitWatchedRepo *> &moved) {
+	for (idx_t offset = 0; offset < length;) {
+		auto event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+		offset += sizeof(struct inotify_event) + event->len;
+
+		if (event->mask & IN_Q_OVERFLOW) {
+			// Events were dropped: assume everything moved, and watch any
+			// refs/ directory whose creation was among them
+			for (auto &repo : repos) {
+				if (!AddRefsTree(repo.second->common_dir + "refs", *repo.second)) {
+					repo.second->broken = true;
+				}
+				BumpRefs(*repo.second, moved);
+				repo.second->index_generation++;
+			}
+			continue;
+		}
+		auto target = targets.find(event->wd);
+		if (target == targets.end()) {
+			continue;
+		}
+		if (event->mask & IN_IGNORED) {
+			// Directory removed (e.g. an emptied refs/ subdirectory)
+			targets.erase(target);
+			continue;
+		}
+		string name = event->len ? string(event->name) : string();
+		if (StringUtil::EndsWith(name, ".lock")) {
+			continue;
+		}
+		// Copies: adding watches may rehash `targets`
+		auto path = target->second.path;
+		auto target_repos = target->second.repos;
+		if (target->second.refs_dir) {
+			if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+				for (auto repo : target_repos) {
+					if (!AddRefsTree(path + "/" + name, *repo)) {
+						repo->broken = true;
+					}
+				}
+			}
+			for (auto repo : target_repos) {
+				BumpRefs(*repo, moved);
+			}
+		} else if (name == "HEAD" || name == "packed-refs") {
+			for (auto repo : target_repos) {
+				BumpRefs(*repo, moved);
+			}
+		} else if (name == "index") {
+			for (auto repo : target_repos) {
+				repo->index_generation++;
+			}
+		}
+	}
+}
+
+void GitRefWatcher::Run() {
+	alignas(struct inotify_event) char buffer[16384];
+	vector<GitWatchedRepo *> moved; // repositories waiting to be prewarmed
+	while (true) {
+		struct pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {wake_fds[0], POLLIN, 0}};
+		int ready = poll(fds, 2, moved.empty() ? -1 : PREWARM_SETTLE_MS);
+		if (ready < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		if (fds[1].revents) {
+			return;
+		}
+		if (ready == 0) {
+			Prewarm(moved);
+			moved.clear();
+			continue;
+		}
+		ssize_t length;
+		while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0) {
+			std::lock_guard<std::mutex> guard(lock);
+			HandleEvents(buffer, NumericCast<idx_t>(length), moved);
+		}
+	}
+}
+
+#else
+
+GitRefWatcher::~GitRefWatcher() {
+}
+
+optional_ptr<GitWatchedRepo> GitRefWatcher::Watch(git_repository *repo, const string &repo_path, bool prewarm) {
+	return nullptr;
+}
+
+#endif
+
+bool RefWatcherEnabled(ClientContext &context) {
+	Value value;
+	if (!context.TryGetCurrentSetting(REF_WATCHER_SETTING, value) || value.IsNull()) {
+		return false;
+	}
+	return BooleanValue::Get(value);
+}
+
+bool RefWatcherPrewarmEnabled(ClientContext &context) {
+	Value value;
+	if (!context.TryGetCurrentSetting(REF_WATCHER_PREWARM_SETTING, value) || value.IsNull()) {
+		return false;
+	}
+	return BooleanValue::Get(value);
+}
+
+void RegisterGitRefWatcherSettings(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(REF_WATCHER_SETTING,
+	                          "Watch repositories with inotify so ref and index caches are invalidated as soon as "
+	                          "refs move, instead of being re-checked on every query (Linux only)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption(REF_WATCHER_PREWARM_SETTING,
+	                          "With duck_tails_ref_watcher, rebuild the caches of a repository in the background "
+	                          "right after its refs move",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+} // namespace duckdb
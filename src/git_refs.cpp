@@ -0,0 +1,633 @@
+#include "duckdb.hpp"
+#include "git_functions.hpp"
+#include "git_oid_type.hpp"
+#include "git_path.hpp"
+#include "git_utils.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/function/function_set.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+#include <git2.h>
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// git_refs — every reference of a repository, read straight from disk.
+//
+// packed-refs is parsed in place: with the `sorted` trait the first ref of
+// the requested prefix is found by bisection and the scan stops at the end of
+// the prefix range; `^` lines provide peeled ids. Loose refs under the prefix
+// directory are merged on top (a loose ref wins over its packed copy). Only
+// annotated tags without a peeled line are peeled through the object
+// database, with results cached process-wide by tag id.
+//===--------------------------------------------------------------------===//
+
+static constexpr idx_t REF_NAME_COLUMN = 1;
+static constexpr idx_t MAX_SYMREF_DEPTH = 5;
+
+struct GitRefEntry {
+	string name;
+	git_oid target;
+	bool has_target = false;
+	string symbolic_target; // for symbolic refs (e.g. HEAD)
+	git_oid peeled;
+	bool has_peeled = false;
+	bool peel_known = false; // packed-refs traits guarantee a missing `^` line means "does not peel"
+	bool is_packed = false;
+};
+
+struct GitRefsFunctionData : public TableFunctionData {
+	string repo_path;
+	string prefix;         // full ref name prefix, e.g. "refs/tags/"
+	bool no_match = false; // pushed-down filters cannot match any ref
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+};
+
+struct GitRefsGlobalState : public GlobalTableFunctionState {
+	vector<GitRefEntry> refs;
+	idx_t offset = 0;
+};
+
+static bool ReadWholeFile(const string &path, string &out) {
+	FILE *f = fopen(path.c_str(), "rb");
+	if (!f) {
+		return false;
+	}
+	out.clear();
+	char buffer[64 * 1024];
+	size_t n;
+	while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+		out.append(buffer, n);
+	}
+	bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
+
+//===--------------------------------------------------------------------===//
+// Tag peel cache
+//===--------------------------------------------------------------------===//
+
+// Maps an object id to what it peels to (itself for non-tags). Tag objects
+// are immutable, so entries never go stale and can be shared across
+// repositories and queries.
+class GitTagPeelCache {
+public:
+	static GitTagPeelCache &Instance() {
+		static GitTagPeelCache instance;
+		return instance;
+	}
+
+	bool Lookup(const git_oid &id, git_oid &peeled) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = entries.find(id);
+		if (it == entries.end()) {
+			return false;
+		}
+		peeled = it->second;
+		return true;
+	}
+
+	void Insert(const git_oid &id, const git_oid &peeled) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (entries.size() >= MAX_ENTRIES) {
+			entries.clear();
+		}
+		entries[id] = peeled;
+	}
+
+private:
+	static constexpr idx_t MAX_ENTRIES = 1 << 20;
+	std::mutex lock;
+	unordered_map<git_oid, git_oid, GitOidHash, GitOidEqual> entries;
+};
+
+// Peels `id` through any chain of tag objects. The object type comes from
+// the object header, so lightweight tags cost one header read (once).
+static bool PeelTagTarget(git_repository *repo, const git_oid &id, git_oid &peeled) {
+	auto &cache = GitTagPeelCache::Instance();
+	if (cache.Lookup(id, peeled)) {
+		return true;
+	}
+
+	git_odb *odb = nullptr;
+	if (git_repository_odb(&odb, repo) != 0) {
+		return false;
+	}
+	size_t size;
+	git_object_t type;
+	int error = git_odb_read_header(&size, &type, odb, &id);
+	git_odb_free(odb);
+	if (error != 0) {
+		return false;
+	}
+
+	if (type != GIT_OBJECT_TAG) {
+		peeled = id;
+	} else {
+		git_tag *tag = nullptr;
+		if (git_tag_lookup(&tag, repo, &id) != 0) {
+			return false;
+		}
+		git_object *target = nullptr;
+		error = git_tag_peel(&target, tag);
+		git_tag_free(tag);
+		if (error != 0) {
+			return false;
+		}
+		git_oid_cpy(&peeled, git_object_id(target));
+		git_object_free(target);
+	}
+	cache.Insert(id, peeled);
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// packed-refs
+//===--------------------------------------------------------------------===//
+
+struct PackedRefsTraits {
+	bool peeled = false;       // refs/tags/* carry `^` lines where they peel
+	bool fully_peeled = false; // every ref carries a `^` line where it peels
+	bool sorted = false;       // records are sorted by ref name
+};
+
+static const char *LineEnd(const char *pos, const char *end) {
+	auto newline = static_cast<const char *>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+	return newline ? newline : end;
+}
+
+// Ref name of the record starting at `record` ("<hex> <name>").
+static bool RecordName(const char *record, const char *line_end, const char *&name, size_t &name_len) {
+	if (line_end - record < GIT_OID_HEXSZ + 2 || record[GIT_OID_HEXSZ] != ' ') {
+		return false;
+	}
+	name = record + GIT_OID_HEXSZ + 1;
+	name_len = static_cast<size_t>(line_end - name);
+	if (name_len > 0 && name[name_len - 1] == '\r') {
+		name_len--;
+	}
+	return true;
+}
+
+static int CompareName(const char *name, size_t name_len, const string &prefix) {
+	size_t n = MinValue<size_t>(name_len, prefix.size());
+	int cmp = memcmp(name, prefix.data(), n);
+	if (cmp != 0) {
+		return cmp;
+	}
+	return name_len < prefix.size() ? -1 : 0;
+}
+
+// First record at or after the prefix in a sorted packed-refs body. `lo`
+// always points at a record line (never a `^` line).
+static const char *FindFirstRecord(const char *begin, const char *end, const string &prefix) {
+	const char *lo = begin;
+	const char *hi = end;
+	while (lo < hi) {
+		const char *rec = lo + (hi - lo) / 2;
+		while (rec > lo && rec[-1] != '\n') {
+			rec--;
+		}
+		while (rec > lo && *rec == '^') {
+			rec--;
+			while (rec > lo && rec[-1] != '\n') {
+				rec--;
+			}
+		}
+		const char *line_end = LineEnd(rec, end);
+		const char *name;
+		size_t name_len;
+		if (RecordName(rec, line_end, name, name_len) && CompareName(name, name_len, prefix) < 0) {
+			lo = line_end < end ? line_end + 1 : end;
+			while (lo < end && *lo == '^') {
+				const char *peel_end = LineEnd(lo, end);
+				lo = peel_end < end ? peel_end + 1 : end;
+			}
+		} else {
+			hi = rec;
+		}
+	}
+	return lo;
+}
+
+static void ParsePackedRefs(const string &content, const string &prefix, vector<GitRefEntry> &out) {
+	const char *pos = content.data();
+	const char *end = pos + content.size();
+
+	PackedRefsTraits traits;
+	if (pos < end && *pos == '#') {
+		const char *header_end = LineEnd(pos, end);
+		string header(pos, header_end);
+		static const string TRAITS_PREFIX = "# pack-refs with:";
+		if (StringUtil::StartsWith(header, TRAITS_PREFIX)) {
+			for (auto &trait : StringUtil::Split(header.substr(TRAITS_PREFIX.size()), ' ')) {
+				if (trait == "peeled") {
+					traits.peeled = true;
+				} else if (trait == "fully-peeled") {
+					traits.fully_peeled = true;
+				} else if (trait == "sorted") {
+					traits.sorted = true;
+				}
+			}
+		}
+		pos = header_end < end ? header_end + 1 : end;
+	}
+	if (traits.sorted && !prefix.empty()) {
+		pos = FindFirstRecord(pos, end, prefix);
+	}
+
+	bool last_included = false;
+	idx_t first_new = out.size();
+	while (pos < end) {
+		const char *line_end = LineEnd(pos, end);
+		if (*pos == '^') {
+			if (last_included && line_end - pos > GIT_OID_HEXSZ) {
+				auto &entry = out.back();
+				entry.has_peeled = git_oid_fromstrn(&entry.peeled, pos + 1, GIT_OID_HEXSZ) == 0;
+			}
+		} else if (*pos != '#') {
+			const char *name;
+			size_t name_len;
+			last_included = false;
+			if (RecordName(pos, line_end, name, name_len)) {
+				if (CompareName(name, name_len, prefix) == 0) {
+					GitRefEntry entry;
+					entry.name.assign(name, name_len);
+					entry.has_target = git_oid_fromstrn(&entry.target, pos, GIT_OID_HEXSZ) == 0;
+					entry.is_packed = true;
+					entry.peel_known =
+					    traits.fully_peeled || (traits.peeled && StringUtil::StartsWith(entry.name, "refs/tags/"));
+					out.push_back(std::move(entry));
+					last_included = true;
+				} else if (traits.sorted && CompareName(name, name_len, prefix) > 0) {
+					break; // past the prefix range
+				}
+			}
+		}
+		pos = line_end < end ? line_end + 1 : end;
+	}
+
+	if (!traits.sorted) {
+		std::sort(out.begin() + static_cast<int64_t>(first_new), out.end(),
+		          [](const GitRefEntry &a, const GitRefEntry &b) { return a.name < b.name; });
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Loose refs
+//===--------------------------------------------------------------------===//
+
+static bool ParseLooseRef(const string &name, const string &path, GitRefEntry &entry) {
+	string content;
+	if (!ReadWholeFile(path, content)) {
+		return false;
+	}
+	while (!content.empty() && (content.back() == '\n' || content.back() == '\r' || content.back() == ' ')) {
+		content.pop_back();
+	}
+	entry.name = name;
+	if (StringUtil::StartsWith(content, "ref: ")) {
+		entry.symbolic_target = content.substr(5);
+		return true;
+	}
+	entry.has_target = content.size() >= GIT_OID_HEXSZ && git_oid_fromstrn(&entry.target, content.data(),
+	                                                                        GIT_OID_HEXSZ) == 0;
+	return entry.has_target;
+}
+
+// Recursively collects loose refs below `git_dir/rel_dir` whose names start
+// with `prefix`, skipping subdirectories that cannot contain a match.
+static void ScanLooseRefDir(LocalFileSystem &fs, const string &git_dir, const string &rel_dir, const string &prefix,
+                            vector<GitRefEntry> &out) {
+	vector<std::pair<string, bool>> children;
+	fs.ListFiles(git_dir + rel_dir, [&](const string &child, bool is_dir) { children.emplace_back(child, is_dir); });
+	for (auto &child : children) {
+		string name = rel_dir + child.first;
+		if (child.second) {
+			string dir_name = name + "/";
+			if (StringUtil::StartsWith(dir_name, prefix) || StringUtil::StartsWith(prefix, dir_name)) {
+				ScanLooseRefDir(fs, git_dir, dir_name, prefix, out);
+			}
+		} else if (StringUtil::StartsWith(name, prefix) && !StringUtil::EndsWith(name, ".lock")) {
+			GitRefEntry entry;
+			if (ParseLooseRef(name, git_dir + name, entry)) {
+				out.push_back(std::move(entry));
+			}
+		}
+	}
+}
+
+static void ScanLooseRefs(const string &git_dir, const string &prefix, vector<GitRefEntry> &out) {
+	LocalFileSystem fs;
+	// Start at the deepest directory the prefix names, e.g. "refs/tags/" for "refs/tags/release-".
+	if (StringUtil::StartsWith(prefix, "refs/")) {
+		string start_dir = prefix.substr(0, prefix.rfind('/') + 1);
+		if (fs.DirectoryExists(git_dir + start_dir)) {
+			ScanLooseRefDir(fs, git_dir, start_dir, prefix, out);
+		}
+	} else if (StringUtil::StartsWith("refs/", prefix)) {
+		ScanLooseRefDir(fs, git_dir, "refs/", prefix, out);
+	}
+	if (StringUtil::StartsWith("HEAD", prefix)) {
+		GitRefEntry head;
+		if (ParseLooseRef("HEAD", git_dir + "HEAD", head)) {
+			out.push_back(std::move(head));
+		}
+	}
+}
+
+// Merges sorted `loose` into sorted `refs`; a loose ref replaces its packed copy.
+static void MergeLooseRefs(vector<GitRefEntry> &refs, vector<GitRefEntry> &loose) {
+	std::sort(loose.begin(), loose.end(), [](const GitRefEntry &a, const GitRefEntry &b) { return a.name < b.name; });
+	vector<GitRefEntry> merged;
+	merged.reserve(refs.size() + loose.size());
+	idx_t i = 0, j = 0;
+	while (i < refs.size() || j < loose.size()) {
+		if (j >= loose.size() || (i < refs.size() && refs[i].name < loose[j].name)) {
+			merged.push_back(std::move(refs[i++]));
+		} else {
+			if (i < refs.size() && refs[i].name == loose[j].name) {
+				i++;
+			}
+			merged.push_back(std::move(loose[j++]));
+		}
+	}
+	refs = std::move(merged);
+}
+
+//===--------------------------------------------------------------------===//
+// Collection
+//===--------------------------------------------------------------------===//
+
+static void CollectRefs(git_repository *repo, const string &prefix, vector<GitRefEntry> &refs) {
+	string common_dir = git_repository_commondir(repo);
+	string git_dir = git_repository_path(repo);
+
+	string packed;
+	if (ReadWholeFile(common_dir + "packed-refs", packed)) {
+		ParsePackedRefs(packed, prefix, refs);
+	}
+
+	vector<GitRefEntry> loose;
+	ScanLooseRefs(common_dir, prefix, loose);
+	MergeLooseRefs(refs, loose);
+	if (git_dir != common_dir) {
+		// Linked worktree: its own HEAD and per-worktree refs take precedence.
+		vector<GitRefEntry> worktree_refs;
+		ScanLooseRefs(git_dir, prefix, worktree_refs);
+		MergeLooseRefs(refs, worktree_refs);
+	}
+
+	// Symbolic refs are rare (HEAD, remote HEADs); only index names when there are some.
+	unordered_map<string, idx_t> by_name;
+	bool has_symbolic = std::any_of(refs.begin(), refs.end(),
+	                                [](const GitRefEntry &ref) { return !ref.symbolic_target.empty(); });
+	if (has_symbolic) {
+		for (idx_t i = 0; i < refs.size(); i++) {
+			by_name.emplace(refs[i].name, i);
+		}
+	}
+
+	for (auto &ref : refs) {
+		if (!ref.symbolic_target.empty()) {
+			// Follow the chain within the scanned refs, then fall back to libgit2.
+			string target = ref.symbolic_target;
+			for (idx_t depth = 0; depth < MAX_SYMREF_DEPTH && !ref.has_target; depth++) {
+				auto it = by_name.find(target);
+				if (it == by_name.end()) {
+					ref.has_target = git_reference_name_to_id(&ref.target, repo, target.c_str()) == 0;
+					break;
+				}
+				const auto &next = refs[it->second];
+				if (next.symbolic_target.empty()) {
+					ref.target = next.target;
+					ref.has_target = next.has_target;
+					break;
+				}
+				target = next.symbolic_target;
+			}
+		}
+		if (!ref.has_target || ref.has_peeled) {
+			continue;
+		}
+		// Only tags are expected to point at tag objects; everything else peels to itself.
+		if (ref.peel_known || !StringUtil::StartsWith(ref.name, "refs/tags/")) {
+			ref.peeled = ref.target;
+			ref.has_peeled = true;
+		} else {
+			ref.has_peeled = PeelTagTarget(repo, ref.target, ref.peeled);
+		}
+	}
+}
+
+static const char *RefKindOf(const string &name, idx_t &short_start) {
+	static const std::pair<const char *, const char *> KINDS[] = {
+	    {"refs/heads/", "branch"}, {"refs/remotes/", "remote"}, {"refs/tags/", "tag"}, {"refs/notes/", "note"}};
+	for (auto &kind : KINDS) {
+		if (StringUtil::StartsWith(name, kind.first)) {
+			short_start = strlen(kind.first);
+			return kind.second;
+		}
+	}
+	short_start = 0;
+	return name == "HEAD" ? "head" : "other";
+}
+
+//===--------------------------------------------------------------------===//
+// Filter pushdown
+//===--------------------------------------------------------------------===//
+
+// Literal prefix of a LIKE pattern (up to the first wildcard).
+static string LikeLiteralPrefix(const string &pattern) {
+	size_t wildcard = pattern.find_first_of("%_");
+	return wildcard == string::npos ? pattern : pattern.substr(0, wildcard);
+}
+
+// Narrows the scan prefix with ref_name predicates. The filters stay in the
+// plan, so this only has to produce a superset of the matching refs.
+static void GitRefsPushdownFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                  vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<GitRefsFunctionData>();
+	auto &column_ids = get.GetColumnIds();
+
+	auto is_ref_name = [&](const Expression &expr) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return false;
+		}
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		idx_t index = colref.binding.column_index;
+		return index < column_ids.size() && column_ids[index].GetPrimaryIndex() == REF_NAME_COLUMN;
+	};
+	auto constant_string = [](const Expression &expr, string &out) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &value = expr.Cast<BoundConstantExpression>().value;
+		if (value.IsNull() || value.type().id() != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		out = StringValue::Get(value);
+		return true;
+	};
+
+	for (auto &filter : filters) {
+		string candidate;
+		bool found = false;
+		if (filter->GetExpressionClass() == ExpressionClass::BOUND_FUNCTION) {
+			auto &func = filter->Cast<BoundFunctionExpression>();
+			auto &name = func.function.name;
+			if (func.children.size() == 2 && is_ref_name(*func.children[0]) &&
+			    constant_string(*func.children[1], candidate)) {
+				if (name == "prefix" || name == "starts_with") {
+					found = true;
+				} else if (name == "~~") {
+					candidate = LikeLiteralPrefix(candidate);
+					found = true;
+				}
+			}
+		} else if (filter->GetExpressionType() == ExpressionType::COMPARE_EQUAL) {
+			auto &comparison = filter->Cast<BoundComparisonExpression>();
+			found = (is_ref_name(*comparison.left) && constant_string(*comparison.right, candidate)) ||
+			        (is_ref_name(*comparison.right) && constant_string(*comparison.left, candidate));
+		}
+		if (!found) {
+			continue;
+		}
+		if (StringUtil::StartsWith(candidate, bind_data.prefix)) {
+			bind_data.prefix = candidate;
+		} else if (!StringUtil::StartsWith(bind_data.prefix, candidate)) {
+			bind_data.no_match = true;
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Bind / Init / Function
+//===--------------------------------------------------------------------===//
+
+static unique_ptr<FunctionData> GitRefsBind(ClientContext &context, TableFunctionBindInput &input,
+                                            vector<LogicalType> &return_types, vector<string> &names) {
+	return_types = {
+	    LogicalType::VARCHAR, // repo_path
+	    LogicalType::VARCHAR, // ref_name
+	    LogicalType::VARCHAR, // short_name
+	    LogicalType::VARCHAR, // kind
+	    LogicalType::VARCHAR, // target_hash
+	    LogicalType::VARCHAR, // peeled_hash
+	    LogicalType::VARCHAR, // symbolic_target
+	    LogicalType::BOOLEAN  // is_packed
+	};
+	names = {"repo_path",   "ref_name",    "short_name",      "kind",
+	         "target_hash", "peeled_hash", "symbolic_target", "is_packed"};
+
+	auto bind_data = make_uniq<GitRefsFunctionData>();
+	string first_param = input.inputs.empty() ? "." : input.inputs[0].GetValue<string>();
+	try {
+		auto git_path = GitPath::Parse("git://" + first_param + "@HEAD");
+		bind_data->repo_path = git_path.repository_path;
+	} catch (const std::exception &e) {
+		throw BinderException("git_refs: failed to resolve repository path '%s': %s", first_param, e.what());
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "prefix") {
+			bind_data->prefix = kv.second.GetValue<string>();
+		}
+	}
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> GitRefsInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<GitRefsFunctionData>();
+	auto state = make_uniq<GitRefsGlobalState>();
+	if (bind_data.no_match) {
+		return std::move(state);
+	}
+
+	git_repository *repo = nullptr;
+	if (git_repository_open(&repo, bind_data.repo_path.c_str()) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_refs: failed to open repository '%s': %s", bind_data.repo_path,
+		                  e ? e->message : "unknown error");
+	}
+	try {
+		CollectRefs(repo, bind_data.prefix, state->refs);
+	} catch (...) {
+		git_repository_free(repo);
+		throw;
+	}
+	git_repository_free(repo);
+	return std::move(state);
+}
+
+static void GitRefsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<GitRefsFunctionData>();
+	auto &state = data_p.global_state->Cast<GitRefsGlobalState>();
+
+	idx_t count = 0;
+	auto repo_path_data = FlatVector::GetData<string_t>(output.data[0]);
+	auto name_data = FlatVector::GetData<string_t>(output.data[1]);
+	auto short_data = FlatVector::GetData<string_t>(output.data[2]);
+	auto kind_data = FlatVector::GetData<string_t>(output.data[3]);
+	auto symbolic_data = FlatVector::GetData<string_t>(output.data[6]);
+	auto packed_data = FlatVector::GetData<bool>(output.data[7]);
+
+	while (count < STANDARD_VECTOR_SIZE && state.offset < state.refs.size()) {
+		const auto &ref = state.refs[state.offset++];
+		idx_t short_start;
+		const char *kind = RefKindOf(ref.name, short_start);
+
+		repo_path_data[count] = StringVector::AddString(output.data[0], bind_data.repo_path);
+		name_data[count] = StringVector::AddString(output.data[1], ref.name);
+		short_data[count] =
+		    StringVector::AddString(output.data[2], ref.name.data() + short_start, ref.name.size() - short_start);
+		kind_data[count] = StringVector::AddString(output.data[3], kind);
+		SetGitOid(output.data[4], count, ref.has_target ? &ref.target : nullptr);
+		SetGitOid(output.data[5], count, ref.has_peeled ? &ref.peeled : nullptr);
+		if (!ref.symbolic_target.empty()) {
+			symbolic_data[count] = StringVector::AddString(output.data[6], ref.symbolic_target);
+		} else {
+			FlatVector::SetNull(output.data[6], count, true);
+		}
+		packed_data[count] = ref.is_packed;
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterGitRefsFunction(ExtensionLoader &loader) {
+	TableFunctionSet git_refs_set("git_refs");
+
+	// git_refs()
+	TableFunction zero({}, GitRefsFunction, GitRefsBind, GitRefsInitGlobal);
+	zero.named_parameters["prefix"] = LogicalType::VARCHAR;
+	zero.pushdown_complex_filter = GitRefsPushdownFilter;
+	git_refs_set.AddFunction(zero);
+
+	// git_refs(repo_path)
+	TableFunction one({LogicalType::VARCHAR}, GitRefsFunction, GitRefsBind, GitRefsInitGlobal);
+	one.named_parameters["prefix"] = LogicalType::VARCHAR;
+	one.pushdown_complex_filter = GitRefsPushdownFilter;
+	git_refs_set.AddFunction(one);
+
+	loader.RegisterFunction(git_refs_set);
+}
+
+} // namespace duckdb
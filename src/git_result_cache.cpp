@@ -0,0 +1,380 @@
+#include "git_result_cache.hpp"
+#include "diff_cache.hpp"
+#include "text_utils.hpp"
+
+#include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/serializer/binary_deserializer.hpp"
+#include "duckdb/common/serializer/binary_serializer.hpp"
+#include "duckdb/common/serializer/memory_stream.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static constexpr const char *RESULT_CACHE_SETTING = "duck_tails_result_cache_size";
+static constexpr const char *CACHE_PATH_SETTING = "duck_tails_cache_path";
+static constexpr const char *CACHE_PATH_SIZE_SETTING = "duck_tails_cache_path_size";
+static constexpr const char *DEFAULT_CACHE_PATH_SIZE = "1GB";
+
+// Cache files: magic, format version, key length and key (checked on read,
+// so a file name collision is a miss), then the collection in DuckDB's binary
+// serialization. Keys carry the output column types, and files of another
+// version or with other column types are deleted when read; bump the version
+// whenever a cached function changes what it returns for the same types.
+static constexpr const char DISK_ENTRY_MAGIC[4] = {'D', 'T', 'R', 'C'};
+static constexpr uint32_t DISK_ENTRY_VERSION = 2;
+static constexpr const char *DISK_ENTRY_EXTENSION = ".dtrc";
+
+GitResultCache &GitResultCache::Instance() {
+	static GitResultCache instance;
+	return instance;
+}
+
+optional_ptr<GitResultCache> GitResultCache::Get(ClientContext &context) {
+	auto &cache = Instance();
+	if (!cache.IsEnabled()) {
+		return nullptr;
+	}
+	return &cache;
+}
+
+// The settings below configure the one cache shared by every connection, so
+// they follow the last SET from any of them (as duck_tails_diff_cache_size)
+static void SetResultCacheSize(ClientContext &context, SetScope scope, Value &parameter) {
+	GitResultCache::Instance().SetCapacity(ParseCacheSize(parameter));
+}
+
+static void SetCachePath(ClientContext &context, SetScope scope, Value &parameter) {
+	auto path = parameter.IsNull() ? string() : parameter.ToString();
+	if (!path.empty() && !DBConfig::GetConfig(context).options.enable_external_access) {
+		throw PermissionException("%s is disabled through configuration", CACHE_PATH_SETTING);
+	}
+	GitResultCache::Instance().SetDiskPath(path);
+}
+
+static void SetCachePathSize(ClientContext &context, SetScope scope, Value &parameter) {
+	GitResultCache::Instance().SetDiskCapacity(ParseCacheSize(parameter));
+}
+
+shared_ptr<const ColumnDataCollection> GitResultCache::Lookup(const string &key,
+                                                              const vector<LogicalType> &types) {
+	string path;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto entry = entries.find(key);
+		if (entry != entries.end()) {
+			lru.splice(lru.begin(), lru, entry->second);
+			return entry->second->result;
+		}
+		path = disk_path;
+	}
+	if (path.empty()) {
+		return nullptr;
+	}
+	auto result = ReadDiskEntry(path, key, types);
+	if (result) {
+		InsertInMemory(key, result);
+	}
+	return result;
+}
+
+void GitResultCache::Insert(const string &key, shared_ptr<const ColumnDataCollection> result) {
+	string path;
+	idx_t disk_budget;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		path = disk_path;
+		disk_budget = disk_capacity;
+	}
+	if (!path.empty()) {
+		WriteDiskEntry(path, disk_budget, key, *result);
+	}
+	InsertInMemory(key, std::move(result));
+}
+
+void GitResultCache::InsertInMemory(const string &key, shared_ptr<const ColumnDataCollection> result) {
+	auto result_size = result->SizeInBytes() + key.size() + sizeof(Entry);
+	std::lock_guard<std::mutex> guard(lock);
+	if (result_size > capacity || entries.find(key) != entries.end()) {
+		return;
+	}
+	lru.push_front(Entry {key, std::move(result), result_size});
+	entries[key] = lru.begin();
+	size += result_size;
+	EvictToCapacity();
+}
+
+void GitResultCache::SetCapacity(idx_t bytes) {
+	std::lock_guard<std::mutex> guard(lock);
+	capacity = bytes;
+	EvictToCapacity();
+}
+
+void GitResultCache::SetDiskPath(const string &path) {
+	std::lock_guard<std::mutex> guard(lock);
+	if (path != disk_path) {
+		disk_size = DConstants::INVALID_INDEX;
+	}
+	disk_path = path;
+}
+
+void GitResultCache::SetDiskCapacity(idx_t bytes) {
+	std::lock_guard<std::mutex> guard(lock);
+	disk_capacity = bytes;
+}
+
+bool GitResultCache::IsEnabled() {
+	std::lock_guard<std::mutex> guard(lock);
+	return capacity > 0 || !disk_path.empty();
+}
+
+idx_t GitResultCache::RecordLimit() {
+	std::lock_guard<std::mutex> guard(lock);
+	return disk_path.empty() ? capacity : MaxValue(capacity, disk_capacity);
+}
+
+void GitResultCache::EvictToCapacity() {
+	while (size > capacity) {
+		auto &oldest = lru.back();
+		size -= oldest.size;
+		entries.erase(oldest.key);
+		lru.pop_back();
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Cache directory
+//
+// Files are written to a temporary name and renamed into place, so readers
+// in this or other processes never see a partial file. Failures to read or
+// write the directory turn into misses: the cache never fails a query.
+//===--------------------------------------------------------------------===//
+
+static string DiskEntryPath(LocalFileSystem &fs, const string &path, const string &key) {
+	auto hash = HashContent(key.data(), key.size());
+	return fs.JoinPath(path, StringUtil::Format("%016llx%016llx%s", (unsigned long long)hash.high,
+	                                            (unsigned long long)hash.low, DISK_ENTRY_EXTENSION));
+}
+
+shared_ptr<const ColumnDataCollection> GitResultCache::ReadDiskEntry(const string &path, const string &key,
+                                                                     const vector<LogicalType> &types) {
+	try {
+		LocalFileSystem fs;
+		auto file_path = DiskEntryPath(fs, path, key);
+		auto handle =
+		    fs.OpenFile(file_path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!handle) {
+			return nullptr;
+		}
+		auto file_size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+		auto buffer = make_unsafe_uniq_array<data_t>(file_size);
+		fs.Read(*handle, buffer.get(), NumericCast<int64_t>(file_size), 0);
+
+		MemoryStream stream(buffer.get(), file_size);
+		char magic[sizeof(DISK_ENTRY_MAGIC)];
+		stream.ReadData(data_ptr_cast(magic), sizeof(magic));
+		if (memcmp(magic, DISK_ENTRY_MAGIC, sizeof(magic)) != 0) {
+			return nullptr;
+		}
+		if (stream.Read<uint32_t>() != DISK_ENTRY_VERSION) {
+			// Written by another version of the extension
+			handle.reset();
+			fs.TryRemoveFile(file_path);
+			return nullptr;
+		}
+		if (stream.Read<uint32_t>() != key.size()) {
+			return nullptr;
+		}
+		string file_key(key.size(), '\0');
+		stream.ReadData(data_ptr_cast(&file_key[0]), file_key.size());
+		if (file_key != key) {
+			return nullptr;
+		}
+
+		BinaryDeserializer deserializer(stream);
+		deserializer.Begin();
+		auto result = ColumnDataCollection::Deserialize(deserializer);
+		deserializer.End();
+		if (result->Types() != types) {
+			handle.reset();
+			fs.TryRemoveFile(file_path);
+			return nullptr;
+		}
+		return shared_ptr<const ColumnDataCollection>(std::move(result));
+	} catch (const std::exception &) {
+		return nullptr;
+	}
+}
+
+void GitResultCache::WriteDiskEntry(const string &path, idx_t disk_budget, const string &key,
+                                    const ColumnDataCollection &result) {
+	try {
+		MemoryStream stream;
+		stream.WriteData(const_data_ptr_cast(DISK_ENTRY_MAGIC), sizeof(DISK_ENTRY_MAGIC));
+		stream.Write<uint32_t>(DISK_ENTRY_VERSION);
+		stream.Write<uint32_t>(NumericCast<uint32_t>(key.size()));
+		stream.WriteData(const_data_ptr_cast(key.data()), key.size());
+		BinarySerializer serializer(stream);
+		serializer.Begin();
+		result.Serialize(serializer);
+		serializer.End();
+		if (stream.GetPosition() > disk_budget) {
+			return;
+		}
+
+		LocalFileSystem fs;
+		if (!fs.DirectoryExists(path)) {
+			fs.CreateDirectory(path);
+		}
+		auto file_path = DiskEntryPath(fs, path, key);
+		if (fs.FileExists(file_path)) {
+			return;
+		}
+		auto temp_path = file_path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+		{
+			auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+			fs.Write(*handle, stream.GetData(), NumericCast<int64_t>(stream.GetPosition()), 0);
+			handle->Sync();
+		}
+		fs.MoveFile(temp_path, file_path);
+
+		bool over_budget;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (disk_size != DConstants::INVALID_INDEX) {
+				disk_size += stream.GetPosition();
+			}
+			over_budget = disk_size == DConstants::INVALID_INDEX || disk_size > disk_budget;
+		}
+		if (over_budget) {
+			EvictDiskEntries(path, disk_budget);
+		}
+	} catch (const std::exception &) {
+		// Leave the result uncached on disk
+	}
+}
+
+// Lists the directory (other processes may have written to it as well) and
+// removes the oldest files until it fits `disk_budget`.
+void GitResultCache::EvictDiskEntries(const string &path, idx_t disk_budget) {
+	struct DiskEntry {
+		string file_path;
+		timestamp_t modified;
+		idx_t size;
+	};
+	LocalFileSystem fs;
+	vector<DiskEntry> files;
+	idx_t total = 0;
+	fs.ListFiles(path, [&](const string &name, bool is_dir) {
+		if (is_dir || !StringUtil::EndsWith(name, DISK_ENTRY_EXTENSION)) {
+			return;
+		}
+		auto file_path = fs.JoinPath(path, name);
+		auto handle = fs.OpenFile(file_path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!handle) {
+			return;
+		}
+		auto file_size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+		files.push_back(DiskEntry {file_path, fs.GetLastModifiedTime(*handle), file_size});
+		total += file_size;
+	});
+	std::sort(files.begin(), files.end(),
+	          [](const DiskEntry &a, const DiskEntry &b) { return a.modified < b.modified; });
+	for (auto &file : files) {
+		if (total <= disk_budget) {
+			break;
+		}
+		fs.TryRemoveFile(file.file_path);
+		total -= file.size;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	if (path == disk_path) {
+		disk_size = total;
+	}
+}
+
+string GitResultCacheKey(const string &function_name, const vector<LogicalType> &types,
+                         const vector<string> &parts) {
+	string key = function_name;
+	for (auto &type : types) {
+		key += '\0';
+		key += type.ToString();
+	}
+	key += '\0';
+	for (auto &part : parts) {
+		key += '\0';
+		key += part;
+	}
+	return key;
+}
+
+//===--------------------------------------------------------------------===//
+// GitResultCacheScan
+//===--------------------------------------------------------------------===//
+
+bool GitResultCacheScan::Begin(optional_ptr<GitResultCache> cache_p, string key_p,
+                               const vector<LogicalType> &types) {
+	auto hit = cache_p ? cache_p->Lookup(key_p, types) : nullptr;
+	Initialize(cache_p, std::move(key_p), std::move(hit));
+	return IsHit();
+}
+
+void GitResultCacheScan::Initialize(optional_ptr<GitResultCache> cache_p, string key_p,
+                                    shared_ptr<const ColumnDataCollection> hit) {
+	cache = cache_p;
+	key = std::move(key_p);
+	cached = std::move(hit);
+	if (cached) {
+		// Cached collections are never appended to again, so any number of
+		// scans can read one concurrently
+		cached->InitializeScan(scan_state);
+	}
+}
+
+void GitResultCacheScan::Replay(DataChunk &output) {
+	if (!cached->Scan(scan_state, output)) {
+		output.SetCardinality(0);
+	}
+}
+
+void GitResultCacheScan::Record(DataChunk &output) {
+	if (!cache || cached) {
+		return;
+	}
+	if (!recording) {
+		// Default allocator rather than a buffer manager: a cached result can
+		// outlive the database that produced it
+		recording = make_shared_ptr<ColumnDataCollection>(Allocator::DefaultAllocator(), output.GetTypes());
+	}
+	if (output.size() == 0) {
+		cache->Insert(key, std::move(recording));
+		cache = nullptr;
+		return;
+	}
+	recording->Append(output);
+	if (recording->SizeInBytes() > cache->RecordLimit()) {
+		// Would fit neither budget; stop copying
+		recording.reset();
+		cache = nullptr;
+	}
+}
+
+void RegisterGitResultCacheSettings(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(RESULT_CACHE_SETTING,
+	                          "Memory budget of the process-wide cache of git_tree/git_blame/git_diff_tree/"
+	                          "git_parents results for resolved commits (0 disables it)",
+	                          LogicalType::VARCHAR, Value("0"), SetResultCacheSize);
+	config.AddExtensionOption(CACHE_PATH_SETTING,
+	                          "Directory that persists cached git_tree/git_blame/git_diff_tree/git_parents results "
+	                          "across processes (empty disables it)",
+	                          LogicalType::VARCHAR, Value(""), SetCachePath);
+	config.AddExtensionOption(CACHE_PATH_SIZE_SETTING, "Size limit of duck_tails_cache_path; oldest files go first",
+	                          LogicalType::VARCHAR, Value(DEFAULT_CACHE_PATH_SIZE), SetCachePathSize);
+}
+
+} // namespace duckdb
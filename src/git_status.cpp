@@ -4,39 +4,45 @@
 #include "git_path.hpp"
 #include "git_context_manager.hpp"
 #include "git_utils.hpp"
+#include "git_repo_pool.hpp"
+#include "git_ref_watcher.hpp"
+#include "git_status_engine.hpp"
+#include "worktree_hash.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include <git2.h>
+#include <atomic>
+#include <mutex>
 
 namespace duckdb {
 
 //===--------------------------------------------------------------------===//
-// GitStatusRow
+// Bind Data
 //===--------------------------------------------------------------------===//
 
-struct GitStatusRow {
-	string repo_path;
-	string file_path;
-	string file_ext;
-	string status;         // "modified", "added", "deleted", "renamed", "untracked", "ignored", "conflicted"
-	uint32_t status_flags; // raw git_status_t bitmask
-	bool staged;           // has index changes
-	bool unstaged;         // has workdir changes
-	string old_path;       // rename/copy source (empty otherwise)
+// Status engine selected by the `engine` named parameter.
+enum class GitStatusEngine : uint8_t {
+	LIBGIT2,  // git_status_list_new (default)
+	PARALLEL, // git_status_engine.cpp: parallel stat, untracked cache, fsmonitor
 };
 
-//===--------------------------------------------------------------------===//
-// Bind Data
-//===--------------------------------------------------------------------===//
-
 struct GitStatusFunctionData : public TableFunctionData {
 	string repo_path;
 	bool include_untracked;
 	bool include_ignored;
 	string path_filter;
+	GitStatusEngine engine = GitStatusEngine::LIBGIT2;
+	string fsmonitor_hook;
+	idx_t max_threads = 1;
+	bool fast_hash = false;
+	bool watch_refs = false;
+	bool ordered = false; // git_status_each: emit repositories in input order
 	vector<GitStatusRow> rows;
 	bool is_lateral;
 
@@ -51,14 +57,27 @@ struct GitStatusFunctionData : public TableFunctionData {
 // Local State
 //===--------------------------------------------------------------------===//
 
+// Statuses for the repositories of one git_status_each input chunk, computed
+// on DuckDB's scheduler threads before the operator emits them.
+struct GitStatusEachBatch {
+	struct Slot {
+		string repo_path;
+		vector<GitStatusRow> rows;
+	};
+
+	vector<Slot> slots;
+	vector<idx_t> completed; // slot indexes in completion order
+
+	// Emission cursor
+	idx_t emitted = 0;
+	idx_t output_row = 0;
+};
+
 struct GitStatusLocalState : public LocalTableFunctionState {
 	idx_t current_index = 0;
 
 	// LATERAL processing state
-	vector<GitStatusRow> current_rows;
-	idx_t current_input_row = 0;
-	idx_t current_output_row = 0;
-	bool initialized_row = false;
+	unique_ptr<GitStatusEachBatch> batch;
 };
 
 //===--------------------------------------------------------------------===//
@@ -115,8 +134,20 @@ static string StatusFlagsToString(unsigned int flags) {
 	return "unknown";
 }
 
-static void CollectStatusRows(git_repository *repo, const string &repo_path, bool include_untracked,
-                              bool include_ignored, const string &path_filter, vector<GitStatusRow> &rows) {
+// Derives status/staged/unstaged/file_ext from status_flags and file_path.
+static void FinishStatusRow(GitStatusRow &row) {
+	row.status = StatusFlagsToString(row.status_flags);
+	// Use status flags to determine staged/unstaged (not pointer presence)
+	// This avoids marking untracked files as "unstaged"
+	row.staged = (row.status_flags & (GIT_STATUS_INDEX_NEW | GIT_STATUS_INDEX_MODIFIED | GIT_STATUS_INDEX_DELETED |
+	                                  GIT_STATUS_INDEX_RENAMED | GIT_STATUS_INDEX_TYPECHANGE)) != 0;
+	row.unstaged = (row.status_flags & (GIT_STATUS_WT_MODIFIED | GIT_STATUS_WT_DELETED | GIT_STATUS_WT_TYPECHANGE |
+	                                    GIT_STATUS_WT_RENAMED)) != 0;
+	row.file_ext = ExtractFileExtension(row.file_path);
+}
+
+static void CollectStatusRowsLibgit2(git_repository *repo, const string &repo_path, bool include_untracked,
+                                     bool include_ignored, const string &path_filter, vector<GitStatusRow> &rows) {
 	git_status_options opts = GIT_STATUS_OPTIONS_INIT;
 	opts.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
 	opts.flags = GIT_STATUS_OPT_RENAMES_HEAD_TO_INDEX | GIT_STATUS_OPT_RENAMES_INDEX_TO_WORKDIR |
@@ -155,14 +186,6 @@ static void CollectStatusRows(git_repository *repo, const string &repo_path, boo
 		GitStatusRow row;
 		row.repo_path = repo_path;
 		row.status_flags = entry->status;
-		row.status = StatusFlagsToString(entry->status);
-
-		// Use status flags to determine staged/unstaged (not pointer presence)
-		// This avoids marking untracked files as "unstaged"
-		row.staged = (entry->status & (GIT_STATUS_INDEX_NEW | GIT_STATUS_INDEX_MODIFIED | GIT_STATUS_INDEX_DELETED |
-		                               GIT_STATUS_INDEX_RENAMED | GIT_STATUS_INDEX_TYPECHANGE)) != 0;
-		row.unstaged = (entry->status & (GIT_STATUS_WT_MODIFIED | GIT_STATUS_WT_DELETED | GIT_STATUS_WT_TYPECHANGE |
-		                                 GIT_STATUS_WT_RENAMED)) != 0;
 
 		if (entry->head_to_index) {
 			row.file_path = entry->head_to_index->new_file.path ? entry->head_to_index->new_file.path : "";
@@ -181,13 +204,70 @@ static void CollectStatusRows(git_repository *repo, const string &repo_path, boo
 			}
 		}
 
-		row.file_ext = ExtractFileExtension(row.file_path);
+		FinishStatusRow(row);
 		rows.push_back(std::move(row));
 	}
 
 	git_status_list_free(status_list);
 }
 
+static void CollectStatusRows(ClientContext &context, git_repository *repo, const string &repo_path,
+                              const GitStatusFunctionData &bind_data, idx_t max_threads, vector<GitStatusRow> &rows) {
+	if (bind_data.engine == GitStatusEngine::LIBGIT2) {
+		CollectStatusRowsLibgit2(repo, repo_path, bind_data.include_untracked, bind_data.include_ignored,
+		                         bind_data.path_filter, rows);
+		return;
+	}
+
+	GitStatusEngineOptions opts;
+	opts.include_untracked = bind_data.include_untracked;
+	opts.include_ignored = bind_data.include_ignored;
+	opts.path_filter = bind_data.path_filter;
+	opts.fsmonitor_hook = bind_data.fsmonitor_hook;
+	opts.max_threads = max_threads;
+	opts.fast_hash = bind_data.fast_hash;
+	opts.watch_refs = bind_data.watch_refs;
+	idx_t first = rows.size();
+	CollectStatusRowsParallel(context, repo, repo_path, opts, rows);
+	for (idx_t i = first; i < rows.size(); i++) {
+		FinishStatusRow(rows[i]);
+	}
+}
+
+// Applies the engine and scheduling named parameters; other names are ignored.
+static void ApplyStatusEngineParam(const string &name, const Value &value, GitStatusFunctionData &bind_data,
+                                   const char *func_name) {
+	if (name == "engine") {
+		auto engine = StringUtil::Lower(value.GetValue<string>());
+		if (engine == "libgit2") {
+			bind_data.engine = GitStatusEngine::LIBGIT2;
+		} else if (engine == "parallel") {
+			bind_data.engine = GitStatusEngine::PARALLEL;
+		} else {
+			throw BinderException("%s: engine must be 'libgit2' or 'parallel' (got '%s')", func_name, engine);
+		}
+	} else if (name == "fsmonitor") {
+		bind_data.fsmonitor_hook = value.GetValue<string>();
+	} else if (name == "ordered") {
+		bind_data.ordered = value.GetValue<bool>();
+	}
+}
+
+// fsmonitor only exists in the parallel engine, so asking for it selects it.
+// Running the hook starts a process, which enable_external_access forbids.
+static void FinishStatusBind(ClientContext &context, GitStatusFunctionData &bind_data) {
+	if (!bind_data.fsmonitor_hook.empty()) {
+		if (!DBConfig::GetConfig(context).options.enable_external_access) {
+			throw PermissionException("git_status: fsmonitor hooks are disabled because enable_external_access is "
+			                          "false");
+		}
+		bind_data.engine = GitStatusEngine::PARALLEL;
+	}
+	bind_data.max_threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	bind_data.fast_hash = FastHashEnabled(context);
+	bind_data.watch_refs = RefWatcherEnabled(context);
+}
+
 //===--------------------------------------------------------------------===//
 // Schema
 //===--------------------------------------------------------------------===//
@@ -281,7 +361,12 @@ static unique_ptr<FunctionData> GitStatusBind(ClientContext &context, TableFunct
 		}
 	}
 
-	return make_uniq<GitStatusFunctionData>(repo_path, include_untracked, include_ignored, path_filter);
+	auto bind_data = make_uniq<GitStatusFunctionData>(repo_path, include_untracked, include_ignored, path_filter);
+	for (const auto &kv : input.named_parameters) {
+		ApplyStatusEngineParam(kv.first, kv.second, *bind_data, "git_status");
+	}
+	FinishStatusBind(context, *bind_data);
+	return std::move(bind_data);
 }
 
 //===--------------------------------------------------------------------===//
@@ -301,8 +386,7 @@ static unique_ptr<GlobalTableFunctionState> GitStatusInitGlobal(ClientContext &c
 		}
 
 		try {
-			CollectStatusRows(repo, bind_data.repo_path, bind_data.include_untracked, bind_data.include_ignored,
-			                  bind_data.path_filter, bind_data.rows);
+			CollectStatusRows(context, repo, bind_data.repo_path, bind_data, bind_data.max_threads, bind_data.rows);
 		} catch (...) {
 			git_repository_free(repo);
 			throw;
@@ -367,90 +451,121 @@ static unique_ptr<FunctionData> GitStatusEachBind(ClientContext &context, TableF
 		}
 	}
 
-	return make_uniq<GitStatusFunctionData>(".", include_untracked, include_ignored, path_filter, true);
+	auto bind_data = make_uniq<GitStatusFunctionData>(".", include_untracked, include_ignored, path_filter, true);
+	for (const auto &kv : input.named_parameters) {
+		ApplyStatusEngineParam(kv.first, kv.second, *bind_data, "git_status_each");
+	}
+	FinishStatusBind(context, *bind_data);
+	return std::move(bind_data);
 }
 
-static OperatorResultType GitStatusEachFunction(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
-                                                DataChunk &output) {
-	auto &state = data_p.local_state->Cast<GitStatusLocalState>();
-	auto &bind_data = data_p.bind_data->Cast<GitStatusFunctionData>();
-
-	while (true) {
-		if (!state.initialized_row) {
-			if (state.current_input_row >= input.size()) {
-				state.current_input_row = 0;
-				state.initialized_row = false;
-				return OperatorResultType::NEED_MORE_INPUT;
-			}
-
-			input.Flatten();
-
-			if (input.ColumnCount() == 0 || FlatVector::IsNull(input.data[0], state.current_input_row)) {
-				state.current_input_row++;
-				continue;
-			}
+// Status of one repository; failures yield no rows, as for unreadable inputs.
+static void CollectEachSlot(ClientContext &context, const GitStatusFunctionData &bind_data, idx_t engine_threads,
+                            GitStatusEachBatch::Slot &slot) {
+	ScopedGitRepo repo(slot.repo_path);
+	if (!repo.is_valid()) {
+		return;
+	}
+	try {
+		CollectStatusRows(context, repo, slot.repo_path, bind_data, engine_threads, slot.rows);
+	} catch (...) {
+		slot.rows.clear();
+	}
+}
 
-			auto data = FlatVector::GetData<string_t>(input.data[0]);
-			string repo_path_or_uri(data[state.current_input_row].GetData(), data[state.current_input_row].GetSize());
+// Resolves the repositories of an input chunk and computes their statuses.
+// A single repository is computed inline with the engine's own threads;
+// otherwise up to max_threads workers on DuckDB's scheduler each take whole
+// repositories, running the status engine single-threaded, so the query's
+// thread budget bounds the total.
+static unique_ptr<GitStatusEachBatch> CollectEachBatch(ClientContext &context, const GitStatusFunctionData &bind_data,
+                                                       DataChunk &input) {
+	auto batch = make_uniq<GitStatusEachBatch>();
+	input.Flatten();
+	if (input.ColumnCount() == 0) {
+		return batch;
+	}
+	auto data = FlatVector::GetData<string_t>(input.data[0]);
+	for (idx_t row = 0; row < input.size(); row++) {
+		if (FlatVector::IsNull(input.data[0], row)) {
+			continue;
+		}
+		string repo_path_or_uri = data[row].GetString();
+		if (repo_path_or_uri.empty()) {
+			continue;
+		}
+		try {
+			auto git_path = GitPath::Parse("git://" + repo_path_or_uri + "@HEAD");
+			GitStatusEachBatch::Slot slot;
+			slot.repo_path = git_path.repository_path;
+			batch->slots.push_back(std::move(slot));
+		} catch (...) {
+			continue;
+		}
+	}
 
-			if (repo_path_or_uri.empty()) {
-				state.current_input_row++;
-				continue;
-			}
+	idx_t num_workers = MinValue<idx_t>(bind_data.max_threads, batch->slots.size());
+	if (num_workers <= 1) {
+		for (idx_t i = 0; i < batch->slots.size(); i++) {
+			CollectEachSlot(context, bind_data, bind_data.max_threads, batch->slots[i]);
+			batch->completed.push_back(i);
+		}
+		return batch;
+	}
 
-			// Resolve repo path
-			string resolved_repo_path;
-			try {
-				auto git_path = GitPath::Parse("git://" + repo_path_or_uri + "@HEAD");
-				resolved_repo_path = git_path.repository_path;
-			} catch (...) {
-				state.current_input_row++;
-				continue;
+	std::atomic<idx_t> next_slot(0);
+	std::mutex completed_lock;
+	RunParallelWorkers(context, num_workers, [&](idx_t worker) {
+		while (true) {
+			idx_t i = next_slot.fetch_add(1);
+			if (i >= batch->slots.size()) {
+				break;
 			}
+			CollectEachSlot(context, bind_data, 1, batch->slots[i]);
+			std::lock_guard<std::mutex> guard(completed_lock);
+			batch->completed.push_back(i);
+		}
+	});
+	return batch;
+}
 
-			state.current_rows.clear();
-
-			git_repository *repo = nullptr;
-			int error = git_repository_open(&repo, resolved_repo_path.c_str());
-			if (error != 0) {
-				state.current_input_row++;
-				continue;
-			}
+// The next slot to emit: the next in input order when `ordered`, otherwise
+// the next to complete.
+static GitStatusEachBatch::Slot &NextEachSlot(GitStatusEachBatch &batch, bool ordered) {
+	return batch.slots[ordered ? batch.emitted : batch.completed[batch.emitted]];
+}
 
-			try {
-				CollectStatusRows(repo, resolved_repo_path, bind_data.include_untracked, bind_data.include_ignored,
-				                  bind_data.path_filter, state.current_rows);
-			} catch (...) {
-				git_repository_free(repo);
-				state.current_input_row++;
-				continue;
-			}
+static OperatorResultType GitStatusEachFunction(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+                                                DataChunk &output) {
+	auto &state = data_p.local_state->Cast<GitStatusLocalState>();
+	auto &bind_data = data_p.bind_data->Cast<GitStatusFunctionData>();
 
-			git_repository_free(repo);
-			state.initialized_row = true;
-			state.current_output_row = 0;
-		}
+	if (!state.batch) {
+		state.batch = CollectEachBatch(context.client, bind_data, input);
+	}
+	auto &batch = *state.batch;
 
-		// Output rows
-		idx_t output_count = 0;
-		while (output_count < STANDARD_VECTOR_SIZE && state.current_output_row < state.current_rows.size()) {
-			OutputGitStatusRow(output, state.current_rows[state.current_output_row], output_count);
+	idx_t output_count = 0;
+	while (output_count < STANDARD_VECTOR_SIZE && batch.emitted < batch.slots.size()) {
+		auto &slot = NextEachSlot(batch, bind_data.ordered);
+		while (output_count < STANDARD_VECTOR_SIZE && batch.output_row < slot.rows.size()) {
+			OutputGitStatusRow(output, slot.rows[batch.output_row], output_count);
 			output_count++;
-			state.current_output_row++;
+			batch.output_row++;
 		}
-
-		output.SetCardinality(output_count);
-
-		if (state.current_output_row >= state.current_rows.size()) {
-			state.current_input_row++;
-			state.initialized_row = false;
+		if (batch.output_row >= slot.rows.size()) {
+			slot.rows.clear();
+			batch.emitted++;
+			batch.output_row = 0;
 		}
+	}
+	output.SetCardinality(output_count);
 
-		if (output_count > 0) {
-			return OperatorResultType::HAVE_MORE_OUTPUT;
-		}
-		// Zero rows for this input — continue to next input row
+	if (output_count > 0) {
+		return OperatorResultType::HAVE_MORE_OUTPUT;
 	}
+	state.batch.reset();
+	return OperatorResultType::NEED_MORE_INPUT;
 }
 
 //===--------------------------------------------------------------------===//
@@ -466,6 +581,8 @@ void RegisterGitStatusFunction(ExtensionLoader &loader) {
 	git_status_zero.named_parameters["untracked"] = LogicalType::BOOLEAN;
 	git_status_zero.named_parameters["ignored"] = LogicalType::BOOLEAN;
 	git_status_zero.named_parameters["path"] = LogicalType::VARCHAR;
+	git_status_zero.named_parameters["engine"] = LogicalType::VARCHAR;
+	git_status_zero.named_parameters["fsmonitor"] = LogicalType::VARCHAR;
 	git_status_set.AddFunction(git_status_zero);
 
 	// Single parameter: git_status(repo_path_or_uri)
@@ -474,6 +591,8 @@ void RegisterGitStatusFunction(ExtensionLoader &loader) {
 	git_status_single.named_parameters["untracked"] = LogicalType::BOOLEAN;
 	git_status_single.named_parameters["ignored"] = LogicalType::BOOLEAN;
 	git_status_single.named_parameters["path"] = LogicalType::VARCHAR;
+	git_status_single.named_parameters["engine"] = LogicalType::VARCHAR;
+	git_status_single.named_parameters["fsmonitor"] = LogicalType::VARCHAR;
 	git_status_set.AddFunction(git_status_single);
 
 	loader.RegisterFunction(git_status_set);
@@ -487,6 +606,9 @@ void RegisterGitStatusFunction(ExtensionLoader &loader) {
 	git_status_each_single.named_parameters["untracked"] = LogicalType::BOOLEAN;
 	git_status_each_single.named_parameters["ignored"] = LogicalType::BOOLEAN;
 	git_status_each_single.named_parameters["path"] = LogicalType::VARCHAR;
+	git_status_each_single.named_parameters["engine"] = LogicalType::VARCHAR;
+	git_status_each_single.named_parameters["fsmonitor"] = LogicalType::VARCHAR;
+	git_status_each_single.named_parameters["ordered"] = LogicalType::BOOLEAN;
 	git_status_each_set.AddFunction(git_status_each_single);
 
 	loader.RegisterFunction(git_status_each_set);
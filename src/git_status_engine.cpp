@@ -0,0 +1,793 @@
+#include "git_status_engine.hpp"
+#include "git_ref_watcher.hpp"
+#include "worktree_hash.hpp"
+#include "git_utils.hpp"
+#include "git_repo_pool.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+#ifdef _WIN32
+
+void CollectStatusRowsParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const GitStatusEngineOptions &opts, vector<GitStatusRow> &rows) {
+	throw NotImplementedException("git_status: engine := 'parallel' is not supported on Windows");
+}
+
+#else
+
+#ifdef __APPLE__
+#define DUCK_TAILS_ST_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#else
+#define DUCK_TAILS_ST_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
+
+// Index entries handed to each stat worker at a time.
+static constexpr idx_t STATUS_STAT_BATCH_SIZE = 256;
+// Worktrees whose status cache is kept; older ones start cold on next use.
+static constexpr idx_t MAX_CACHED_WORKTREES = 16;
+
+//===--------------------------------------------------------------------===//
+// Process-wide per-worktree cache
+//===--------------------------------------------------------------------===//
+
+enum class DirChildKind : uint8_t { FILE, DIRECTORY };
+
+struct DirChild {
+	string name;
+	DirChildKind kind;
+};
+
+// One directory's listing, valid while the directory's mtime is unchanged
+// (entries are only added/removed/renamed by operations that bump it).
+struct DirListing {
+	int64_t mtime_sec = 0;
+	int64_t mtime_nsec = 0;
+	vector<DirChild> children;
+};
+
+struct FileStamp {
+	int64_t mtime_sec = -1;
+	int64_t mtime_nsec = -1;
+	int64_t size = -1;
+
+	bool operator==(const FileStamp &other) const {
+		return mtime_sec == other.mtime_sec && mtime_nsec == other.mtime_nsec && size == other.size;
+	}
+};
+
+struct WorktreeStatusCache {
+	// Held for the duration of one status run on this worktree
+	std::mutex lock;
+	idx_t last_used = 0; // guarded by the cache map's lock
+
+	// Untracked cache: directory listings keyed by worktree-relative path.
+	// After each unfiltered walk only the directories it listed are kept.
+	unordered_map<string, DirListing> dirs;
+
+	// fsmonitor state: last token and the workdir flags of the tracked
+	// entries from the previous (unfiltered) run, valid for `index_stamp`
+	// and, when the repository is watched, `index_generation`
+	string fsmonitor_token;
+	bool have_previous = false;
+	FileStamp index_stamp;
+	uint64_t index_generation = 0;
+	unordered_map<string, uint32_t> previous_wt;
+};
+
+static shared_ptr<WorktreeStatusCache> GetWorktreeStatusCache(const string &workdir) {
+	static std::mutex caches_lock;
+	static unordered_map<string, shared_ptr<WorktreeStatusCache>> caches;
+	static idx_t use_counter = 0;
+	std::lock_guard<std::mutex> guard(caches_lock);
+	auto &entry = caches[workdir];
+	if (!entry) {
+		entry = make_shared_ptr<WorktreeStatusCache>();
+	}
+	entry->last_used = ++use_counter;
+	auto result = entry;
+	// Evicted entries stay alive for the runs still using them
+	while (caches.size() > MAX_CACHED_WORKTREES) {
+		auto oldest = caches.begin();
+		for (auto it = caches.begin(); it != caches.end(); ++it) {
+			if (it->second->last_used < oldest->second->last_used) {
+				oldest = it;
+			}
+		}
+		caches.erase(oldest);
+	}
+	return result;
+}
+
+static FileStamp StatStamp(const string &path) {
+	FileStamp stamp;
+	struct stat st;
+	if (stat(path.c_str(), &st) == 0) {
+		stamp.mtime_sec = static_cast<int64_t>(st.st_mtime);
+		stamp.mtime_nsec = static_cast<int64_t>(DUCK_TAILS_ST_MTIME_NSEC(st));
+		stamp.size = static_cast<int64_t>(st.st_size);
+	}
+	return stamp;
+}
+
+//===--------------------------------------------------------------------===//
+// fsmonitor
+//===--------------------------------------------------------------------===//
+
+// Paths an fsmonitor hook reported as changed since the previous token.
+struct ChangedPaths {
+	bool all = true;
+	vector<string> paths; // sorted, no trailing '/'
+
+	// True if `path` itself, one of its ancestors or one of its descendants
+	// was reported.
+	bool MayHaveChanged(const string &path) const {
+		if (all || path.empty()) {
+			return all || !paths.empty();
+		}
+		auto it = std::lower_bound(paths.begin(), paths.end(), path);
+		if (it != paths.end() && (*it == path || StringUtil::StartsWith(*it, path + "/"))) {
+			return true;
+		}
+		for (size_t slash = path.find('/'); slash != string::npos; slash = path.find('/', slash + 1)) {
+			if (std::binary_search(paths.begin(), paths.end(), path.substr(0, slash))) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+// Runs `<hook> 2 <token>` in the worktree and captures its stdout. The hook
+// is executed directly (no shell), so neither it nor the token is parsed.
+static bool RunFsmonitorHook(const string &workdir, const string &hook, const string &token, string &output) {
+	int fds[2];
+	if (pipe(fds) != 0) {
+		return false;
+	}
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+	// Everything the child needs is prepared before fork: after it, only
+	// async-signal-safe calls are allowed
+	string version = "2";
+	vector<char *> argv {const_cast<char *>(hook.c_str()), const_cast<char *>(version.c_str()),
+	                     const_cast<char *>(token.c_str()), nullptr};
+	pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+	if (pid == 0) {
+		if (dup2(fds[1], STDOUT_FILENO) < 0 || chdir(workdir.c_str()) != 0) {
+			_exit(127);
+		}
+		execvp(argv[0], argv.data());
+		_exit(127);
+	}
+	close(fds[1]);
+
+	char buffer[4096];
+	while (true) {
+		ssize_t n = read(fds[0], buffer, sizeof(buffer));
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			break;
+		}
+		output.append(buffer, NumericCast<size_t>(n));
+	}
+	close(fds[0]);
+
+	int status = 0;
+	while (waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR) {
+			return false;
+		}
+	}
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Queries the hook (git's fsmonitor hook protocol v2). Output is the new
+// token followed by NUL-separated changed paths; "/" or a failing hook means
+// "assume everything changed".
+static ChangedPaths QueryFsmonitor(const string &workdir, const string &hook, string &token) {
+	ChangedPaths changes;
+	string output;
+	if (!RunFsmonitorHook(workdir, hook, token, output)) {
+		token.clear();
+		return changes;
+	}
+
+	size_t token_end = output.find('\0');
+	if (token_end == string::npos) {
+		token.clear();
+		return changes;
+	}
+	bool had_token = !token.empty();
+	token = output.substr(0, token_end);
+
+	bool everything = !had_token;
+	size_t pos = token_end + 1;
+	while (pos < output.size()) {
+		size_t end = output.find('\0', pos);
+		if (end == string::npos) {
+			end = output.size();
+		}
+		string path = output.substr(pos, end - pos);
+		pos = end + 1;
+		while (!path.empty() && path.back() == '/') {
+			path.pop_back();
+		}
+		if (path.empty()) {
+			everything = true;
+			continue;
+		}
+		changes.paths.push_back(std::move(path));
+	}
+	if (!everything) {
+		std::sort(changes.paths.begin(), changes.paths.end());
+		changes.all = false;
+	}
+	return changes;
+}
+
+//===--------------------------------------------------------------------===//
+// Tracked entries: parallel stat
+//===--------------------------------------------------------------------===//
+
+struct TrackedEntry {
+	string path;
+	git_oid id;
+	uint32_t mode;
+	uint32_t file_size;
+	uint32_t ino;
+	int32_t mtime_sec;
+	uint32_t mtime_nsec;
+};
+
+static bool ContentMatches(git_repository *repo, const string &full_path, const TrackedEntry &entry, bool fast_hash) {
+	git_oid oid;
+	if (!HashWorktreeFile(repo, full_path, entry.path, fast_hash, oid)) {
+		return false;
+	}
+	return git_oid_equal(&oid, &entry.id) != 0;
+}
+
+// Workdir status bits for one tracked entry, following git's stat-match rules:
+// type/mode changes and size changes decide without reading the file; equal
+// stat data is trusted unless the entry is racy (mtime not older than the
+// index itself); everything else is decided by hashing the file.
+static uint32_t CheckTrackedEntry(git_repository *repo, const string &workdir, const TrackedEntry &entry,
+                                  bool trust_filemode, bool fast_hash, const FileStamp &index_stamp) {
+	if (entry.mode == GIT_FILEMODE_COMMIT) {
+		return 0; // submodules are not descended into
+	}
+
+	string full_path = workdir + entry.path;
+	struct stat st;
+	if (lstat(full_path.c_str(), &st) != 0) {
+		return GIT_STATUS_WT_DELETED;
+	}
+
+	bool entry_is_link = entry.mode == GIT_FILEMODE_LINK;
+	if (S_ISDIR(st.st_mode) || ((S_ISLNK(st.st_mode) != 0) != entry_is_link)) {
+		return GIT_STATUS_WT_TYPECHANGE;
+	}
+	if (!S_ISLNK(st.st_mode) && !S_ISREG(st.st_mode)) {
+		return GIT_STATUS_WT_TYPECHANGE;
+	}
+	if (trust_filemode && S_ISREG(st.st_mode)) {
+		bool is_exec = (st.st_mode & S_IXUSR) != 0;
+		if (is_exec != (entry.mode == GIT_FILEMODE_BLOB_EXECUTABLE)) {
+			return GIT_STATUS_WT_MODIFIED;
+		}
+	}
+
+	bool size_matches = entry.file_size == static_cast<uint32_t>(st.st_size);
+	if (!size_matches && entry.file_size != 0) {
+		return GIT_STATUS_WT_MODIFIED;
+	}
+
+	auto st_mtime_nsec = static_cast<uint32_t>(DUCK_TAILS_ST_MTIME_NSEC(st));
+	bool stat_matches = size_matches && entry.mtime_sec == static_cast<int32_t>(st.st_mtime) &&
+	                    (entry.mtime_nsec == 0 || entry.mtime_nsec == st_mtime_nsec) &&
+	                    (entry.ino == 0 || entry.ino == static_cast<uint32_t>(st.st_ino));
+	bool racy = entry.mtime_sec > index_stamp.mtime_sec ||
+	            (entry.mtime_sec == index_stamp.mtime_sec && entry.mtime_nsec >= index_stamp.mtime_nsec);
+	if (stat_matches && !racy) {
+		return 0;
+	}
+	return ContentMatches(repo, full_path, entry, fast_hash) ? 0 : GIT_STATUS_WT_MODIFIED;
+}
+
+// Computes workdir flags for entries[i] into flags[i] for every i with
+// check[i] set, on up to `max_threads` of DuckDB's scheduler threads. Hashing
+// needs a repository (filters, attributes), so each worker takes its
+// thread's handle from GitRepoPool.
+static void CheckTrackedEntriesParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                                        const string &workdir, const vector<TrackedEntry> &entries,
+                                        const vector<bool> &check, bool trust_filemode, bool fast_hash,
+                                        const FileStamp &index_stamp, idx_t max_threads, vector<uint32_t> &flags) {
+	idx_t num_batches = (entries.size() + STATUS_STAT_BATCH_SIZE - 1) / STATUS_STAT_BATCH_SIZE;
+	std::atomic<idx_t> next_batch(0);
+	auto work = [&](git_repository *worker_repo) {
+		while (true) {
+			idx_t batch = next_batch.fetch_add(1);
+			if (batch >= num_batches) {
+				break;
+			}
+			idx_t end = MinValue<idx_t>((batch + 1) * STATUS_STAT_BATCH_SIZE, entries.size());
+			for (idx_t i = batch * STATUS_STAT_BATCH_SIZE; i < end; i++) {
+				if (check[i]) {
+					flags[i] = CheckTrackedEntry(worker_repo, workdir, entries[i], trust_filemode, fast_hash,
+					                             index_stamp);
+				}
+			}
+		}
+	};
+
+	idx_t num_workers = MinValue<idx_t>(max_threads, num_batches);
+	if (num_workers <= 1) {
+		work(repo);
+		return;
+	}
+	RunParallelWorkers(context, num_workers, [&](idx_t worker) {
+		ScopedGitRepo worker_repo(repo_path);
+		if (!worker_repo.is_valid()) {
+			const git_error *e = git_error_last();
+			throw IOException("git_status: failed to open repository '%s': %s", repo_path,
+			                  e ? e->message : "unknown error");
+		}
+		work(worker_repo);
+	});
+}
+
+//===--------------------------------------------------------------------===//
+// Untracked discovery
+//===--------------------------------------------------------------------===//
+
+class UntrackedWalker {
+public:
+	UntrackedWalker(git_repository *repo, const string &workdir, WorktreeStatusCache &cache,
+	                const ChangedPaths &changes, const unordered_set<string> &tracked_files,
+	                const unordered_set<string> &tracked_dirs, bool include_untracked, bool include_ignored,
+	                std::map<string, uint32_t> &out)
+	    : repo(repo), workdir(workdir), cache(cache), changes(changes), tracked_files(tracked_files),
+	      tracked_dirs(tracked_dirs), include_untracked(include_untracked), include_ignored(include_ignored),
+	      out(out) {
+	}
+
+	// Directory listing, from the cache when still valid. With an fsmonitor
+	// oracle, directories it did not report are trusted without a stat. The
+	// result is only valid until the next call.
+	const vector<DirChild> *List(const string &rel_dir) {
+		listed.insert(rel_dir);
+		auto cached = cache.dirs.find(rel_dir);
+		if (cached != cache.dirs.end() && !changes.MayHaveChanged(rel_dir)) {
+			return &cached->second.children;
+		}
+
+		string full_dir = rel_dir.empty() ? workdir : workdir + rel_dir;
+		struct stat st;
+		if (stat(full_dir.c_str(), &st) != 0) {
+			return nullptr;
+		}
+		int64_t mtime_sec = static_cast<int64_t>(st.st_mtime);
+		int64_t mtime_nsec = static_cast<int64_t>(DUCK_TAILS_ST_MTIME_NSEC(st));
+		if (cached != cache.dirs.end() && cached->second.mtime_sec == mtime_sec &&
+		    cached->second.mtime_nsec == mtime_nsec) {
+			return &cached->second.children;
+		}
+
+		int64_t listed_at = static_cast<int64_t>(time(nullptr));
+		DIR *dir = opendir(full_dir.c_str());
+		if (!dir) {
+			return nullptr;
+		}
+		DirListing listing;
+		listing.mtime_sec = mtime_sec;
+		listing.mtime_nsec = mtime_nsec;
+		while (struct dirent *ent = readdir(dir)) {
+			string name(ent->d_name);
+			if (name == "." || name == "..") {
+				continue;
+			}
+			bool is_dir;
+			if (ent->d_type == DT_UNKNOWN) {
+				struct stat child_st;
+				string child_path = full_dir + (rel_dir.empty() ? "" : "/") + name;
+				is_dir = lstat(child_path.c_str(), &child_st) == 0 && S_ISDIR(child_st.st_mode);
+			} else {
+				is_dir = ent->d_type == DT_DIR;
+			}
+			listing.children.push_back({std::move(name), is_dir ? DirChildKind::DIRECTORY : DirChildKind::FILE});
+		}
+		closedir(dir);
+		std::sort(listing.children.begin(), listing.children.end(),
+		          [](const DirChild &a, const DirChild &b) { return a.name < b.name; });
+
+		// A directory modified in the same second it was listed may change
+		// again without a visible mtime change: don't cache it (racy).
+		if (mtime_sec >= listed_at) {
+			cache.dirs.erase(rel_dir);
+			uncached = std::move(listing.children);
+			return &uncached;
+		}
+		auto &slot = cache.dirs[rel_dir];
+		slot = std::move(listing);
+		return &slot.children;
+	}
+
+	bool IsIgnored(const string &path, bool is_dir) {
+		int ignored = 0;
+		string probe = is_dir ? path + "/" : path;
+		if (git_ignore_path_is_ignored(&ignored, repo, probe.c_str()) != 0) {
+			return false;
+		}
+		return ignored != 0;
+	}
+
+	// Whether a wholly untracked directory has anything git would report.
+	bool HasUntrackedContent(const string &rel_dir) {
+		auto children_ptr = List(rel_dir);
+		if (!children_ptr) {
+			return false;
+		}
+		auto children = *children_ptr;
+		for (auto &child : children) {
+			string path = rel_dir + "/" + child.name;
+			if (child.kind == DirChildKind::DIRECTORY) {
+				if (child.name == ".git") {
+					return true; // nested repository
+				}
+				if (!IsIgnored(path, true) && HasUntrackedContent(path)) {
+					return true;
+				}
+			} else if (!IsIgnored(path, false)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Drops cached listings of directories this walk did not list (removed,
+	// now ignored, or no longer reached), so the cache tracks the worktree.
+	void PruneUnlisted() {
+		for (auto it = cache.dirs.begin(); it != cache.dirs.end();) {
+			if (listed.count(it->first)) {
+				++it;
+			} else {
+				it = cache.dirs.erase(it);
+			}
+		}
+	}
+
+	void Walk(const string &rel_dir) {
+		auto children_ptr = List(rel_dir);
+		if (!children_ptr) {
+			return;
+		}
+		// Copy: recursion may replace this directory's cache slot
+		auto children = *children_ptr;
+		for (auto &child : children) {
+			if (child.name == ".git") {
+				continue;
+			}
+			string path = rel_dir.empty() ? child.name : rel_dir + "/" + child.name;
+			if (child.kind == DirChildKind::DIRECTORY) {
+				if (tracked_dirs.count(path)) {
+					Walk(path);
+					continue;
+				}
+				if (tracked_files.count(path)) {
+					continue; // submodule
+				}
+				if (IsIgnored(path, true)) {
+					if (include_ignored) {
+						out[path + "/"] |= GIT_STATUS_IGNORED;
+					}
+				} else if (include_untracked && HasUntrackedContent(path)) {
+					out[path + "/"] |= GIT_STATUS_WT_NEW;
+				}
+				continue;
+			}
+			if (tracked_files.count(path)) {
+				continue;
+			}
+			if (IsIgnored(path, false)) {
+				if (include_ignored) {
+					out[path] |= GIT_STATUS_IGNORED;
+				}
+			} else if (include_untracked) {
+				out[path] |= GIT_STATUS_WT_NEW;
+			}
+		}
+	}
+
+private:
+	git_repository *repo;
+	const string &workdir;
+	WorktreeStatusCache &cache;
+	const ChangedPaths &changes;
+	const unordered_set<string> &tracked_files;
+	const unordered_set<string> &tracked_dirs;
+	bool include_untracked;
+	bool include_ignored;
+	std::map<string, uint32_t> &out;
+
+	// Listing of a racy directory (not cached); callers copy it before the
+	// next List() call.
+	vector<DirChild> uncached;
+	unordered_set<string> listed;
+};
+
+//===--------------------------------------------------------------------===//
+// Engine
+//===--------------------------------------------------------------------===//
+
+static uint32_t DeltaToIndexFlag(git_delta_t status) {
+	switch (status) {
+	case GIT_DELTA_ADDED:
+		return GIT_STATUS_INDEX_NEW;
+	case GIT_DELTA_DELETED:
+		return GIT_STATUS_INDEX_DELETED;
+	case GIT_DELTA_MODIFIED:
+		return GIT_STATUS_INDEX_MODIFIED;
+	case GIT_DELTA_RENAMED:
+		return GIT_STATUS_INDEX_RENAMED;
+	case GIT_DELTA_TYPECHANGE:
+		return GIT_STATUS_INDEX_TYPECHANGE;
+	case GIT_DELTA_CONFLICTED:
+		return GIT_STATUS_CONFLICTED;
+	default:
+		return 0;
+	}
+}
+
+// HEAD-to-index changes: a tree-to-index diff, which touches no worktree files.
+static void CollectStagedChanges(git_repository *repo, git_index *index, const string &path_filter,
+                                 std::map<string, uint32_t> &flags, unordered_map<string, string> &old_paths) {
+	git_tree *head_tree = nullptr;
+	git_object *head_obj = nullptr;
+	if (git_revparse_single(&head_obj, repo, "HEAD^{tree}") == 0) {
+		head_tree = reinterpret_cast<git_tree *>(head_obj);
+	}
+	auto tree_guard = MakeGitTree(head_tree);
+
+	git_diff_options diff_opts = GIT_DIFF_OPTIONS_INIT;
+	diff_opts.flags = GIT_DIFF_INCLUDE_TYPECHANGE;
+	char *pathspec_cstr = nullptr;
+	if (!path_filter.empty()) {
+		diff_opts.flags |= GIT_DIFF_DISABLE_PATHSPEC_MATCH;
+		pathspec_cstr = const_cast<char *>(path_filter.c_str());
+		diff_opts.pathspec.count = 1;
+		diff_opts.pathspec.strings = &pathspec_cstr;
+	}
+
+	git_diff *diff = nullptr;
+	if (git_diff_tree_to_index(&diff, repo, head_tree, index, &diff_opts) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_status: failed to diff HEAD against the index: %s", e ? e->message : "Unknown error");
+	}
+	git_diff_find_options find_opts = GIT_DIFF_FIND_OPTIONS_INIT;
+	find_opts.flags = GIT_DIFF_FIND_RENAMES;
+	if (git_diff_find_similar(diff, &find_opts) != 0) {
+		const git_error *e = git_error_last();
+		string message = e ? e->message : "Unknown error";
+		git_diff_free(diff);
+		throw IOException("git_status: rename detection failed: %s", message);
+	}
+
+	size_t num_deltas = git_diff_num_deltas(diff);
+	for (size_t i = 0; i < num_deltas; i++) {
+		const git_diff_delta *delta = git_diff_get_delta(diff, i);
+		uint32_t flag = delta ? DeltaToIndexFlag(delta->status) : 0;
+		if (!flag) {
+			continue;
+		}
+		const char *path = delta->status == GIT_DELTA_DELETED ? delta->old_file.path : delta->new_file.path;
+		if (!path) {
+			continue;
+		}
+		flags[path] |= flag;
+		if (delta->status == GIT_DELTA_RENAMED && delta->old_file.path) {
+			old_paths[path] = delta->old_file.path;
+		}
+	}
+	git_diff_free(diff);
+}
+
+static void CollectStatusRowsParallelLocked(ClientContext &context, git_repository *repo, const string &repo_path,
+                                            const string &workdir, const GitStatusEngineOptions &opts,
+                                            WorktreeStatusCache &cache, vector<GitStatusRow> &rows) {
+	// Read before the index: a write racing with this run moves it again.
+	uint64_t index_generation = 0;
+	if (opts.watch_refs) {
+		auto watched = GitRefWatcher::Instance().Watch(repo, repo_path, false);
+		index_generation = watched ? watched->index_generation.load() : 0;
+	}
+	git_index *index = nullptr;
+	if (git_repository_index(&index, repo) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("git_status: failed to read index: %s", e ? e->message : "Unknown error");
+	}
+	auto index_guard = MakeGitIndex(index);
+	const char *index_path = git_index_path(index);
+	FileStamp index_stamp = index_path ? StatStamp(index_path) : FileStamp();
+
+	bool trust_filemode = true;
+	git_config *config = nullptr;
+	if (git_repository_config_snapshot(&config, repo) == 0) {
+		int value = 1;
+		if (git_config_get_bool(&value, config, "core.filemode") == 0) {
+			trust_filemode = value != 0;
+		}
+		git_config_free(config);
+	}
+
+	// Snapshot the index: tracked entries to stat, conflicts, tracked paths.
+	vector<TrackedEntry> entries;
+	unordered_set<string> tracked_files;
+	unordered_set<string> tracked_dirs;
+	std::map<string, uint32_t> flags;
+	size_t entry_count = git_index_entrycount(index);
+	entries.reserve(entry_count);
+	for (size_t i = 0; i < entry_count; i++) {
+		const git_index_entry *ie = git_index_get_byindex(index, i);
+		if (!ie || !ie->path) {
+			continue;
+		}
+		string path(ie->path);
+		if (tracked_files.insert(path).second) {
+			for (size_t slash = path.find('/'); slash != string::npos; slash = path.find('/', slash + 1)) {
+				tracked_dirs.insert(path.substr(0, slash));
+			}
+		}
+		if (!opts.path_filter.empty() && path != opts.path_filter) {
+			continue;
+		}
+		if (git_index_entry_stage(ie) != 0) {
+			flags[path] = GIT_STATUS_CONFLICTED;
+			continue;
+		}
+		if (ie->flags_extended & GIT_INDEX_ENTRY_SKIP_WORKTREE) {
+			continue;
+		}
+		TrackedEntry entry;
+		entry.path = std::move(path);
+		git_oid_cpy(&entry.id, &ie->id);
+		entry.mode = ie->mode;
+		entry.file_size = ie->file_size;
+		entry.ino = ie->ino;
+		entry.mtime_sec = ie->mtime.seconds;
+		entry.mtime_nsec = ie->mtime.nanoseconds;
+		entries.push_back(std::move(entry));
+	}
+
+	unordered_map<string, string> old_paths;
+	CollectStagedChanges(repo, index, opts.path_filter, flags, old_paths);
+
+	// Ask the oracle what changed; it can only narrow the work when the
+	// previous unfiltered run saw the same index. Only unfiltered runs
+	// advance the token: a filtered run refreshes neither previous_wt nor
+	// the directory listings, so the changes it consumed must be reported
+	// again to the next run.
+	ChangedPaths changes;
+	string fsmonitor_token = cache.fsmonitor_token;
+	if (!opts.fsmonitor_hook.empty()) {
+		changes = QueryFsmonitor(workdir, opts.fsmonitor_hook, fsmonitor_token);
+		if (!cache.have_previous || !(cache.index_stamp == index_stamp) ||
+		    cache.index_generation != index_generation) {
+			changes.all = true;
+		}
+	} else {
+		cache.fsmonitor_token.clear();
+		cache.have_previous = false;
+	}
+
+	vector<bool> check(entries.size(), true);
+	vector<uint32_t> wt_flags(entries.size(), 0);
+	if (!changes.all) {
+		for (idx_t i = 0; i < entries.size(); i++) {
+			if (!changes.MayHaveChanged(entries[i].path)) {
+				check[i] = false;
+				auto previous = cache.previous_wt.find(entries[i].path);
+				wt_flags[i] = previous == cache.previous_wt.end() ? 0 : previous->second;
+			}
+		}
+	}
+	CheckTrackedEntriesParallel(context, repo, repo_path, workdir, entries, check, trust_filemode, opts.fast_hash,
+	                            index_stamp, MaxValue<idx_t>(opts.max_threads, 1), wt_flags);
+
+	for (idx_t i = 0; i < entries.size(); i++) {
+		if (wt_flags[i]) {
+			flags[entries[i].path] |= wt_flags[i];
+		}
+	}
+	if (!opts.fsmonitor_hook.empty() && opts.path_filter.empty()) {
+		cache.fsmonitor_token = fsmonitor_token;
+		cache.previous_wt.clear();
+		for (idx_t i = 0; i < entries.size(); i++) {
+			if (wt_flags[i]) {
+				cache.previous_wt[entries[i].path] = wt_flags[i];
+			}
+		}
+		cache.index_stamp = index_stamp;
+		cache.index_generation = index_generation;
+		cache.have_previous = true;
+	}
+
+	if (opts.include_untracked || opts.include_ignored) {
+		UntrackedWalker walker(repo, workdir, cache, changes, tracked_files, tracked_dirs, opts.include_untracked,
+		                       opts.include_ignored, flags);
+		if (opts.path_filter.empty()) {
+			walker.Walk("");
+			walker.PruneUnlisted();
+		} else if (!tracked_files.count(opts.path_filter)) {
+			struct stat st;
+			string full_path = workdir + opts.path_filter;
+			if (lstat(full_path.c_str(), &st) == 0 && !S_ISDIR(st.st_mode)) {
+				if (walker.IsIgnored(opts.path_filter, false)) {
+					if (opts.include_ignored) {
+						flags[opts.path_filter] |= GIT_STATUS_IGNORED;
+					}
+				} else if (opts.include_untracked) {
+					flags[opts.path_filter] |= GIT_STATUS_WT_NEW;
+				}
+			}
+		}
+	}
+
+	for (auto &entry : flags) {
+		if (!entry.second) {
+			continue;
+		}
+		GitStatusRow row;
+		row.repo_path = repo_path;
+		row.file_path = entry.first;
+		row.status_flags = entry.second;
+		auto old_path = old_paths.find(entry.first);
+		if (old_path != old_paths.end()) {
+			row.old_path = old_path->second;
+		}
+		rows.push_back(std::move(row));
+	}
+}
+
+void CollectStatusRowsParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const GitStatusEngineOptions &opts, vector<GitStatusRow> &rows) {
+	const char *workdir_cstr = git_repository_workdir(repo);
+	if (!workdir_cstr) {
+		throw IOException("git_status: repository '%s' has no working directory", repo_path);
+	}
+	string workdir(workdir_cstr);
+
+	auto cache = GetWorktreeStatusCache(workdir);
+	std::lock_guard<std::mutex> guard(cache->lock);
+	CollectStatusRowsParallelLocked(context, repo, repo_path, workdir, opts, *cache, rows);
+}
+
+#endif
+
+} // namespace duckdb
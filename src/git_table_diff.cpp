@@ -0,0 +1,251 @@
+#include "duckdb.hpp"
+#include "git_functions.hpp"
+#include "git_filesystem.hpp"
+#include "git_utils.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+#include "duckdb/planner/binder.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// read_git_table_diff — keyed row diff of two versions of a data file
+//
+// Both versions are read with the reader for their format and joined on the
+// key columns. The function binds to that query (bind_replace), so the join
+// is DuckDB's partitioned hash join, which spills to disk when the sides do
+// not fit in memory, and only the key and compared columns are read. Rows
+// whose compared columns all match are dropped; the rest stream out as
+// INSERTED, DELETED or UPDATED with the names of the changed columns.
+//
+// A key that occurs twice in one version is an error rather than a cross
+// product of its rows. Each side is checked by grouping its key columns
+// alone (a second, key-only scan), so whole rows are never aggregated; the
+// error is raised before any joined row is returned.
+//
+// When both URIs name the same blob, only the old version is bound (which
+// reads its schema) and both sides scan it with LIMIT 0, so the result is
+// empty and no rows are read.
+//===--------------------------------------------------------------------===//
+
+static string TableDiffFilePath(const string &uri) {
+	if (StringUtil::StartsWith(uri, "git://")) {
+		try {
+			return GitPath::Parse(uri).file_path;
+		} catch (const std::exception &) {
+		}
+	}
+	return uri;
+}
+
+// Reader table function for `format`, or for the file extension when empty
+static string TableDiffReader(const string &format, const string &uri) {
+	string kind = StringUtil::Lower(format);
+	if (kind.empty()) {
+		auto path = StringUtil::Lower(TableDiffFilePath(uri));
+		if (StringUtil::EndsWith(path, ".parquet")) {
+			kind = "parquet";
+		} else if (StringUtil::EndsWith(path, ".json") || StringUtil::EndsWith(path, ".jsonl") ||
+		           StringUtil::EndsWith(path, ".ndjson")) {
+			kind = "json";
+		} else {
+			kind = "csv";
+		}
+	}
+	if (kind == "csv" || kind == "tsv") {
+		return "read_csv";
+	}
+	if (kind == "parquet") {
+		return "read_parquet";
+	}
+	if (kind == "json") {
+		return "read_json";
+	}
+	throw InvalidInputException("read_git_table_diff: unknown format '%s' (expected csv, parquet or json)", format);
+}
+
+static vector<string> TableDiffNames(const Value &value, const char *parameter) {
+	vector<string> names;
+	if (value.IsNull()) {
+		return names;
+	}
+	if (value.type().id() == LogicalTypeId::LIST) {
+		for (auto &child : ListValue::GetChildren(value)) {
+			if (!child.IsNull()) {
+				names.push_back(child.ToString());
+			}
+		}
+	} else if (value.type().id() == LogicalTypeId::VARCHAR) {
+		names.push_back(StringValue::Get(value));
+	} else {
+		throw InvalidInputException("read_git_table_diff: %s must be a column name or a list of column names",
+		                            parameter);
+	}
+	return names;
+}
+
+// Column names of a source, from binding it
+static vector<string> TableDiffSourceColumns(ClientContext &context, const string &source) {
+	Parser parser;
+	parser.ParseQuery("SELECT * FROM " + source);
+	auto binder = Binder::CreateBinder(context);
+	auto bound = binder->Bind(*parser.statements[0]);
+	return bound.names;
+}
+
+static void RequireTableDiffColumn(const vector<string> &names, const string &column, const string &uri) {
+	if (std::find(names.begin(), names.end(), column) == names.end()) {
+		throw BinderException("read_git_table_diff: column '%s' not found in '%s'", column, uri);
+	}
+}
+
+static unique_ptr<TableRef> ReadGitTableDiffBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	auto old_uri = input.inputs[0].ToString();
+	auto new_uri = input.inputs[1].ToString();
+
+	vector<string> keys;
+	vector<string> columns;
+	string format;
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "key") {
+			keys = TableDiffNames(kv.second, "key");
+		} else if (kv.first == "columns") {
+			columns = TableDiffNames(kv.second, "columns");
+		} else if (kv.first == "format") {
+			format = kv.second.ToString();
+		}
+	}
+	if (keys.empty()) {
+		throw BinderException("read_git_table_diff requires key := ['column', ...]");
+	}
+
+	string old_repo, new_repo;
+	git_oid old_id, new_id;
+	bool same_blob = TryGetGitUriBlobId(old_uri, old_repo, old_id) && TryGetGitUriBlobId(new_uri, new_repo, new_id) &&
+	                 old_repo == new_repo && git_oid_equal(&old_id, &new_id);
+
+	string old_source = TableDiffReader(format, old_uri) + "(" + KeywordHelper::WriteQuoted(old_uri, '\'') + ")";
+	string new_source = TableDiffReader(format, new_uri) + "(" + KeywordHelper::WriteQuoted(new_uri, '\'') + ")";
+	if (same_blob) {
+		new_source = old_source;
+	}
+	auto old_names = TableDiffSourceColumns(context, old_source);
+	auto new_names = same_blob ? old_names : TableDiffSourceColumns(context, new_source);
+	for (auto &key : keys) {
+		RequireTableDiffColumn(old_names, key, old_uri);
+		RequireTableDiffColumn(new_names, key, new_uri);
+	}
+	if (columns.empty()) {
+		// Every non-key column present in both versions
+		for (auto &name : old_names) {
+			bool is_key = std::find(keys.begin(), keys.end(), name) != keys.end();
+			if (!is_key && std::find(new_names.begin(), new_names.end(), name) != new_names.end()) {
+				columns.push_back(name);
+			}
+		}
+	} else {
+		for (auto &column : columns) {
+			RequireTableDiffColumn(old_names, column, old_uri);
+			RequireTableDiffColumn(new_names, column, new_uri);
+		}
+		// Keys are always compared
+		columns.erase(std::remove_if(columns.begin(), columns.end(),
+		                             [&](const string &column) {
+			                             return std::find(keys.begin(), keys.end(), column) != keys.end();
+		                             }),
+		              columns.end());
+	}
+
+	auto quote = [](const string &name) {
+		return KeywordHelper::WriteOptionallyQuoted(name);
+	};
+	// Each side is the projected rows plus a marker for the outer join
+	string projection, key_list, key_text;
+	for (idx_t i = 0; i < keys.size(); i++) {
+		projection += quote(keys[i]) + ", ";
+		key_list += (i == 0 ? "" : ", ") + quote(keys[i]);
+		key_text += ", " + quote(keys[i]) + "::VARCHAR";
+	}
+	for (auto &column : columns) {
+		projection += quote(column) + ", ";
+	}
+	projection += "true AS __present";
+	string limit = same_blob ? " LIMIT 0" : "";
+	auto side = [&](const string &source) {
+		return "(SELECT " + projection + " FROM " + source + limit + ")";
+	};
+	// One repeated key of a side as text, or NULL; only the key columns are
+	// read and grouped
+	auto duplicate_key = [&](const string &source) {
+		return "(SELECT concat_ws(', '" + key_text + ") FROM (SELECT " + key_list + " FROM " + source + limit +
+		       ") GROUP BY " + key_list + " HAVING count(*) > 1 LIMIT 1)";
+	};
+	auto duplicate_error = [&](const string &column, const string &uri) {
+		return "error(" + KeywordHelper::WriteQuoted("read_git_table_diff: duplicate key (", '\'') + " || " + column +
+		       " || " + KeywordHelper::WriteQuoted(") in '" + uri + "'; key columns must be unique", '\'') + ")";
+	};
+
+	string sql = "SELECT CASE WHEN __old.__present IS NULL THEN 'INSERTED' WHEN __new.__present IS NULL THEN "
+	             "'DELETED' ELSE 'UPDATED' END AS change_type";
+	for (auto &key : keys) {
+		sql += ", COALESCE(__new." + quote(key) + ", __old." + quote(key) + ") AS " + quote(key);
+	}
+	string changed, old_values, new_values, old_row, new_row;
+	for (idx_t i = 0; i < columns.size(); i++) {
+		auto &column = columns[i];
+		string separator = i == 0 ? "" : ", ";
+		changed += separator + "CASE WHEN __old." + quote(column) + " IS DISTINCT FROM __new." + quote(column) +
+		           " THEN " + KeywordHelper::WriteQuoted(column, '\'') + " END";
+		old_values += separator + KeywordHelper::WriteQuoted(column, '\'') + ": __old." + quote(column);
+		new_values += separator + KeywordHelper::WriteQuoted(column, '\'') + ": __new." + quote(column);
+		old_row += separator + "__old." + quote(column);
+		new_row += separator + "__new." + quote(column);
+	}
+	if (columns.empty()) {
+		sql += ", []::VARCHAR[] AS changed_columns";
+	} else {
+		sql += ", CASE WHEN __old.__present AND __new.__present THEN list_filter([" + changed +
+		       "], x -> x IS NOT NULL) ELSE []::VARCHAR[] END AS changed_columns";
+		sql += ", CASE WHEN __old.__present THEN {" + old_values + "} END AS old_values";
+		sql += ", CASE WHEN __new.__present THEN {" + new_values + "} END AS new_values";
+	}
+	sql += " FROM (SELECT " + duplicate_key(old_source) + " AS __old_duplicate, " + duplicate_key(new_source) +
+	       " AS __new_duplicate) __duplicates, ";
+	sql += side(old_source) + " __old FULL OUTER JOIN " + side(new_source) + " __new ON ";
+	for (idx_t i = 0; i < keys.size(); i++) {
+		sql += (i == 0 ? "" : " AND ") + string("__old.") + quote(keys[i]) + " IS NOT DISTINCT FROM __new." +
+		       quote(keys[i]);
+	}
+	// One predicate, so the duplicate check runs before any row is dropped
+	sql += " WHERE CASE WHEN __old_duplicate IS NOT NULL THEN " + duplicate_error("__old_duplicate", old_uri) +
+	       " WHEN __new_duplicate IS NOT NULL THEN " + duplicate_error("__new_duplicate", new_uri) +
+	       " ELSE __old.__present IS NULL OR __new.__present IS NULL";
+	if (!columns.empty()) {
+		sql += " OR ROW(" + old_row + ") IS DISTINCT FROM ROW(" + new_row + ")";
+	}
+	sql += " END";
+
+	Parser parser;
+	parser.ParseQuery(sql);
+	auto select = unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
+	return make_uniq<SubqueryRef>(std::move(select));
+}
+
+void RegisterGitTableDiffFunction(ExtensionLoader &loader) {
+	TableFunction read_git_table_diff("read_git_table_diff", {LogicalType::VARCHAR, LogicalType::VARCHAR}, nullptr,
+	                                  nullptr);
+	read_git_table_diff.bind_replace = ReadGitTableDiffBindReplace;
+	read_git_table_diff.named_parameters["key"] = LogicalType::ANY;
+	read_git_table_diff.named_parameters["columns"] = LogicalType::ANY;
+	read_git_table_diff.named_parameters["format"] = LogicalType::VARCHAR;
+	loader.RegisterFunction(read_git_table_diff);
+}
+
+} // namespace duckdb
@@ -1,4 +1,5 @@
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_utils.hpp"
 #include "git_context_manager.hpp"
@@ -14,11 +15,14 @@ namespace duckdb {
 // Helper Functions
 //===--------------------------------------------------------------------===//
 
-// Helper function to convert git OID to hex string
-static string oid_to_hex(const git_oid *oid) {
-	char hex[GIT_OID_HEXSZ + 1];
-	git_oid_tostr(hex, sizeof(hex), oid);
-	return string(hex);
+// Writes a commit_hash/tag_hash value; a missing id is written as '', which
+// FinalizeGitOidColumns turns into NULL for GITOID output.
+static void SetTagHash(Vector &hashes, idx_t row_idx, const git_oid *oid) {
+	if (oid) {
+		SetGitOid(hashes, row_idx, oid);
+	} else {
+		hashes.SetValue(row_idx, Value(""));
+	}
 }
 
 static int tag_foreach_cb(const char *name, git_oid *oid, void *payload) {
@@ -74,7 +78,9 @@ unique_ptr<FunctionData> GitTagsBind(ClientContext &context, TableFunctionBindIn
 
 	try {
 		auto ctx = GitContextManager::Instance().ProcessGitUri(params.repo_path_or_uri, params.ref);
-		return make_uniq<GitTagsFunctionData>(params.repo_path_or_uri, ctx.repo_path);
+		auto bind_data = make_uniq<GitTagsFunctionData>(params.repo_path_or_uri, ctx.repo_path);
+		bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+		return std::move(bind_data);
 	} catch (const std::exception &e) {
 		throw BinderException("git_tags: %s", e.what());
 	}
@@ -106,7 +112,9 @@ unique_ptr<FunctionData> GitTagsEachBind(ClientContext &context, TableFunctionBi
 	         "tagger_name", "tagger_date", "message",     "is_annotated"};
 
 	// For LATERAL functions, store the ref parameter (defaults to "HEAD" from ParseLateralGitParams)
-	return make_uniq<GitTagsFunctionData>(params.ref);
+	auto bind_data = make_uniq<GitTagsFunctionData>(params.ref);
+	bind_data->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(bind_data);
 }
 
 //===--------------------------------------------------------------------===//
@@ -159,23 +167,21 @@ void GitTagsFunction(ClientContext &context, TableFunctionInput &data_p, DataChu
 
 			const git_oid *oid = git_reference_target(tag_ref);
 			if (oid) {
-				char tag_hash_str[GIT_OID_HEXSZ + 1];
-				git_oid_tostr(tag_hash_str, sizeof(tag_hash_str), oid);
-				output.SetValue(3, count, Value(tag_hash_str)); // tag_hash column
+				SetGitOid(output.data[3], count, oid); // tag_hash column
 
 				// Try to get tag object for annotation info
 				git_tag *tag_obj = nullptr;
 				bool is_annotated = false;
-				string commit_hash;
+				git_oid commit_id;
+				const git_oid *commit_oid = nullptr;
 
 				if (git_tag_lookup(&tag_obj, local_state.repo, oid) == 0) {
 					// Annotated tag - get the commit it points to
 					is_annotated = true;
 					const git_oid *target_oid = git_tag_target_id(tag_obj);
 					if (target_oid) {
-						char commit_hash_str[GIT_OID_HEXSZ + 1];
-						git_oid_tostr(commit_hash_str, sizeof(commit_hash_str), target_oid);
-						commit_hash = commit_hash_str;
+						git_oid_cpy(&commit_id, target_oid);
+						commit_oid = &commit_id;
 					}
 
 					const git_signature *tagger = git_tag_tagger(tag_obj);
@@ -194,13 +200,13 @@ void GitTagsFunction(ClientContext &context, TableFunctionInput &data_p, DataChu
 					git_tag_free(tag_obj);
 				} else {
 					// Lightweight tag - tag_hash and commit_hash are the same
-					commit_hash = tag_hash_str;
+					commit_oid = oid;
 					output.SetValue(4, count, Value(""));
 					output.SetValue(5, count, Value());
 					output.SetValue(6, count, Value(""));
 				}
 
-				output.SetValue(2, count, Value(commit_hash)); // commit_hash column
+				SetTagHash(output.data[2], count, commit_oid); // commit_hash column
 				output.SetValue(7, count, Value::BOOLEAN(is_annotated));
 			}
 
@@ -212,6 +218,7 @@ void GitTagsFunction(ClientContext &context, TableFunctionInput &data_p, DataChu
 	}
 
 	output.SetCardinality(count);
+	FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 }
 
 //===--------------------------------------------------------------------===//
@@ -245,9 +252,8 @@ static void ProcessTagsForInOut(git_repository *repo, const string &resolved_rep
 		if (error == 0) {
 			const git_oid *oid = git_reference_target(tag_ref);
 			if (oid) {
-				char tag_hash_str[GIT_OID_HEXSZ + 1];
-				git_oid_tostr(tag_hash_str, sizeof(tag_hash_str), oid);
-				row.tag_hash = tag_hash_str;
+				git_oid_cpy(&row.tag_id, oid);
+				row.has_tag = true;
 
 				// Try to get tag object for annotation info
 				git_tag *tag_obj = nullptr;
@@ -258,9 +264,8 @@ static void ProcessTagsForInOut(git_repository *repo, const string &resolved_rep
 					is_annotated = true;
 					const git_oid *target_oid = git_tag_target_id(tag_obj);
 					if (target_oid) {
-						char commit_hash_str[GIT_OID_HEXSZ + 1];
-						git_oid_tostr(commit_hash_str, sizeof(commit_hash_str), target_oid);
-						row.commit_hash = commit_hash_str;
+						git_oid_cpy(&row.commit_id, target_oid);
+						row.has_commit = true;
 					}
 
 					const git_signature *tagger = git_tag_tagger(tag_obj);
@@ -279,7 +284,8 @@ static void ProcessTagsForInOut(git_repository *repo, const string &resolved_rep
 					tag_obj = nullptr;
 				} else {
 					// Lightweight tag - tag_hash and commit_hash are the same
-					row.commit_hash = tag_hash_str;
+					git_oid_cpy(&row.commit_id, oid);
+					row.has_commit = true;
 					row.tagger_name = "";
 					row.tagger_date = timestamp_t(0);
 					row.message = "";
@@ -287,8 +293,6 @@ static void ProcessTagsForInOut(git_repository *repo, const string &resolved_rep
 
 				row.is_annotated = is_annotated;
 			} else {
-				row.commit_hash = "";
-				row.tag_hash = "";
 				row.tagger_name = "";
 				row.tagger_date = timestamp_t(0);
 				row.message = "";
@@ -412,8 +416,8 @@ static OperatorResultType GitTagsEachFunction(ExecutionContext &context, TableFu
 
 			output.SetValue(0, output_count, Value(resolved_repo_path));
 			output.SetValue(1, output_count, Value(row.tag_name));
-			output.SetValue(2, output_count, Value(row.commit_hash));
-			output.SetValue(3, output_count, Value(row.tag_hash));
+			SetTagHash(output.data[2], output_count, row.has_commit ? &row.commit_id : nullptr);
+			SetTagHash(output.data[3], output_count, row.has_tag ? &row.tag_id : nullptr);
 			output.SetValue(4, output_count, Value(row.tagger_name));
 			output.SetValue(5, output_count, Value::TIMESTAMP(row.tagger_date));
 			output.SetValue(6, output_count, Value(row.message));
@@ -424,6 +428,7 @@ static OperatorResultType GitTagsEachFunction(ExecutionContext &context, TableFu
 		}
 
 		output.SetCardinality(output_count);
+		FinalizeGitOidColumns(output, bind_data.gitoid_columns);
 
 		if (state.current_output_row >= state.current_rows.size()) {
 			state.current_input_row++;
@@ -1,13 +1,17 @@
 #include "duckdb.hpp"
 #include "git_functions.hpp"
+#include "git_oid_type.hpp"
 #include "git_filesystem.hpp"
 #include "git_path.hpp"
 #include "git_context_manager.hpp"
 #include "git_utils.hpp"
+#include "git_result_cache.hpp"
+#include "worktree_hash.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include <git2.h>
 #include <algorithm>
@@ -61,16 +65,13 @@ static vector<string> GetGitTreeColumnNames() {
 static void OutputGitTreeRow(DataChunk &output, const GitTreeRow &row, idx_t row_idx) {
 	output.SetValue(0, row_idx, Value(row.git_uri));
 	output.SetValue(1, row_idx, Value(row.repo_path));
-	output.SetValue(2, row_idx, row.commit_hash.empty() ? Value() : Value(row.commit_hash));
-	output.SetValue(3, row_idx, row.tree_hash.empty() ? Value() : Value(row.tree_hash));
+	SetGitOid(output.data[2], row_idx, row.has_commit ? &row.commit_id : nullptr);
+	SetGitOid(output.data[3], row_idx, row.has_tree ? &row.tree_id : nullptr);
 	output.SetValue(4, row_idx, Value(row.file_path));
 	output.SetValue(5, row_idx, Value(row.file_ext));
 	output.SetValue(6, row_idx, Value(row.ref));
-	if (row.kind == "file" && !row.blob_hash.empty()) {
-		output.SetValue(7, row_idx, Value(row.blob_hash));
-	} else {
-		output.SetValue(7, row_idx, Value()); // NULL for non-file entries or workdir
-	}
+	// NULL for non-file entries or unreadable workdir files
+	SetGitOid(output.data[7], row_idx, row.kind == "file" && row.has_blob ? &row.blob_id : nullptr);
 	output.SetValue(8, row_idx, Value::TIMESTAMP(row.commit_date));
 	output.SetValue(9, row_idx, Value::INTEGER(row.mode));
 	output.SetValue(10, row_idx, Value::BIGINT(row.size_bytes));
@@ -128,20 +129,32 @@ static string ExtractFileExtension(const string &path) {
 
 // NormalizeRepoPathSpec is now defined in git_path.cpp
 
+// The commit a tree walk emits rows for
+struct GitTreeCommit {
+	git_oid id;
+	string hash; // hex, for git_uri and ref
+	timestamp_t date;
+
+	explicit GitTreeCommit(const git_commit *commit)
+	    : hash(oid_to_hex(git_commit_id(commit))), date(Timestamp::FromEpochSeconds(git_commit_time(commit))) {
+		git_oid_cpy(&id, git_commit_id(commit));
+	}
+};
+
 // Helper functions for emitting different row types
-static inline void EmitTreeRow(vector<GitTreeRow> &out, const string &repo_path, const string &commit_hash,
-                               const string &containing_tree_hash, const string &path, timestamp_t commit_date,
-                               int32_t mode) {
+static inline void EmitTreeRow(vector<GitTreeRow> &out, const string &repo_path, const GitTreeCommit &commit,
+                               const git_oid *containing_tree, const string &path, int32_t mode) {
 	GitTreeRow row;
-	row.git_uri = BuildGitFileUri(repo_path, path, commit_hash);
+	row.git_uri = BuildGitFileUri(repo_path, path, commit.hash);
 	row.repo_path = repo_path;
-	row.commit_hash = commit_hash;
-	row.tree_hash = containing_tree_hash;
+	git_oid_cpy(&row.commit_id, &commit.id);
+	row.has_commit = true;
+	git_oid_cpy(&row.tree_id, containing_tree);
+	row.has_tree = true;
 	row.file_path = path;
 	row.file_ext = "";
-	row.ref = commit_hash;
-	row.blob_hash = "0000000000000000000000000000000000000000";
-	row.commit_date = commit_date;
+	row.ref = commit.hash;
+	row.commit_date = commit.date;
 	row.mode = mode;
 	row.size_bytes = 0;
 	row.kind = "tree";
@@ -150,19 +163,19 @@ static inline void EmitTreeRow(vector<GitTreeRow> &out, const string &repo_path,
 	out.push_back(std::move(row));
 }
 
-static inline void EmitSubmoduleRow(vector<GitTreeRow> &out, const string &repo_path, const string &commit_hash,
-                                    const string &containing_tree_hash, const string &path, timestamp_t commit_date,
-                                    int32_t mode) {
+static inline void EmitSubmoduleRow(vector<GitTreeRow> &out, const string &repo_path, const GitTreeCommit &commit,
+                                    const git_oid *containing_tree, const string &path, int32_t mode) {
 	GitTreeRow row;
-	row.git_uri = BuildGitFileUri(repo_path, path, commit_hash);
+	row.git_uri = BuildGitFileUri(repo_path, path, commit.hash);
 	row.repo_path = repo_path;
-	row.commit_hash = commit_hash;
-	row.tree_hash = containing_tree_hash;
+	git_oid_cpy(&row.commit_id, &commit.id);
+	row.has_commit = true;
+	git_oid_cpy(&row.tree_id, containing_tree);
+	row.has_tree = true;
 	row.file_path = path;
 	row.file_ext = "";
-	row.ref = commit_hash;
-	row.blob_hash = string();
-	row.commit_date = commit_date;
+	row.ref = commit.hash;
+	row.commit_date = commit.date;
 	row.mode = mode;
 	row.size_bytes = 0;
 	row.kind = "submodule";
@@ -171,9 +184,9 @@ static inline void EmitSubmoduleRow(vector<GitTreeRow> &out, const string &repo_
 	out.push_back(std::move(row));
 }
 
-static inline void EmitFileRow(vector<GitTreeRow> &out, const string &repo_path, const string &commit_hash,
-                               const string &containing_tree_hash, const string &path, timestamp_t commit_date,
-                               int32_t mode, git_repository *repo, const git_oid *blob_oid) {
+static inline void EmitFileRow(vector<GitTreeRow> &out, const string &repo_path, const GitTreeCommit &commit,
+                               const git_oid *containing_tree, const string &path, int32_t mode, git_repository *repo,
+                               const git_oid *blob_oid) {
 	int64_t size_bytes = 0;
 	bool is_text = false;
 	string encoding = "unknown";
@@ -185,15 +198,20 @@ static inline void EmitFileRow(vector<GitTreeRow> &out, const string &repo_path,
 		git_blob_free(blob);
 	}
 	GitTreeRow row;
-	row.git_uri = BuildGitFileUri(repo_path, path, commit_hash);
+	row.git_uri = BuildGitFileUri(repo_path, path, commit.hash);
 	row.repo_path = repo_path;
-	row.commit_hash = commit_hash;
-	row.tree_hash = containing_tree_hash;
+	git_oid_cpy(&row.commit_id, &commit.id);
+	row.has_commit = true;
+	git_oid_cpy(&row.tree_id, containing_tree);
+	row.has_tree = true;
 	row.file_path = path;
 	row.file_ext = ExtractFileExtension(path);
-	row.ref = commit_hash;
-	row.blob_hash = blob_oid ? oid_to_hex(blob_oid) : string();
-	row.commit_date = commit_date;
+	row.ref = commit.hash;
+	if (blob_oid) {
+		git_oid_cpy(&row.blob_id, blob_oid);
+		row.has_blob = true;
+	}
+	row.commit_date = commit.date;
 	row.mode = mode;
 	row.size_bytes = size_bytes;
 	row.kind = "file";
@@ -207,7 +225,7 @@ static inline void EmitFileRow(vector<GitTreeRow> &out, const string &repo_path,
 //===--------------------------------------------------------------------===//
 
 static void traverse_tree(git_repository *repo, git_tree *tree, const string &base, vector<GitTreeRow> &out,
-                          const string &commit_hash, timestamp_t commit_date, const string &repo_path) {
+                          const GitTreeCommit &commit, const string &repo_path) {
 	const size_t count = git_tree_entrycount(tree);
 	for (size_t i = 0; i < count; ++i) {
 		const git_tree_entry *entry = git_tree_entry_byindex(tree, i);
@@ -233,23 +251,18 @@ static void traverse_tree(git_repository *repo, git_tree *tree, const string &ba
 				break;
 			}
 
-			// Get the tree containing this entry
-			string tree_hash = oid_to_hex(git_tree_id(tree));
-
-			// Create file row using the EmitFileRow helper
-			EmitFileRow(out, repo_path, commit_hash, tree_hash, path, commit_date, mode, repo, oid);
+			// Create file row using the EmitFileRow helper; the row's tree is the one containing this entry
+			EmitFileRow(out, repo_path, commit, git_tree_id(tree), path, mode, repo, oid);
 
 		} else if (type == GIT_OBJECT_TREE) {
-			string containing = oid_to_hex(git_tree_id(tree));
-			EmitTreeRow(out, repo_path, commit_hash, containing, path, commit_date, mode);
+			EmitTreeRow(out, repo_path, commit, git_tree_id(tree), path, mode);
 			git_tree *subtree = nullptr;
 			if (git_tree_lookup(&subtree, repo, oid) == 0 && subtree) {
-				traverse_tree(repo, subtree, path, out, commit_hash, commit_date, repo_path);
+				traverse_tree(repo, subtree, path, out, commit, repo_path);
 				git_tree_free(subtree);
 			}
 		} else if (type == GIT_OBJECT_COMMIT) {
-			string containing = oid_to_hex(git_tree_id(tree));
-			EmitSubmoduleRow(out, repo_path, commit_hash, containing, path, commit_date, mode);
+			EmitSubmoduleRow(out, repo_path, commit, git_tree_id(tree), path, mode);
 		}
 	}
 }
@@ -273,24 +286,23 @@ static void ProcessSingleCommit(git_repository *repo, const string &ref, const s
 		throw BinderException("git_tree: failed to get commit for ref '%s' in repository '%s'", ref, repo_path);
 	}
 
-	string commit_hash = oid_to_hex(git_commit_id(commit));
-	timestamp_t commit_date = Timestamp::FromEpochSeconds(git_commit_time(commit));
+	GitTreeCommit tree_commit(commit);
 
 	git_tree *tree = nullptr;
 	if (git_commit_tree(&tree, commit) != 0) {
 		git_commit_free(commit);
 		git_object_free(obj);
-		throw BinderException("git_tree: failed to get tree for commit '%s' in repository '%s'", commit_hash,
+		throw BinderException("git_tree: failed to get tree for commit '%s' in repository '%s'", tree_commit.hash,
 		                      repo_path);
 	}
 
 	// Path filtering logic
 	if (requested_path.empty()) {
-		traverse_tree(repo, tree, "", rows, commit_hash, commit_date, repo_path);
+		traverse_tree(repo, tree, "", rows, tree_commit, repo_path);
 	} else {
 		string norm = NormalizeRepoPathSpec(requested_path);
 		if (norm.empty()) {
-			traverse_tree(repo, tree, "", rows, commit_hash, commit_date, repo_path);
+			traverse_tree(repo, tree, "", rows, tree_commit, repo_path);
 		} else {
 			git_tree_entry *path_entry = nullptr;
 			int error = git_tree_entry_bypath(&path_entry, tree, norm.c_str());
@@ -298,18 +310,18 @@ static void ProcessSingleCommit(git_repository *repo, const string &ref, const s
 				git_object_t etype = git_tree_entry_type(path_entry);
 				int32_t mode = git_tree_entry_filemode(path_entry);
 				const git_oid *eoid = git_tree_entry_id(path_entry);
-				string parent_tree_hash = oid_to_hex(git_tree_id(tree));
+				const git_oid *parent_tree_id = git_tree_id(tree);
 				if (etype == GIT_OBJECT_TREE) {
-					EmitTreeRow(rows, repo_path, commit_hash, parent_tree_hash, norm, commit_date, mode);
+					EmitTreeRow(rows, repo_path, tree_commit, parent_tree_id, norm, mode);
 					git_tree *subtree = nullptr;
 					if (git_tree_lookup(&subtree, repo, eoid) == 0 && subtree) {
-						traverse_tree(repo, subtree, norm, rows, commit_hash, commit_date, repo_path);
+						traverse_tree(repo, subtree, norm, rows, tree_commit, repo_path);
 						git_tree_free(subtree);
 					}
 				} else if (etype == GIT_OBJECT_BLOB) {
-					EmitFileRow(rows, repo_path, commit_hash, parent_tree_hash, norm, commit_date, mode, repo, eoid);
+					EmitFileRow(rows, repo_path, tree_commit, parent_tree_id, norm, mode, repo, eoid);
 				} else if (etype == GIT_OBJECT_COMMIT) {
-					EmitSubmoduleRow(rows, repo_path, commit_hash, parent_tree_hash, norm, commit_date, mode);
+					EmitSubmoduleRow(rows, repo_path, tree_commit, parent_tree_id, norm, mode);
 				}
 				git_tree_entry_free(path_entry);
 			}
@@ -325,14 +337,42 @@ static void ProcessSingleCommit(git_repository *repo, const string &ref, const s
 // WORKDIR tree: walk HEAD's tree + optionally add untracked files
 //===--------------------------------------------------------------------===//
 
-static void ProcessWorkdirTree(git_repository *repo, const string &repo_path, const string &requested_path,
-                               bool include_untracked, vector<GitTreeRow> &rows) {
+// Replaces blob_hash of WORKDIR file rows [first, rows.size()) with the hash of
+// the on-disk content; rows whose file cannot be hashed get a NULL hash.
+// `fast` only picks the SHA-1 implementation (duck_tails_fast_hash).
+static void HashWorkdirRows(ClientContext &context, git_repository *repo, const string &repo_path,
+                            const string &workdir, bool fast, idx_t max_threads, vector<GitTreeRow> &rows,
+                            idx_t first) {
+	vector<idx_t> file_rows;
+	vector<string> rel_paths;
+	for (idx_t i = first; i < rows.size(); i++) {
+		if (rows[i].kind == "file") {
+			file_rows.push_back(i);
+			rel_paths.push_back(rows[i].file_path);
+		}
+	}
+	vector<git_oid> oids;
+	vector<bool> ok;
+	HashWorktreeFilesParallel(context, repo, repo_path, workdir, rel_paths, fast, max_threads, oids, ok);
+	for (idx_t i = 0; i < file_rows.size(); i++) {
+		auto &row = rows[file_rows[i]];
+		row.has_blob = ok[i];
+		if (ok[i]) {
+			git_oid_cpy(&row.blob_id, &oids[i]);
+		}
+	}
+}
+
+static void ProcessWorkdirTree(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const string &requested_path, bool include_untracked, bool fast_hash, idx_t max_threads,
+                               vector<GitTreeRow> &rows) {
 	const char *workdir = git_repository_workdir(repo);
 	if (!workdir) {
 		throw IOException("git_tree: repository '%s' is bare (no working directory)", repo_path);
 	}
 	string workdir_str(workdir);
 	LocalFileSystem local_fs;
+	idx_t first_row = rows.size();
 
 	// Walk HEAD's tree to get tracked files
 	git_object *head_obj = nullptr;
@@ -345,15 +385,14 @@ static void ProcessWorkdirTree(git_repository *repo, const string &repo_path, co
 				// For each tracked file, emit a row with disk metadata
 				// We use the tree traversal but override metadata from disk
 				vector<GitTreeRow> tracked_rows;
-				string commit_hash = oid_to_hex(git_commit_id(commit));
-				timestamp_t commit_date = Timestamp::FromEpochSeconds(git_commit_time(commit));
+				GitTreeCommit tree_commit(commit);
 
 				if (requested_path.empty()) {
-					traverse_tree(repo, tree, "", tracked_rows, commit_hash, commit_date, repo_path);
+					traverse_tree(repo, tree, "", tracked_rows, tree_commit, repo_path);
 				} else {
 					string norm = NormalizeRepoPathSpec(requested_path);
 					if (norm.empty()) {
-						traverse_tree(repo, tree, "", tracked_rows, commit_hash, commit_date, repo_path);
+						traverse_tree(repo, tree, "", tracked_rows, tree_commit, repo_path);
 					} else {
 						git_tree_entry *path_entry = nullptr;
 						if (git_tree_entry_bypath(&path_entry, tree, norm.c_str()) == 0 && path_entry) {
@@ -361,13 +400,11 @@ static void ProcessWorkdirTree(git_repository *repo, const string &repo_path, co
 								const git_oid *eoid = git_tree_entry_id(path_entry);
 								git_tree *subtree = nullptr;
 								if (git_tree_lookup(&subtree, repo, eoid) == 0 && subtree) {
-									traverse_tree(repo, subtree, norm, tracked_rows, commit_hash, commit_date,
-									              repo_path);
+									traverse_tree(repo, subtree, norm, tracked_rows, tree_commit, repo_path);
 									git_tree_free(subtree);
 								}
 							} else if (git_tree_entry_type(path_entry) == GIT_OBJECT_BLOB) {
-								string parent_tree_hash = oid_to_hex(git_tree_id(tree));
-								EmitFileRow(tracked_rows, repo_path, commit_hash, parent_tree_hash, norm, commit_date,
+								EmitFileRow(tracked_rows, repo_path, tree_commit, git_tree_id(tree), norm,
 								            git_tree_entry_filemode(path_entry), repo, git_tree_entry_id(path_entry));
 							}
 							git_tree_entry_free(path_entry);
@@ -389,8 +426,8 @@ static void ProcessWorkdirTree(git_repository *repo, const string &repo_path, co
 							// File may be inaccessible; leave size_bytes as default
 						}
 					}
-					row.commit_hash = ""; // NULL for WORKDIR
-					row.tree_hash = "";   // NULL for WORKDIR
+					row.has_commit = false; // NULL for WORKDIR
+					row.has_tree = false;   // NULL for WORKDIR
 					row.ref = "WORKDIR";
 					row.git_uri = "git://" + repo_path + "/" + row.file_path + "@WORKDIR";
 					rows.push_back(std::move(row));
@@ -479,6 +516,9 @@ static void ProcessWorkdirTree(git_repository *repo, const string &repo_path, co
 			git_status_list_free(status_list);
 		}
 	}
+
+	// Tracked rows carry HEAD's blob ids, which are stale for modified files: hash what is on disk.
+	HashWorkdirRows(context, repo, repo_path, workdir_str, fast_hash, max_threads, rows, first_row);
 }
 
 //===--------------------------------------------------------------------===//
@@ -527,7 +567,8 @@ static void ProcessIndexTree(git_repository *repo, const string &repo_path, cons
 		row.file_path = file_path;
 		row.file_ext = ExtractFileExtension(file_path);
 		row.ref = "STAGED";
-		row.blob_hash = oid_to_hex(&entry->id);
+		git_oid_cpy(&row.blob_id, &entry->id);
+		row.has_blob = true;
 		row.mode = static_cast<int32_t>(entry->mode);
 		row.kind = "file";
 		row.commit_date = Timestamp::FromEpochSeconds(0);
@@ -583,6 +624,10 @@ unique_ptr<FunctionData> GitTreeBind(ClientContext &context, TableFunctionBindIn
 		}
 		result->ref_kind = ctx.ref_kind;
 		result->include_untracked = include_untracked;
+		result->fast_hash = FastHashEnabled(context);
+		result->max_threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+		result->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+		result->return_types = return_types;
 		return std::move(result);
 
 	} catch (const std::exception &e) {
@@ -601,15 +646,35 @@ unique_ptr<FunctionData> GitTreeEachBind(ClientContext &context, TableFunctionBi
 
 	// For LATERAL functions, we create minimal bind data with the ref from parameters
 	// The actual repository path will come from runtime DataChunk input
-	return make_uniq<GitTreeFunctionData>(params.ref, "."); // Use 2-parameter constructor
+	auto result = make_uniq<GitTreeFunctionData>(params.ref, "."); // Use 2-parameter constructor
+	result->gitoid_columns = ApplyGitOidColumns(context, names, return_types);
+	return std::move(result);
 }
 
 //===--------------------------------------------------------------------===//
 // Git Tree Table Functions (copied from git_functions.cpp)
 //===--------------------------------------------------------------------===//
 
+struct GitTreeGlobalState : public GlobalTableFunctionState {
+	GitResultCacheScan result_cache; // commit trees only
+};
+
+// Looks a commit tree up in the result cache; true on a hit.
+static bool BeginCachedCommitTree(ClientContext &context, git_repository *repo, const GitTreeFunctionData &bind_data,
+                                  GitTreeGlobalState &state) {
+	auto cache = GitResultCache::Get(context);
+	git_oid commit_id;
+	if (!cache || !ResolveCommitId(repo, bind_data.ref, commit_id)) {
+		return false;
+	}
+	auto key = GitResultCacheKey("git_tree", bind_data.return_types,
+	                             {bind_data.repo_path, oid_to_hex(&commit_id), bind_data.requested_path});
+	return state.result_cache.Begin(cache, std::move(key), bind_data.return_types);
+}
+
 unique_ptr<GlobalTableFunctionState> GitTreeInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
 	auto &bind_data = const_cast<GitTreeFunctionData &>(input.bind_data->Cast<GitTreeFunctionData>());
+	auto state = make_uniq<GitTreeGlobalState>();
 
 	// Only process for non-dynamic (regular table function) mode
 	if (!bind_data.is_dynamic && bind_data.mode == GitTreeMode::SINGLE) {
@@ -625,14 +690,18 @@ unique_ptr<GlobalTableFunctionState> GitTreeInitGlobal(ClientContext &context, T
 		try {
 			switch (bind_data.ref_kind) {
 			case RefKind::WORKDIR:
-				ProcessWorkdirTree(repo, bind_data.repo_path, bind_data.requested_path, bind_data.include_untracked,
+				ProcessWorkdirTree(context, repo, bind_data.repo_path, bind_data.requested_path,
+				                   bind_data.include_untracked, bind_data.fast_hash, bind_data.max_threads,
 				                   bind_data.rows);
 				break;
 			case RefKind::INDEX:
 				ProcessIndexTree(repo, bind_data.repo_path, bind_data.requested_path, bind_data.rows);
 				break;
 			case RefKind::COMMIT:
-				ProcessSingleCommit(repo, bind_data.ref, bind_data.repo_path, bind_data.requested_path, bind_data.rows);
+				if (!BeginCachedCommitTree(context, repo, bind_data, *state)) {
+					ProcessSingleCommit(repo, bind_data.ref, bind_data.repo_path, bind_data.requested_path,
+					                    bind_data.rows);
+				}
 				break;
 			}
 		} catch (...) {
@@ -646,12 +715,17 @@ unique_ptr<GlobalTableFunctionState> GitTreeInitGlobal(ClientContext &context, T
 		throw BinderException("git_tree: Range mode not yet implemented");
 	}
 
-	return make_uniq<GlobalTableFunctionState>();
+	return std::move(state);
 }
 
 void GitTreeFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<GitTreeFunctionData>();
 	auto &local_state = data_p.local_state->Cast<GitTreeLocalState>();
+	auto &global_state = data_p.global_state->Cast<GitTreeGlobalState>();
+	if (global_state.result_cache.IsHit()) {
+		global_state.result_cache.Replay(output);
+		return;
+	}
 
 	idx_t output_count = 0;
 	const idx_t max_output = STANDARD_VECTOR_SIZE;
@@ -665,6 +739,7 @@ void GitTreeFunction(ClientContext &context, TableFunctionInput &data_p, DataChu
 	}
 
 	output.SetCardinality(output_count);
+	global_state.result_cache.Record(output);
 }
 
 //===--------------------------------------------------------------------===//
@@ -1,8 +1,12 @@
 #include "git_utils.hpp"
 #include "git_filesystem.hpp"
 #include "git_context_manager.hpp"
+#include "git_repo_pool.hpp"
 #include "duckdb/common/types/value.hpp"
 #include "duckdb/common/local_file_system.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <stdlib.h> // _fullpath
@@ -151,4 +155,208 @@ string SafeWorkdirPath(const string &repo_path, const string &file_path) {
 	return canonical;
 }
 
+bool ResolveCommitId(git_repository *repo, const string &ref, git_oid &out) {
+	git_object *obj = nullptr;
+	if (git_revparse_single(&obj, repo, ref.c_str()) != 0) {
+		return false;
+	}
+	git_object *commit = nullptr;
+	bool found = git_object_peel(&commit, obj, GIT_OBJECT_COMMIT) == 0;
+	if (found) {
+		git_oid_cpy(&out, git_object_id(commit));
+		git_object_free(commit);
+	}
+	git_object_free(obj);
+	return found;
+}
+
+bool LookupTreeBlobId(git_object *treeish, const string &file_path, git_oid &out) {
+	git_object *tree_obj = nullptr;
+	if (git_object_peel(&tree_obj, treeish, GIT_OBJECT_TREE) != 0) {
+		return false;
+	}
+	auto tree = MakeGitTree(reinterpret_cast<git_tree *>(tree_obj));
+
+	git_tree_entry *entry = nullptr;
+	if (git_tree_entry_bypath(&entry, tree, file_path.c_str()) != 0) {
+		return false;
+	}
+	auto mode = git_tree_entry_filemode(entry);
+	bool is_file = mode == GIT_FILEMODE_BLOB || mode == GIT_FILEMODE_BLOB_EXECUTABLE;
+	if (is_file) {
+		git_oid_cpy(&out, git_tree_entry_id(entry));
+	}
+	git_tree_entry_free(entry);
+	return is_file;
+}
+
+bool TryGetGitUriBlobId(const string &uri, string &repo_path, git_oid &out) {
+	if (!StringUtil::StartsWith(uri, "git://")) {
+		return false;
+	}
+	GitPath path;
+	try {
+		path = GitPath::Parse(uri);
+	} catch (const std::exception &) {
+		return false;
+	}
+	if (path.is_range) {
+		return false;
+	}
+	string revision = path.revision.empty() ? "HEAD" : path.revision;
+	auto upper = StringUtil::Upper(revision);
+	if (upper == "WORKDIR" || upper == "WORKTREE" || upper == "STAGED" || upper == "INDEX") {
+		return false;
+	}
+
+	ScopedGitRepo repo(path.repository_path);
+	if (!repo.is_valid()) {
+		return false;
+	}
+	git_object *obj = nullptr;
+	if (git_revparse_single(&obj, repo, revision.c_str()) != 0) {
+		return false;
+	}
+	bool found = LookupTreeBlobId(obj, path.file_path, out);
+	git_object_free(obj);
+	repo_path = path.repository_path;
+	return found;
+}
+
+static bool IsRegularBlobMode(uint16_t mode) {
+	return mode == GIT_FILEMODE_BLOB || mode == GIT_FILEMODE_BLOB_EXECUTABLE;
+}
+
+void ApplyRenameParam(const string &name, const Value &value, GitDiffRenameOptions &opts, const char *func_name) {
+	if (name == "renames") {
+		auto mode = StringUtil::Lower(value.GetValue<string>());
+		if (mode == "off") {
+			opts.mode = GitDiffRenameMode::OFF;
+		} else if (mode == "exact") {
+			opts.mode = GitDiffRenameMode::EXACT;
+		} else if (mode == "similar") {
+			opts.mode = GitDiffRenameMode::SIMILAR;
+		} else {
+			throw BinderException("%s: renames must be 'off', 'exact' or 'similar' (got '%s')", func_name,
+			                      value.ToString());
+		}
+	} else if (name == "rename_limit") {
+		opts.rename_limit = value.GetValue<int64_t>();
+		if (opts.rename_limit < 0) {
+			throw BinderException("%s: rename_limit must be >= 0", func_name);
+		}
+	} else if (name == "similarity_threshold") {
+		opts.similarity_threshold = value.GetValue<int64_t>();
+		if (opts.similarity_threshold < 0 || opts.similarity_threshold > 100) {
+			throw BinderException("%s: similarity_threshold must be between 0 and 100", func_name);
+		}
+	}
+}
+
+vector<GitExactRename> DetectRenames(git_repository *repo, git_diff *diff, const GitDiffRenameOptions &opts,
+                                     const char *func_name) {
+	if (opts.mode == GitDiffRenameMode::EXACT) {
+		return FindExactRenames(repo, diff);
+	}
+	if (opts.mode == GitDiffRenameMode::SIMILAR) {
+		git_diff_find_options find_opts = GIT_DIFF_FIND_OPTIONS_INIT;
+		find_opts.flags = GIT_DIFF_FIND_RENAMES | GIT_DIFF_FIND_COPIES;
+		if (opts.rename_limit > 0) {
+			find_opts.rename_limit = static_cast<size_t>(opts.rename_limit);
+		}
+		if (opts.similarity_threshold >= 0) {
+			// libgit2 reads a threshold of 0 as "use the default"; 1 is the
+			// same filter, since pairs scored 0 share no content at all.
+			auto threshold = static_cast<uint16_t>(MaxValue<int64_t>(opts.similarity_threshold, 1));
+			find_opts.rename_threshold = threshold;
+			find_opts.copy_threshold = threshold;
+		}
+		if (git_diff_find_similar(diff, &find_opts) != 0) {
+			const git_error *e = git_error_last();
+			throw IOException("%s: rename detection failed: %s", func_name, e ? e->message : "unknown error");
+		}
+	}
+	return vector<GitExactRename>();
+}
+
+vector<GitExactRename> FindExactRenames(git_repository *repo, git_diff *diff) {
+	vector<GitExactRename> renames;
+	size_t num_deltas = git_diff_num_deltas(diff);
+	std::unordered_map<git_oid, vector<idx_t>, GitOidHash, GitOidEqual> deleted_by_id;
+	for (size_t i = 0; i < num_deltas; i++) {
+		const git_diff_delta *delta = git_diff_get_delta(diff, i);
+		if (delta && delta->status == GIT_DELTA_DELETED && IsRegularBlobMode(delta->old_file.mode) &&
+		    !git_oid_is_zero(&delta->old_file.id)) {
+			deleted_by_id[delta->old_file.id].push_back(i);
+		}
+	}
+	if (deleted_by_id.empty()) {
+		return renames;
+	}
+
+	const char *workdir = git_repository_workdir(repo);
+	vector<bool> consumed(num_deltas, false);
+	for (size_t i = 0; i < num_deltas; i++) {
+		const git_diff_delta *delta = git_diff_get_delta(diff, i);
+		if (!delta || (delta->status != GIT_DELTA_ADDED && delta->status != GIT_DELTA_UNTRACKED) ||
+		    !IsRegularBlobMode(delta->new_file.mode) || !delta->new_file.path) {
+			continue;
+		}
+		git_oid id;
+		if ((delta->new_file.flags & GIT_DIFF_FLAG_VALID_ID) && !git_oid_is_zero(&delta->new_file.id)) {
+			git_oid_cpy(&id, &delta->new_file.id);
+		} else {
+			if (!workdir) {
+				continue;
+			}
+			string full_path = string(workdir) + delta->new_file.path;
+			if (git_repository_hashfile(&id, repo, full_path.c_str(), GIT_OBJECT_BLOB, delta->new_file.path) != 0) {
+				continue;
+			}
+		}
+
+		auto entry = deleted_by_id.find(id);
+		if (entry == deleted_by_id.end()) {
+			continue;
+		}
+		for (auto candidate : entry->second) {
+			if (!consumed[candidate]) {
+				consumed[candidate] = true;
+				renames.push_back(GitExactRename {i, candidate, id});
+				break;
+			}
+		}
+	}
+	return renames;
+}
+
+class ParallelWorkerTask : public BaseExecutorTask {
+public:
+	ParallelWorkerTask(TaskExecutor &executor, const std::function<void(idx_t)> &work, idx_t worker)
+	    : BaseExecutorTask(executor), work(work), worker(worker) {
+	}
+
+	void ExecuteTask() override {
+		work(worker);
+	}
+
+private:
+	const std::function<void(idx_t)> &work;
+	idx_t worker;
+};
+
+void RunParallelWorkers(ClientContext &context, idx_t num_workers, const std::function<void(idx_t worker)> &work) {
+	if (num_workers <= 1) {
+		if (num_workers == 1) {
+			work(0);
+		}
+		return;
+	}
+	TaskExecutor executor(context);
+	for (idx_t worker = 0; worker < num_workers; worker++) {
+		executor.ScheduleTask(make_uniq<ParallelWorkerTask>(executor, work, worker));
+	}
+	executor.WorkOnTasks();
+}
+
 } // namespace duckdb
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "text_utils.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Line diff algorithms
+//
+// The algorithms work on sequences of line ids: equal lines share an id, and
+// ids are dense in [0, id_count). Like xdiff, they report one "changed" flag
+// per line on each side. Lines flagged on neither side form the common
+// subsequence. Walking both sides in order and emitting flagged old lines
+// before flagged new lines gives the edit script.
+//
+//  myers     - O(ND) Myers with linear-space divide and conquer. Past a cost
+//              bound (like git) it stops insisting on a minimal script, so it
+//              stays fast on very dissimilar inputs
+//  minimal   - Myers without the cost bound
+//  patience  - anchors on lines that are unique on both sides, Myers between
+//  histogram - anchors on the least frequent common lines, Myers fallback
+//
+// Before any algorithm runs, the common prefix and suffix are stripped, and
+// lines that occur on only one side are flagged and dropped, so the
+// algorithms only see lines that can match.
+//===--------------------------------------------------------------------===//
+
+enum class DiffAlgorithm : uint8_t { MYERS = 0, MINIMAL = 1, PATIENCE = 2, HISTOGRAM = 3 };
+
+// Parses an algorithm name (case-insensitive); throws InvalidInputException.
+DiffAlgorithm ParseDiffAlgorithm(const string &name);
+
+// Assigns dense ids to lines so that equal lines share an id. Lines are
+// compared by hash, and by length and memcmp only when the hashes match.
+// Interned lines are not copied: the buffers must outlive the interner.
+class LineInterner {
+public:
+	// `expected_lines`: total lines to be interned, used to size the table
+	explicit LineInterner(idx_t expected_lines);
+
+	void Intern(const char *data, const vector<LineToken> &lines, vector<uint32_t> &ids);
+	idx_t Count() const {
+		return count;
+	}
+
+private:
+	struct Entry {
+		hash_t hash;
+		const char *data;
+		uint32_t length;
+		uint32_t id;
+	};
+	static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+	void Grow();
+
+	vector<Entry> table;
+	idx_t mask;
+	idx_t count = 0;
+};
+
+void ComputeLineDiff(const vector<uint32_t> &old_ids, const vector<uint32_t> &new_ids, idx_t id_count,
+                     DiffAlgorithm algorithm, vector<uint8_t> &old_changed, vector<uint8_t> &new_changed);
+
+} // namespace duckdb
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "text_diff.hpp"
+#include "text_utils.hpp"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//===--------------------------------------------------------------------===//
+// DiffCache — memoized text diffs
+//
+// Process-wide LRU cache of diffs keyed by a 128-bit content hash and the
+// size of both inputs plus the diff options, so a pair that shows up again
+// (cherry-picks, reverts, the same file on several branches, a re-run query)
+// is not diffed twice. The hash is not cryptographic, so entries keep their
+// inputs and a hit is confirmed by comparing them. Entries hold the packed
+// TEXTDIFF layout, and the budget counts the inputs and the diff. Off by
+// default; SET duck_tails_diff_cache_size = '256MB' enables it with that
+// memory budget for every connection.
+//===--------------------------------------------------------------------===//
+
+struct DiffCacheKey {
+	ContentHash old_hash;
+	ContentHash new_hash;
+	idx_t old_size;
+	idx_t new_size;
+	TextDiff::Options options;
+
+	bool operator==(const DiffCacheKey &other) const {
+		return old_hash == other.old_hash && new_hash == other.new_hash && old_size == other.old_size &&
+		       new_size == other.new_size && options == other.options;
+	}
+};
+
+struct DiffCacheKeyHash {
+	size_t operator()(const DiffCacheKey &key) const {
+		// Content hashes are already uniformly distributed
+		return key.old_hash.low ^ (key.new_hash.low * 0x9e3779b97f4a7c15ULL) ^
+		       (static_cast<size_t>(key.options.algorithm) << 8) ^ static_cast<size_t>(key.options.context_lines);
+	}
+};
+
+class DiffCache {
+public:
+	static DiffCache &Instance();
+
+	// The cache, or nullptr while duck_tails_diff_cache_size is 0 (disabled).
+	// The budget is process-wide: it changes only when the setting is SET.
+	static optional_ptr<DiffCache> Get(ClientContext &context);
+
+	// The cached diff of exactly these inputs, or nullptr
+	shared_ptr<const PackedTextDiff> Lookup(const DiffCacheKey &key, const char *old_data, const char *new_data);
+	void Insert(const DiffCacheKey &key, const char *old_data, const char *new_data,
+	            shared_ptr<const PackedTextDiff> diff);
+	// Evicts least recently used diffs until the cache fits `bytes`
+	void SetCapacity(idx_t bytes);
+	idx_t Capacity();
+
+private:
+	DiffCache() = default;
+
+	struct Entry {
+		DiffCacheKey key;
+		string old_text; // inputs, to confirm a hash match
+		string new_text;
+		shared_ptr<const PackedTextDiff> diff;
+		idx_t size;
+	};
+	void EvictToCapacity();
+
+	std::mutex lock;
+	std::list<Entry> lru; // most recently used first
+	std::unordered_map<DiffCacheKey, std::list<Entry>::iterator, DiffCacheKeyHash> entries;
+	idx_t capacity = 0;
+	idx_t size = 0;
+};
+
+// Diffs the two buffers, through `cache` when it is set
+shared_ptr<const PackedTextDiff> CachedTextDiff(optional_ptr<DiffCache> cache, const char *old_data, idx_t old_size,
+                                                const char *new_data, idx_t new_size,
+                                                const TextDiff::Options &options);
+
+// Memory budget in a memory_limit style setting ('256MB'); 0 when unset or '0'
+idx_t ParseCacheSize(const Value &value);
+
+// Registers the duck_tails_diff_cache_size setting.
+void RegisterDiffCacheSettings(ExtensionLoader &loader);
+
+} // namespace duckdb
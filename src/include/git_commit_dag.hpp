@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "git_commit_graph_file.hpp"
+#include "git_utils.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+// Parents and committer time of a commit, parsed from the object header only
+// (author, message and signatures are skipped). False if the object cannot be
+// read or is not a commit.
+bool ReadCommitHeader(git_odb *odb, const git_oid &oid, vector<git_oid> &parents, int64_t &commit_time);
+
+//===--------------------------------------------------------------------===//
+// GitCommitDag — lazily loaded commit graph with generation numbers
+//
+// Commits are numbered as they are first seen. Parents and generation
+// numbers (topological levels) come from the commit-graph file when the
+// commit is in it and from the object database otherwise; generations of
+// commits newer than the commit-graph are computed on demand from their
+// parents. A generation strictly decreases from child to parent, which is
+// what lets the walks below stop early.
+//===--------------------------------------------------------------------===//
+
+class GitCommitDag {
+public:
+	explicit GitCommitDag(git_repository *repo);
+	~GitCommitDag();
+	GitCommitDag(const GitCommitDag &) = delete;
+	GitCommitDag &operator=(const GitCommitDag &) = delete;
+
+	idx_t Node(const git_oid &oid);
+	const git_oid &Id(idx_t node) const {
+		return nodes[node].id;
+	}
+	idx_t Size() const {
+		return nodes.size();
+	}
+	bool HasCommitGraph() const {
+		return graph != nullptr;
+	}
+
+	// Parent nodes, loaded on first use. Commits that cannot be read (e.g.
+	// the boundary of a shallow clone) have no parents. The reference is
+	// invalidated by the next call that adds nodes.
+	const vector<idx_t> &Parents(idx_t node);
+	uint32_t Generation(idx_t node);
+	// Committer time; 0 for commits that cannot be read
+	int64_t CommitTime(idx_t node);
+
+private:
+	struct DagNode {
+		git_oid id;
+		vector<idx_t> parents;
+		uint32_t generation = 0; // 0 = not yet known
+		int64_t commit_time = 0; // known once parents are loaded (or from the commit-graph)
+		idx_t graph_pos = DConstants::INVALID_INDEX;
+		bool parents_loaded = false;
+	};
+
+	git_odb *odb = nullptr;
+	unique_ptr<GitCommitGraphFile> graph;
+	vector<DagNode> nodes;
+	unordered_map<git_oid, idx_t, GitOidHash, GitOidEqual> index;
+};
+
+struct GitAheadBehind {
+	int64_t ahead = 0;  // commits reachable from the tip but not from the base
+	int64_t behind = 0; // commits reachable from the base but not from the tip
+};
+
+// Ahead/behind counts of every tip against `base`. Tips are processed 63 at
+// a time: each walk carries one bit per tip plus one for the base, visits
+// commits in decreasing generation order and stops as soon as every queued
+// commit is reachable from all of them.
+void ComputeAheadBehind(GitCommitDag &dag, idx_t base, const vector<idx_t> &tips, vector<GitAheadBehind> &out);
+
+} // namespace duckdb
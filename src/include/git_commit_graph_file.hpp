@@ -0,0 +1,59 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// GitCommitGraphFile — read-only view of git's commit-graph file(s)
+//
+// Reads objects/info/commit-graph or a split chain under
+// objects/info/commit-graphs/. libgit2 keeps its own reader private, and it
+// does not expose generation numbers, which the graph algorithms here rely
+// on. Positions are global across the layers of a chain (base layer first),
+// matching how parent positions are stored in the file.
+//===--------------------------------------------------------------------===//
+
+class GitCommitGraphFile {
+public:
+	// Loads the commit-graph below `objects_dir` (with trailing slash).
+	// Returns nullptr when there is none or it fails validation.
+	static unique_ptr<GitCommitGraphFile> Open(const string &objects_dir);
+
+	idx_t CommitCount() const {
+		return total_count;
+	}
+	idx_t LayerCount() const {
+		return layers.size();
+	}
+
+	bool Find(const git_oid &oid, idx_t &pos) const;
+	void CommitId(idx_t pos, git_oid &out) const;
+	void TreeId(idx_t pos, git_oid &out) const;
+	// Topological level: 1 for root commits, 1 + max(parents) otherwise; 0 if not computed.
+	uint32_t Generation(idx_t pos) const;
+	int64_t CommitTime(idx_t pos) const;
+	// Appends parent positions; false if the parent data is corrupt.
+	bool Parents(idx_t pos, vector<idx_t> &parents) const;
+
+private:
+	struct Layer {
+		string data;
+		idx_t base = 0;  // global position of this layer's first commit
+		idx_t count = 0; // commits in this layer
+		const uint8_t *fanout = nullptr;
+		const uint8_t *oids = nullptr;
+		const uint8_t *commit_data = nullptr;
+		const uint8_t *edges = nullptr;
+		idx_t edge_count = 0;
+	};
+
+	static bool LoadLayer(const string &path, Layer &layer);
+	const Layer &LayerOf(idx_t pos, idx_t &local) const;
+
+	vector<unique_ptr<Layer>> layers;
+	idx_t total_count = 0;
+};
+
+} // namespace duckdb
@@ -17,6 +17,7 @@ struct GitLogFunctionData : public TableFunctionData {
 	string resolved_repo_path; // Absolute path to repository
 	string ref;                // Reference for LATERAL functions
 	string file_path;          // File path for filtering (from git URI)
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
 };
 
 void GitLogFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output);
@@ -29,7 +30,7 @@ unique_ptr<GlobalTableFunctionState> GitLogInitGlobal(ClientContext &context, Ta
 // Git log row structure for LATERAL processing
 struct GitLogRow {
 	string repo_path;
-	string commit_hash;
+	git_oid commit_id;
 	string author_name;
 	string author_email;
 	string committer_name;
@@ -38,12 +39,12 @@ struct GitLogRow {
 	timestamp_t commit_date;
 	string message;
 	uint32_t parent_count;
-	string tree_hash;
+	git_oid tree_id;
 
 	// Constructor to ensure proper initialization
 	GitLogRow()
-	    : repo_path(""), commit_hash(""), author_name(""), author_email(""), committer_name(""), committer_email(""),
-	      author_date(timestamp_t(0)), commit_date(timestamp_t(0)), message(""), parent_count(0), tree_hash("") {
+	    : repo_path(""), commit_id(), author_name(""), author_email(""), committer_name(""), committer_email(""),
+	      author_date(timestamp_t(0)), commit_date(timestamp_t(0)), message(""), parent_count(0), tree_id() {
 	}
 };
 
@@ -84,12 +85,18 @@ unique_ptr<LocalTableFunctionState> GitLogLocalInit(ExecutionContext &context, T
 struct GitBranchesRow {
 	string repo_path;
 	string branch_name;
-	string commit_hash;
+	git_oid commit_id;
+	bool has_commit; // false for a symbolic branch (commit_hash is then empty)
 	bool is_current;
 	bool is_remote;
+	int64_t ahead;  // compare_to only; -1 when the tip could not be compared
+	int64_t behind; // compare_to only
+	bool is_merged; // compare_to only: tip is reachable from the comparison commit
 
 	// Constructor to ensure proper initialization
-	GitBranchesRow() : repo_path(""), branch_name(""), commit_hash(""), is_current(false), is_remote(false) {
+	GitBranchesRow()
+	    : repo_path(""), branch_name(""), commit_id(), has_commit(false), is_current(false), is_remote(false),
+	      ahead(-1), behind(-1), is_merged(false) {
 	}
 };
 
@@ -101,6 +108,8 @@ struct GitBranchesFunctionData : public TableFunctionData {
 	string repo_path;          // Original input path
 	string resolved_repo_path; // Absolute path to repository
 	string ref;                // Reference for LATERAL functions
+	string compare_to;         // Revision for ahead/behind/is_merged columns (empty: not requested)
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
 };
 
 // Local state for git_branches (per-thread resources)
@@ -113,7 +122,7 @@ struct GitBranchesLocalState : public LocalTableFunctionState {
 	string cached_repo_path;
 	git_repository *cached_repo = nullptr;
 
-	// LATERAL processing state
+	// LATERAL processing state (also holds the materialized rows for compare_to)
 	vector<GitBranchesRow> current_rows;
 	idx_t current_input_row = 0;
 	idx_t current_output_row = 0;
@@ -147,8 +156,10 @@ unique_ptr<GlobalTableFunctionState> GitBranchesInitGlobal(ClientContext &contex
 struct GitTagsRow {
 	string repo_path;
 	string tag_name;
-	string commit_hash;
-	string tag_hash;
+	git_oid commit_id;
+	git_oid tag_id;
+	bool has_commit; // commit_hash and tag_hash are empty when false
+	bool has_tag;
 	string tagger_name;
 	timestamp_t tagger_date;
 	string message;
@@ -156,8 +167,8 @@ struct GitTagsRow {
 
 	// Constructor to ensure proper initialization
 	GitTagsRow()
-	    : repo_path(""), tag_name(""), commit_hash(""), tag_hash(""), tagger_name(""), tagger_date(timestamp_t(0)),
-	      message(""), is_annotated(false) {
+	    : repo_path(""), tag_name(""), commit_id(), tag_id(), has_commit(false), has_tag(false), tagger_name(""),
+	      tagger_date(timestamp_t(0)), message(""), is_annotated(false) {
 	}
 };
 
@@ -169,6 +180,7 @@ struct GitTagsFunctionData : public TableFunctionData {
 	string repo_path;          // Original input path
 	string resolved_repo_path; // Absolute path to repository
 	string ref;                // Reference for LATERAL functions
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
 };
 
 // Local state for git_tags (per-thread resources)
@@ -232,17 +244,24 @@ struct GitTreeFunctionData : public TableFunctionData {
 	bool is_dynamic;                // True if parameter comes from LATERAL
 	RefKind ref_kind = RefKind::COMMIT;
 	bool include_untracked = false;
+	bool fast_hash = false; // duck_tails_fast_hash: WORKDIR blob_hash is hashed from disk
+	idx_t max_threads = 1;
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+	vector<LogicalType> return_types; // Output columns, part of result cache keys
 };
 
 struct GitTreeRow {
 	string git_uri;          // Renamed from git_file_uri - complete git:// URI
 	string repo_path;        // NEW - repository filesystem path
-	string commit_hash;      // Git commit hash
-	string tree_hash;        // NEW - Git tree hash containing the file
+	git_oid commit_id;       // Git commit hash
+	git_oid tree_id;         // NEW - Git tree hash containing the file
+	git_oid blob_id;         // Git blob hash of file content
+	bool has_commit = false; // commit_hash is NULL when false (WORKDIR/STAGED)
+	bool has_tree = false;   // tree_hash is NULL when false
+	bool has_blob = false;   // blob_hash is NULL when false
 	string file_path;        // File path within repository (extracted from URI)
 	string file_ext;         // File extension (e.g., .js, .cpp, .md)
 	string ref;              // Git reference (SHA/branch/tag)
-	string blob_hash;        // Git blob hash of file content
 	timestamp_t commit_date; // Commit timestamp
 	int32_t mode;            // File mode
 	int64_t size_bytes;      // Renamed from size - file size in bytes
@@ -283,12 +302,13 @@ struct GitParentsFunctionData : public TableFunctionData {
 	string repo_path;
 	bool all_refs;
 	bool is_array_mode;
-	vector<struct GitParentsRow> rows; // Read-only after bind (thread-safe)
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
+	vector<LogicalType> return_types; // Output columns, part of result cache keys
 };
 
 struct GitParentsRow {
-	string commit_hash;
-	string parent_hash;
+	git_oid commit_id;
+	git_oid parent_id;
 	int32_t parent_index;
 };
 
@@ -296,8 +316,6 @@ void GitParentsFunction(ClientContext &context, TableFunctionInput &data_p, Data
 
 // Local state for git_parents (per-thread iteration state)
 struct GitParentsLocalState : public LocalTableFunctionState {
-	idx_t current_index = 0; // Per-thread iteration through bind_data.rows
-
 	// LATERAL processing state
 	vector<GitParentsRow> current_rows;
 	idx_t current_input_row = 0;
@@ -310,6 +328,7 @@ struct GitParentsLocalState : public LocalTableFunctionState {
 struct GitParentsEachBindData : public TableFunctionData {
 	string repo_path; // Bind-time repository path
 	string ref;       // Fallback ref for GitContextManager
+	vector<column_t> gitoid_columns; // *_hash columns emitted as GITOID (duck_tails_gitoid)
 };
 
 // Function declarations for git_parents_each
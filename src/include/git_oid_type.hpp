@@ -0,0 +1,45 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//===--------------------------------------------------------------------===//
+// GITOID — object ids as 20 raw bytes
+//
+// GITOID is a BLOB alias holding the binary SHA-1, half the size of the hex
+// VARCHAR the table functions emit by default, so joins on hashes compare
+// and hash 20 bytes instead of 40. Casts to and from VARCHAR convert hex;
+// gitoid_has_prefix() matches abbreviated hashes without converting.
+//
+// With SET duck_tails_gitoid = true every *_hash column of the git table
+// functions is emitted as GITOID. Scans write ids with SetGitOid(), which
+// stores the raw bytes straight into a GITOID column and the hex into a
+// VARCHAR one; FinalizeGitOidColumns() converts whatever hex is left.
+//===--------------------------------------------------------------------===//
+
+LogicalType GitOidLogicalType();
+
+// Registers the GITOID type, its casts, gitoid_has_prefix() and the
+// duck_tails_gitoid setting.
+void RegisterGitOidType(ExtensionLoader &loader);
+
+// Bind: switches every VARCHAR column named *_hash to GITOID when
+// duck_tails_gitoid is on. Returns the indexes of the switched columns.
+vector<column_t> ApplyGitOidColumns(ClientContext &context, const vector<string> &names,
+                                    vector<LogicalType> &return_types);
+
+// Scan: writes `oid` into row `row` of a flat *_hash column, as raw bytes if
+// the column is GITOID and as hex otherwise. A null `oid` writes NULL.
+void SetGitOid(Vector &vector, idx_t row, const git_oid *oid);
+
+// Scan: converts the hex still written into `columns` (e.g. ids kept as hex
+// strings) to binary ids; values SetGitOid() wrote raw are left alone.
+// Other values that are not full object ids (e.g. an empty hash) become NULL.
+void FinalizeGitOidColumns(DataChunk &output, const vector<column_t> &columns);
+
+} // namespace duckdb
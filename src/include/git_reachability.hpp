@@ -0,0 +1,88 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "git_ref_watcher.hpp"
+#include "git_utils.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// GitReachabilityIndex — immutable ancestry labels for one repository
+//
+// Covers every commit reachable from a ref (or HEAD) when it was built.
+// Each commit carries its generation number, the [pre, post] interval of a
+// depth-first spanning tree over parent edges (positive cut: a commit inside
+// another's tree interval is its ancestor) and the smallest post-order number
+// reachable from it (negative cut: a commit outside [low, post] of another is
+// not its ancestor). Only pairs that pass all three filters need a walk, and
+// that walk is pruned by the same labels.
+//
+// Indexes are shared across queries and threads through Get(), which rebuilds
+// one when the repository's refs have changed since it was built. With the ref
+// watcher on, an unchanged ref generation skips reading the refs altogether.
+// Builds of different repositories run concurrently; the least recently used
+// indexes are dropped once more than a few repositories are cached.
+//===--------------------------------------------------------------------===//
+
+// Per-thread scratch space for walks over an index.
+struct GitReachabilityScratch {
+	vector<uint32_t> mark;
+	uint32_t epoch = 0;
+	vector<uint32_t> stack;
+	vector<uint8_t> paint; // MergeBase: which side(s) reach each node, plus state bits
+	vector<uint32_t> painted;
+	vector<uint32_t> bases;
+};
+
+class GitReachabilityIndex {
+public:
+	static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+	// Shared index for the repository at `repo_path` (opened as `repo`), which
+	// `watched` (if set) tracks for ref changes.
+	static shared_ptr<const GitReachabilityIndex> Get(git_repository *repo, const string &repo_path,
+	                                                  optional_ptr<GitWatchedRepo> watched = nullptr);
+
+	idx_t CommitCount() const {
+		return ids.size();
+	}
+	uint32_t Find(const git_oid &oid) const {
+		auto it = index.find(oid);
+		return it == index.end() ? NOT_FOUND : it->second;
+	}
+	const git_oid &Id(uint32_t node) const {
+		return ids[node];
+	}
+
+	// True when `ancestor` is reachable from `descendant` (or is the same commit).
+	bool IsAncestor(uint32_t ancestor, uint32_t descendant, GitReachabilityScratch &scratch) const;
+	// A best common ancestor, or NOT_FOUND. Like libgit2's git_merge_base,
+	// the newest (by committer time) of several best ones is returned.
+	uint32_t MergeBase(uint32_t a, uint32_t b, GitReachabilityScratch &scratch) const;
+
+private:
+	static hash_t RefFingerprint(git_repository *repo, vector<git_oid> *tips);
+	void Build(git_repository *repo, const vector<git_oid> &tips);
+	bool TreeContains(uint32_t outer, uint32_t inner) const {
+		return pre[outer] <= pre[inner] && post[inner] <= post[outer];
+	}
+	bool MayReach(uint32_t from, uint32_t to) const {
+		return low[from] <= low[to] && post[to] <= post[from];
+	}
+	void StartWalk(GitReachabilityScratch &scratch) const;
+
+	hash_t fingerprint = 0;
+	vector<git_oid> ids;
+	unordered_map<git_oid, uint32_t, GitOidHash, GitOidEqual> index;
+	vector<uint32_t> parent_offsets; // parents of node i: parents[parent_offsets[i] .. parent_offsets[i + 1])
+	vector<uint32_t> parents;
+	vector<uint32_t> generation;
+	vector<int64_t> commit_time;
+	vector<uint32_t> pre;
+	vector<uint32_t> post;
+	vector<uint32_t> low;
+};
+
+} // namespace duckdb
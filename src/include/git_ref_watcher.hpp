@@ -0,0 +1,99 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <git2.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//===--------------------------------------------------------------------===//
+// GitRefWatcher — inotify-driven ref and index change tracking
+//
+// With SET duck_tails_ref_watcher = true, the repositories used by
+// git_is_ancestor/git_merge_base and git_status are watched by one
+// background thread: HEAD and index in the git directory, packed-refs and
+// every directory below refs/ in the common directory. Each repository has a
+// ref generation and an index generation that the thread bumps as soon as
+// those files change, so caches derived from refs or the index compare a
+// counter instead of re-reading them. With duck_tails_ref_watcher_prewarm
+// the thread also rebuilds those caches right after refs move, before the
+// next query asks. Linux only; elsewhere, and for a repository some
+// directory of which could not be watched, Watch() returns nullptr and
+// callers keep their own checks.
+//
+// The watcher is a function-local static whose destructor joins the thread.
+// Whatever a prewarm callback uses must be constructed before Instance() is
+// first called, so that it is destroyed after the thread has stopped.
+//===--------------------------------------------------------------------===//
+
+struct GitWatchedRepo {
+	string repo_path;
+	string git_dir;    // HEAD, index
+	string common_dir; // packed-refs, refs/
+	std::atomic<uint64_t> ref_generation {0};
+	std::atomic<uint64_t> index_generation {0};
+	std::atomic<bool> prewarm {false};
+	// A refs/ directory created later could not be watched (or events were
+	// lost and the rescan failed): ref moves may go unnoticed, so Watch()
+	// reports the repository as unwatched from then on
+	std::atomic<bool> broken {false};
+};
+
+class GitRefWatcher {
+public:
+	using PrewarmCallback = std::function<void(GitWatchedRepo &repo)>;
+
+	static GitRefWatcher &Instance();
+	~GitRefWatcher();
+
+	// Starts watching `repo` (opened from `repo_path`) unless it already is.
+	// nullptr when inotify is unavailable or a directory cannot be watched.
+	optional_ptr<GitWatchedRepo> Watch(git_repository *repo, const string &repo_path, bool prewarm);
+
+	// Run on the watcher thread once the refs of a repository with prewarm on
+	// have settled after a change.
+	void AddPrewarmCallback(PrewarmCallback callback);
+
+private:
+	GitRefWatcher() = default;
+
+	struct WatchTarget {
+		string path;
+		bool refs_dir; // below refs/: any change moves a ref
+		vector<GitWatchedRepo *> repos;
+	};
+
+	bool Start();
+	void Run();
+	bool AddWatch(const string &path, bool refs_dir, GitWatchedRepo &repo);
+	bool AddRefsTree(const string &path, GitWatchedRepo &repo);
+	void RemoveWatches(GitWatchedRepo &repo);
+	void HandleEvents(const char *buffer, idx_t length, vector<GitWatchedRepo *> &moved);
+	void Prewarm(const vector<GitWatchedRepo *> &repos);
+
+	std::mutex lock;
+	int inotify_fd = -1;
+	int wake_fds[2] = {-1, -1};
+	bool failed = false;
+	std::thread thread;
+	std::unordered_map<string, unique_ptr<GitWatchedRepo>> repos; // by git_dir
+	std::unordered_map<int, WatchTarget> targets;                  // by watch descriptor
+	vector<PrewarmCallback> prewarm_callbacks;
+};
+
+// True when duck_tails_ref_watcher is on.
+bool RefWatcherEnabled(ClientContext &context);
+// True when duck_tails_ref_watcher_prewarm is on.
+bool RefWatcherPrewarmEnabled(ClientContext &context);
+
+// Registers the duck_tails_ref_watcher and duck_tails_ref_watcher_prewarm settings.
+void RegisterGitRefWatcherSettings(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//===--------------------------------------------------------------------===//
+// GitResultCache — memoized results of commit-addressed table functions
+//
+// Once their refs are resolved, git_tree(commit), git_blame(file, commit),
+// git_diff_tree(a, b) and git_parents(commit) are pure functions of immutable
+// object ids. Their output chunks are kept in a process-wide LRU cache of
+// ColumnDataCollections keyed by the function, the resolved ids and the
+// options, so a dashboard re-running the same query replays columnar data
+// instead of walking the object database again. WORKDIR and INDEX reads are
+// never cached. Off by default; SET duck_tails_result_cache_size = '512MB'
+// enables it with that memory budget. Like the diff cache, there is one cache
+// per process and its settings follow the last SET from any connection.
+//
+// With SET duck_tails_cache_path = '<dir>' results are also written there,
+// one file per key, so a new process reuses the work of earlier ones. Keys
+// only name immutable objects, so files never go stale; the oldest are
+// removed once the directory exceeds duck_tails_cache_path_size.
+//===--------------------------------------------------------------------===//
+
+class GitResultCache {
+public:
+	static GitResultCache &Instance();
+
+	// The process-wide cache, or nullptr while both duck_tails_result_cache_size
+	// and duck_tails_cache_path are off
+	static optional_ptr<GitResultCache> Get(ClientContext &context);
+
+	// Memory first, then the cache directory. A cache file whose columns are
+	// not `types` is a miss and is deleted.
+	shared_ptr<const ColumnDataCollection> Lookup(const string &key, const vector<LogicalType> &types);
+	void Insert(const string &key, shared_ptr<const ColumnDataCollection> result);
+	// Evicts least recently used results until the cache fits `bytes`
+	void SetCapacity(idx_t bytes);
+	// Persists results in `path` (empty: off)
+	void SetDiskPath(const string &path);
+	// Keeps the cache directory below `bytes`
+	void SetDiskCapacity(idx_t bytes);
+	// A memory budget or a cache directory is set
+	bool IsEnabled();
+	// Largest result worth recording: it fits in memory or on disk
+	idx_t RecordLimit();
+
+private:
+	GitResultCache() = default;
+
+	struct Entry {
+		string key;
+		shared_ptr<const ColumnDataCollection> result;
+		idx_t size;
+	};
+	void InsertInMemory(const string &key, shared_ptr<const ColumnDataCollection> result);
+	void EvictToCapacity();
+
+	shared_ptr<const ColumnDataCollection> ReadDiskEntry(const string &path, const string &key,
+	                                                     const vector<LogicalType> &types);
+	void WriteDiskEntry(const string &path, idx_t disk_budget, const string &key, const ColumnDataCollection &result);
+	void EvictDiskEntries(const string &path, idx_t disk_budget);
+
+	std::mutex lock;
+	std::list<Entry> lru; // most recently used first
+	std::unordered_map<string, std::list<Entry>::iterator> entries;
+	idx_t capacity = 0;
+	idx_t size = 0;
+
+	string disk_path;
+	idx_t disk_capacity = 1000000000; // duck_tails_cache_path_size default, 1GB
+	idx_t disk_size = DConstants::INVALID_INDEX; // bytes written below disk_path; unknown until listed
+};
+
+// Key of a cached result: the function name and output column types, followed
+// by everything its output depends on (repository, resolved object ids in hex,
+// options)
+string GitResultCacheKey(const string &function_name, const vector<LogicalType> &types,
+                         const vector<string> &parts);
+
+// Scan-side use of the cache by one table function call. On a hit, Replay()
+// produces the cached chunks; on a miss, the chunks the function produces are
+// passed to Record() and published when the scan ends (the first empty chunk).
+// Scans stopped early (LIMIT) or larger than the budget publish nothing.
+class GitResultCacheScan {
+public:
+	// Looks `key` up in `cache` (may be nullptr); true on a hit
+	bool Begin(optional_ptr<GitResultCache> cache, string key, const vector<LogicalType> &types);
+	// Same, for a result already looked up (e.g. at bind time)
+	void Initialize(optional_ptr<GitResultCache> cache, string key, shared_ptr<const ColumnDataCollection> hit);
+
+	bool IsHit() const {
+		return cached != nullptr;
+	}
+	void Replay(DataChunk &output);
+	void Record(DataChunk &output);
+
+private:
+	optional_ptr<GitResultCache> cache;
+	string key;
+	shared_ptr<const ColumnDataCollection> cached;
+	ColumnDataScanState scan_state;
+	shared_ptr<ColumnDataCollection> recording;
+};
+
+// Registers the duck_tails_result_cache_size, duck_tails_cache_path and
+// duck_tails_cache_path_size settings.
+void RegisterGitResultCacheSettings(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// GitStatusRow — one git_status() output row.
+//===--------------------------------------------------------------------===//
+
+struct GitStatusRow {
+	string repo_path;
+	string file_path;
+	string file_ext;
+	string status;             // "modified", "added", "deleted", "renamed", "untracked", "ignored", "conflicted"
+	uint32_t status_flags = 0; // raw git_status_t bitmask
+	bool staged = false;       // has index changes
+	bool unstaged = false;     // has workdir changes
+	string old_path;           // rename/copy source (empty otherwise)
+};
+
+//===--------------------------------------------------------------------===//
+// Parallel status engine (git_status(..., engine := 'parallel'))
+//
+// An alternative to git_status_list_new for large worktrees:
+//   - HEAD-to-index changes come from a tree-to-index diff (no filesystem I/O);
+//   - index entries are lstat'ed in parallel on DuckDB's scheduler and only
+//     stat-dirty or racy entries are hashed;
+//   - untracked discovery reuses directory listings from a process-wide cache
+//     validated by directory mtime (the idea behind git's UNTR extension),
+//     kept for the most recently used worktrees;
+//   - an optional fsmonitor hook (protocol v2) limits both the stat pass and
+//     the directory validation to paths the hook reports as changed;
+//   - with the ref watcher on, an index write seen by inotify also discards
+//     the previous run's fsmonitor state, even when the index mtime did not
+//     change (coarse timestamps, rewrites within one tick).
+// Rows carry file_path/status_flags/old_path; the caller derives the rest.
+//===--------------------------------------------------------------------===//
+
+struct GitStatusEngineOptions {
+	bool include_untracked = true;
+	bool include_ignored = false;
+	string path_filter;    // exact path match, as in the libgit2 engine
+	string fsmonitor_hook; // executable run as `<hook> 2 <token>` in the worktree, without a shell; empty disables
+	idx_t max_threads = 1;
+	bool fast_hash = false;  // duck_tails_fast_hash: OpenSSL SHA-1 for stat-dirty entries
+	bool watch_refs = false; // duck_tails_ref_watcher: index writes invalidate fsmonitor state
+};
+
+void CollectStatusRowsParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const GitStatusEngineOptions &opts, vector<GitStatusRow> &rows);
+
+} // namespace duckdb
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <git2.h>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -164,6 +166,22 @@ inline GitBlobPtr MakeGitBlob(git_blob *blob) {
 	return GitBlobPtr(blob, reinterpret_cast<void (*)(git_blob *)>(git_blob_free));
 }
 
+// Hash/equality functors for keying unordered containers by git_oid.
+struct GitOidHash {
+	size_t operator()(const git_oid &oid) const {
+		// Object ids are uniformly distributed, so the leading bytes make a good hash.
+		size_t h;
+		memcpy(&h, oid.id, sizeof(h));
+		return h;
+	}
+};
+
+struct GitOidEqual {
+	bool operator()(const git_oid &a, const git_oid &b) const {
+		return git_oid_equal(&a, &b) != 0;
+	}
+};
+
 // Safe workdir path construction — validates that file_path doesn't escape the workdir via ../
 // Opens repo, gets workdir, constructs absolute path, validates containment.
 // Returns the absolute path. Throws on bare repos, missing workdir, or path traversal.
@@ -172,6 +190,64 @@ string SafeWorkdirPath(const string &repo_path, const string &file_path);
 // Get the workdir root for a repository (with trailing slash). Throws on bare repos.
 string GetWorkdirRoot(const string &repo_path);
 
+// Id of the commit `ref` resolves to; false if it does not resolve to a commit.
+bool ResolveCommitId(git_repository *repo, const string &ref, git_oid &out);
+
+// Blob id of `file_path` in the tree of `treeish` (commit, tag or tree); false
+// if it is not a regular file there.
+bool LookupTreeBlobId(git_object *treeish, const string &file_path, git_oid &out);
+
+// Blob id of the committed file a git:// URI names, and its repository. False
+// for pseudo-refs, ranges, unresolvable revisions and paths that are not
+// regular files, i.e. whenever the caller has to read the file another way.
+bool TryGetGitUriBlobId(const string &uri, string &repo_path, git_oid &out);
+
+// One pair found by FindExactRenames: delta indexes into the git_diff.
+struct GitExactRename {
+	idx_t added;   // added (or untracked) file
+	idx_t deleted; // deleted file with the same content
+	git_oid id;    // the shared content id
+};
+
+// Rename detection selected by the `renames` named parameter.
+enum class GitDiffRenameMode : uint8_t {
+	OFF,     // report adds/deletes as-is
+	EXACT,   // pair deleted/added files with identical blob ids (hash join, no scoring)
+	SIMILAR, // libgit2 similarity scoring for renames and copies
+};
+
+struct GitDiffRenameOptions {
+	GitDiffRenameMode mode = GitDiffRenameMode::SIMILAR;
+	int64_t rename_limit = 0;          // 0 means libgit2's default (diff.renameLimit)
+	int64_t similarity_threshold = -1; // -1 means libgit2's default (50%)
+};
+
+// Applies the renames, rename_limit and similarity_threshold named
+// parameters; other names are ignored.
+void ApplyRenameParam(const string &name, const Value &value, GitDiffRenameOptions &opts, const char *func_name);
+
+// renames := 'exact' for git_diff_tree and git_log_changes: pairs added and
+// untracked files of `diff` with deleted files of identical content. Deleted
+// blob ids go into a hash table that added files probe, so the cost is linear
+// in the number of deltas instead of libgit2's pairwise candidate scan.
+// Worktree files whose id the diff does not know are hashed through the
+// repository's filters (CRLF, ident), and only when there is a deletion to
+// match. Several deletions with one content are taken in delta (path) order.
+vector<GitExactRename> FindExactRenames(git_repository *repo, git_diff *diff);
+
+// Runs the rename detection `opts` selects on `diff`: SIMILAR rewrites its
+// deltas through git_diff_find_similar (throwing if that fails), EXACT
+// returns the pairs found by FindExactRenames for the caller to merge.
+vector<GitExactRename> DetectRenames(git_repository *repo, git_diff *diff, const GitDiffRenameOptions &opts,
+                                     const char *func_name);
+
+// Runs work(0) .. work(num_workers - 1) as tasks on DuckDB's scheduler and
+// waits for them; the calling thread executes tasks as well. Workers usually
+// pull items from a shared counter. The first exception thrown by a worker is
+// rethrown here once all of them finished. libgit2 handles are per thread, so
+// workers take theirs from GitRepoPool.
+void RunParallelWorkers(ClientContext &context, idx_t num_workers, const std::function<void(idx_t worker)> &work);
+
 // Note: libgit2 is initialized once at extension load time in duck_tails_extension.cpp
 // Individual functions should NOT call git_libgit2_init() or git_libgit2_shutdown()
 
@@ -4,6 +4,7 @@
 #include "duckdb/common/types.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "diff_algorithm.hpp"
 #include <string>
 #include <vector>
 
@@ -24,7 +25,8 @@ public:
 		CONTEXT = 0, // Unchanged line
 		ADDED = 1,   // Line added in new version
 		REMOVED = 2, // Line removed from old version
-		MODIFIED = 3 // Line modified between versions
+		MODIFIED = 3, // Line modified between versions
+		HUNK = 4      // Hunk header ("@@ -a,b +c,d @@") when context is limited
 	};
 
 	// Individual diff line
@@ -52,12 +54,30 @@ public:
 		}
 	};
 
+	struct Options {
+		DiffAlgorithm algorithm = DiffAlgorithm::MYERS;
+		// Unchanged lines kept around each change; -1 keeps every line and
+		// emits no hunk headers
+		int64_t context_lines = -1;
+
+		bool operator==(const Options &other) const {
+			return algorithm == other.algorithm && context_lines == other.context_lines;
+		}
+	};
+
 public:
 	TextDiff() = default;
 	explicit TextDiff(vector<DiffLine> lines);
 
 	// Create diff from two strings
-	static TextDiff CreateDiff(const string &old_text, const string &new_text);
+	static TextDiff CreateDiff(const string &old_text, const string &new_text, const Options &options = Options());
+	// Diff two buffers in place; only lines that end up in the diff are copied
+	static TextDiff CreateDiff(const char *old_data, idx_t old_size, const char *new_data, idx_t new_size,
+	                           const Options &options = Options());
+	// Counts the lines CreateDiff with the same options would produce, without
+	// building the diff: only line hashes, ids and change flags are kept
+	static Stats ComputeStats(const char *old_data, idx_t old_size, const char *new_data, idx_t new_size,
+	                          const Options &options = Options());
 
 	// Accessors
 	const vector<DiffLine> &GetLines() const {
@@ -70,6 +90,10 @@ public:
 
 	// String representation
 	string ToString() const;
+	// Parses ToString() output back into lines
+	static TextDiff FromString(const string &text);
+	// Appends one line of ToString() output: prefix, content and newline
+	static void AppendLine(string &out, LineType type, const char *content, idx_t size);
 
 	// Comparison operators
 	bool operator==(const TextDiff &other) const;
@@ -81,15 +105,46 @@ private:
 	vector<DiffLine> diff_lines_;
 
 	// Internal diff computation
-	static vector<DiffLine> ComputeDiff(const vector<string> &old_lines, const vector<string> &new_lines);
-	static vector<string> SplitLines(const string &text);
+	static vector<DiffLine> ComputeDiff(const char *old_data, const vector<LineToken> &old_lines,
+	                                    const char *new_data, const vector<LineToken> &new_lines,
+	                                    const Options &options);
+};
+
+// A diff in the TEXTDIFF layout: the content of all lines back to back plus
+// one fixed-size record per line. text_diff() writes it with one copy of the
+// content, and the diff cache holds it at one allocation for the whole text.
+struct PackedTextDiff {
+	struct Line {
+		TextDiff::LineType type;
+		uint32_t old_line_number;
+		uint32_t new_line_number;
+		uint32_t offset; // slice of `content`
+		uint32_t length;
+	};
+
+	explicit PackedTextDiff(const TextDiff &diff);
+
+	bool IsEmpty() const {
+		return lines.empty();
+	}
+	// Same text as TextDiff::ToString()
+	string ToString() const;
+	// Heap footprint, including this object
+	idx_t MemorySize() const {
+		return sizeof(PackedTextDiff) + content.capacity() + lines.capacity() * sizeof(Line);
+	}
+
+	string content;
+	vector<Line> lines;
 };
 
 //===--------------------------------------------------------------------===//
 // DuckDB Type Integration
 //===--------------------------------------------------------------------===//
 
-// TextDiff LogicalType
+// TextDiff LogicalType: STRUCT(content VARCHAR, lines STRUCT(type, old_line,
+// new_line, offset, length)[]) aliased TEXTDIFF. `content` holds the text of
+// all lines back to back; each line record points into it.
 extern LogicalType TextDiffType();
 
 // Type functions for DuckDB integration
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/string_type.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Byte-level text scanning shared by git_blame, git_read and text_diff.
+//===--------------------------------------------------------------------===//
+
+// Returns true iff `data` is well-formed UTF-8 (structure only: lead byte and
+// continuation bytes). ASCII runs are skipped a machine word at a time, so the
+// common all-ASCII source file costs one load + mask per 8 bytes.
+bool IsValidUTF8(const char *data, size_t length);
+
+// Splits `data` into one view per line. Views point into `data` (no copies for
+// lines longer than string_t's inline size); the caller keeps the buffer alive
+// for as long as the views are used. The '\n' terminator is never included and
+// a trailing '\r' is dropped when `strip_cr` is set. A final line without a
+// terminator is included; empty input yields no lines. Newline search goes
+// through memchr, which the C library vectorizes.
+void SplitLineViews(const char *data, size_t length, vector<string_t> &lines, bool strip_cr = true);
+
+// One line of a buffer: its byte range (terminator excluded) and a hash of
+// the content, so lines can be compared by hash before touching the bytes.
+struct LineToken {
+	uint64_t offset;
+	uint32_t length;
+	hash_t hash;
+};
+
+// Tokenizes `data` into lines with the same rules as SplitLineViews, without
+// copying anything.
+void TokenizeLines(const char *data, size_t length, vector<LineToken> &lines, bool strip_cr = true);
+
+// 128-bit content fingerprint, for keying caches by content: two independent
+// 64-bit multiply-rotate lanes over 8-byte words. Not cryptographic.
+struct ContentHash {
+	uint64_t low;
+	uint64_t high;
+
+	bool operator==(const ContentHash &other) const {
+		return low == other.low && high == other.high;
+	}
+};
+
+ContentHash HashContent(const char *data, size_t length);
+
+} // namespace duckdb
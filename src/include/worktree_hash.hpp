@@ -0,0 +1,42 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <git2.h>
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//===--------------------------------------------------------------------===//
+// Worktree blob hashing
+//
+// Computes blob OIDs for working-directory files. With fast hashing enabled
+// (SET duck_tails_fast_hash = true), files that need no content filters
+// (CRLF conversion, ident, LFS, ...) are hashed with OpenSSL's SHA-1, which
+// uses SHA-NI/AVX2 where the CPU has them, instead of libgit2's
+// collision-detecting SHA-1. Filtered files always go through libgit2.
+//===--------------------------------------------------------------------===//
+
+// Registers the duck_tails_fast_hash setting (BOOLEAN, default false).
+void RegisterWorktreeHashSettings(ExtensionLoader &loader);
+
+// Value of duck_tails_fast_hash for this connection.
+bool FastHashEnabled(ClientContext &context);
+
+// Hashes the file at full_path (repo-relative rel_path, used for attribute
+// lookup) as a blob. Symlinks hash their target path. Returns false on error.
+bool HashWorktreeFile(git_repository *repo, const string &full_path, const string &rel_path, bool fast, git_oid &out);
+
+// Same as HashWorktreeFile for content already read from full_path.
+bool HashWorktreeContent(git_repository *repo, const string &full_path, const string &rel_path, const char *data,
+                         size_t length, bool fast, git_oid &out);
+
+// Hashes workdir + rel_paths[i] into oids[i] on up to max_threads of DuckDB's
+// scheduler threads; ok[i] is false where hashing failed (e.g. the file
+// vanished).
+void HashWorktreeFilesParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const string &workdir, const vector<string> &rel_paths, bool fast, idx_t max_threads,
+                               vector<git_oid> &oids, vector<bool> &ok);
+
+} // namespace duckdb
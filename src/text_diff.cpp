@@ -1,12 +1,22 @@
 #include "text_diff.hpp"
+#include "diff_cache.hpp"
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/value.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/file_opener.hpp"
+#include "duckdb/function/cast/cast_function_set.hpp"
+#include "duckdb/function/function_set.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "text_utils.hpp"
+#include "git_filesystem.hpp"
+#include "git_repo_pool.hpp"
+#include "git_utils.hpp"
 #include <algorithm>
-#include <sstream>
+#include <atomic>
+#include <cstring>
 
 namespace duckdb {
 
@@ -17,19 +27,87 @@ namespace duckdb {
 TextDiff::TextDiff(vector<DiffLine> lines) : diff_lines_(std::move(lines)) {
 }
 
-TextDiff TextDiff::CreateDiff(const string &old_text, const string &new_text) {
-	if (old_text == new_text) {
+TextDiff TextDiff::CreateDiff(const string &old_text, const string &new_text, const Options &options) {
+	return CreateDiff(old_text.data(), old_text.size(), new_text.data(), new_text.size(), options);
+}
+
+TextDiff TextDiff::CreateDiff(const char *old_data, idx_t old_size, const char *new_data, idx_t new_size,
+                              const Options &options) {
+	if (old_size == new_size && memcmp(old_data, new_data, old_size) == 0) {
 		// Identical texts = empty diff
 		return TextDiff();
 	}
 
-	auto old_lines = SplitLines(old_text);
-	auto new_lines = SplitLines(new_text);
-	auto diff_lines = ComputeDiff(old_lines, new_lines);
+	// Lines keep their '\r': a line ending change is a change
+	vector<LineToken> old_lines, new_lines;
+	TokenizeLines(old_data, old_size, old_lines, false);
+	TokenizeLines(new_data, new_size, new_lines, false);
+	auto diff_lines = ComputeDiff(old_data, old_lines, new_data, new_lines, options);
 
 	return TextDiff(std::move(diff_lines));
 }
 
+TextDiff::Stats TextDiff::ComputeStats(const char *old_data, idx_t old_size, const char *new_data, idx_t new_size,
+                                       const Options &options) {
+	Stats stats;
+	if (old_size == new_size && memcmp(old_data, new_data, old_size) == 0) {
+		return stats;
+	}
+
+	vector<LineToken> old_lines, new_lines;
+	TokenizeLines(old_data, old_size, old_lines, false);
+	TokenizeLines(new_data, new_size, new_lines, false);
+	LineInterner interner(old_lines.size() + new_lines.size());
+	vector<uint32_t> old_ids, new_ids;
+	interner.Intern(old_data, old_lines, old_ids);
+	interner.Intern(new_data, new_lines, new_ids);
+
+	vector<uint8_t> old_changed, new_changed;
+	ComputeLineDiff(old_ids, new_ids, interner.Count(), options.algorithm, old_changed, new_changed);
+	for (auto changed : old_changed) {
+		stats.lines_removed += changed;
+	}
+	for (auto changed : new_changed) {
+		stats.lines_added += changed;
+	}
+	if (options.context_lines < 0) {
+		// Every unchanged old line pairs with an unchanged new line
+		stats.lines_context = old_lines.size() - stats.lines_removed;
+		return stats;
+	}
+
+	// Only the unchanged lines ComputeDiff would put in hunks: up to
+	// `context` before the first and after the last change, and up to
+	// 2 * context of each gap between changes
+	auto context = static_cast<idx_t>(options.context_lines);
+	idx_t old_count = old_lines.size(), new_count = new_lines.size();
+	idx_t old_idx = 0, new_idx = 0, gap = 0;
+	bool seen_change = false;
+	while (old_idx < old_count || new_idx < new_count) {
+		bool old_is_change = old_idx < old_count && old_changed[old_idx];
+		bool new_is_change = new_idx < new_count && new_changed[new_idx];
+		if (!old_is_change && !new_is_change) {
+			old_idx++;
+			new_idx++;
+			gap++;
+			continue;
+		}
+		stats.lines_context += MinValue<idx_t>(gap, seen_change ? 2 * context : context);
+		while (old_idx < old_count && old_changed[old_idx]) {
+			old_idx++;
+		}
+		while (new_idx < new_count && new_changed[new_idx]) {
+			new_idx++;
+		}
+		seen_change = true;
+		gap = 0;
+	}
+	if (seen_change) {
+		stats.lines_context += MinValue<idx_t>(gap, context);
+	}
+	return stats;
+}
+
 TextDiff::Stats TextDiff::GetStats() const {
 	Stats stats;
 
@@ -47,36 +125,163 @@ TextDiff::Stats TextDiff::GetStats() const {
 		case LineType::CONTEXT:
 			stats.lines_context++;
 			break;
+		case LineType::HUNK:
+			break;
 		}
 	}
 
 	return stats;
 }
 
+void TextDiff::AppendLine(string &out, LineType type, const char *content, idx_t size) {
+	switch (type) {
+	case LineType::ADDED:
+		out += '+';
+		break;
+	case LineType::REMOVED:
+		out += '-';
+		break;
+	case LineType::MODIFIED:
+		out += '~';
+		break;
+	case LineType::CONTEXT:
+		out += ' ';
+		break;
+	case LineType::HUNK:
+		break;
+	}
+	out.append(content, size);
+	out += '\n';
+}
+
 string TextDiff::ToString() const {
 	if (IsEmpty()) {
 		return "No differences";
 	}
 
-	std::ostringstream oss;
+	string result;
 	for (const auto &line : diff_lines_) {
-		switch (line.type) {
-		case LineType::CONTEXT:
-			oss << " " << line.content << "\n";
-			break;
+		AppendLine(result, line.type, line.content.data(), line.content.size());
+	}
+
+	return result;
+}
+
+PackedTextDiff::PackedTextDiff(const TextDiff &diff) {
+	const auto &diff_lines = diff.GetLines();
+	idx_t content_size = 0;
+	for (const auto &line : diff_lines) {
+		content_size += line.content.size();
+	}
+	content.reserve(content_size);
+	lines.reserve(diff_lines.size());
+	for (const auto &line : diff_lines) {
+		lines.push_back(Line {line.type, UnsafeNumericCast<uint32_t>(line.old_line_number),
+		                      UnsafeNumericCast<uint32_t>(line.new_line_number),
+		                      UnsafeNumericCast<uint32_t>(content.size()),
+		                      UnsafeNumericCast<uint32_t>(line.content.size())});
+		content += line.content;
+	}
+}
+
+string PackedTextDiff::ToString() const {
+	if (IsEmpty()) {
+		return "No differences";
+	}
+	string result;
+	for (const auto &line : lines) {
+		TextDiff::AppendLine(result, line.type, content.data() + line.offset, line.length);
+	}
+	return result;
+}
+
+// Parses "@@ -a[,b] +c[,d] @@": the line numbers preceding the hunk's first lines
+static bool ParseHunkHeader(const char *data, idx_t size, idx_t &old_number, idx_t &new_number) {
+	if (size < 2 || data[0] != '@' || data[1] != '@') {
+		return false;
+	}
+	idx_t pos = 2;
+	auto parse_range = [&](char sign, idx_t &number) {
+		while (pos < size && data[pos] == ' ') {
+			pos++;
+		}
+		if (pos >= size || data[pos] != sign) {
+			return false;
+		}
+		pos++;
+		idx_t start = 0, count = 1;
+		bool digits = false;
+		while (pos < size && isdigit(static_cast<unsigned char>(data[pos]))) {
+			start = start * 10 + static_cast<idx_t>(data[pos++] - '0');
+			digits = true;
+		}
+		if (pos < size && data[pos] == ',') {
+			pos++;
+			count = 0;
+			while (pos < size && isdigit(static_cast<unsigned char>(data[pos]))) {
+				count = count * 10 + static_cast<idx_t>(data[pos++] - '0');
+			}
+		}
+		// An empty range names the line before it
+		number = (count == 0 || start == 0) ? start : start - 1;
+		return digits;
+	};
+	return parse_range('-', old_number) && parse_range('+', new_number);
+}
+
+TextDiff TextDiff::FromString(const string &text) {
+	vector<DiffLine> lines;
+	if (text == "No differences") {
+		return TextDiff();
+	}
+	vector<string_t> views;
+	SplitLineViews(text.data(), text.size(), views, false);
+	idx_t old_number = 0, new_number = 0;
+	for (auto &view : views) {
+		auto data = view.GetData();
+		auto size = view.GetSize();
+		LineType type = LineType::CONTEXT;
+		idx_t skip = 0;
+		if (size > 0) {
+			switch (data[0]) {
+			case '+':
+				type = LineType::ADDED;
+				skip = 1;
+				break;
+			case '-':
+				type = LineType::REMOVED;
+				skip = 1;
+				break;
+			case '~':
+				type = LineType::MODIFIED;
+				skip = 1;
+				break;
+			case ' ':
+				skip = 1;
+				break;
+			default:
+				// Not a diff line: keep it whole as context
+				break;
+			}
+		}
+		if (ParseHunkHeader(data, size, old_number, new_number)) {
+			lines.emplace_back(LineType::HUNK, string(data, size));
+			continue;
+		}
+		string content(data + skip, size - skip);
+		switch (type) {
 		case LineType::ADDED:
-			oss << "+" << line.content << "\n";
+			lines.emplace_back(type, std::move(content), 0, ++new_number);
 			break;
 		case LineType::REMOVED:
-			oss << "-" << line.content << "\n";
+			lines.emplace_back(type, std::move(content), ++old_number, 0);
 			break;
-		case LineType::MODIFIED:
-			oss << "~" << line.content << "\n";
+		default:
+			lines.emplace_back(type, std::move(content), ++old_number, ++new_number);
 			break;
 		}
 	}
-
-	return oss.str();
+	return TextDiff(std::move(lines));
 }
 
 bool TextDiff::operator==(const TextDiff &other) const {
@@ -97,57 +302,102 @@ bool TextDiff::operator==(const TextDiff &other) const {
 	return true;
 }
 
-// Using string representation for simplicity
-
-vector<string> TextDiff::SplitLines(const string &text) {
-	vector<string> lines;
-	if (text.empty()) {
-		return lines;
-	}
-
-	std::stringstream ss(text);
-	string line;
-
-	// Split by newlines, preserving empty lines
-	while (std::getline(ss, line)) {
-		lines.push_back(line);
-	}
+// "@@ -a,b +c,d @@" for the hunk covering old lines [old_begin, old_end) and
+// new lines [new_begin, new_end); ",1" is omitted and an empty range names
+// the line before it, as in git.
+static string HunkHeader(idx_t old_begin, idx_t old_end, idx_t new_begin, idx_t new_end) {
+	auto range = [](idx_t begin, idx_t end) {
+		idx_t count = end - begin;
+		if (count == 1) {
+			return to_string(begin + 1);
+		}
+		return to_string(count == 0 ? begin : begin + 1) + "," + to_string(count);
+	};
+	return "@@ -" + range(old_begin, old_end) + " +" + range(new_begin, new_end) + " @@";
+}
 
-	// Handle case where text doesn't end with newline
-	if (!text.empty() && text.back() != '\n') {
-		// Last line was already added by getline
-	}
+vector<TextDiff::DiffLine> TextDiff::ComputeDiff(const char *old_data, const vector<LineToken> &old_lines,
+                                                  const char *new_data, const vector<LineToken> &new_lines,
+                                                  const Options &options) {
+	// Number distinct lines so the diff algorithms compare integers
+	LineInterner interner(old_lines.size() + new_lines.size());
+	vector<uint32_t> old_ids, new_ids;
+	interner.Intern(old_data, old_lines, old_ids);
+	interner.Intern(new_data, new_lines, new_ids);
 
-	return lines;
-}
+	vector<uint8_t> old_changed, new_changed;
+	ComputeLineDiff(old_ids, new_ids, interner.Count(), options.algorithm, old_changed, new_changed);
 
-vector<TextDiff::DiffLine> TextDiff::ComputeDiff(const vector<string> &old_lines, const vector<string> &new_lines) {
+	// Emits old lines [old_idx, old_end) against new lines [new_idx, new_end).
+	// Each run of changes lists its removed lines before its added lines.
 	vector<DiffLine> result;
+	auto emit = [&](idx_t old_idx, idx_t old_end, idx_t new_idx, idx_t new_end) {
+		while (old_idx < old_end || new_idx < new_end) {
+			if (old_idx < old_end && old_changed[old_idx]) {
+				auto &line = old_lines[old_idx];
+				result.emplace_back(LineType::REMOVED, string(old_data + line.offset, line.length), old_idx + 1, 0);
+				old_idx++;
+			} else if (new_idx < new_end && new_changed[new_idx]) {
+				auto &line = new_lines[new_idx];
+				result.emplace_back(LineType::ADDED, string(new_data + line.offset, line.length), 0, new_idx + 1);
+				new_idx++;
+			} else {
+				auto &line = old_lines[old_idx];
+				result.emplace_back(LineType::CONTEXT, string(old_data + line.offset, line.length), old_idx + 1,
+				                    new_idx + 1);
+				old_idx++;
+				new_idx++;
+			}
+		}
+	};
+	if (options.context_lines < 0) {
+		emit(0, old_lines.size(), 0, new_lines.size());
+		return result;
+	}
 
-	// Simple diff algorithm - Myers algorithm would be better but this is sufficient
-	size_t old_idx = 0, new_idx = 0;
-
-	while (old_idx < old_lines.size() || new_idx < new_lines.size()) {
-		if (old_idx >= old_lines.size()) {
-			// Only new lines remaining - all additions
-			result.emplace_back(LineType::ADDED, new_lines[new_idx], 0, new_idx + 1);
-			new_idx++;
-		} else if (new_idx >= new_lines.size()) {
-			// Only old lines remaining - all removals
-			result.emplace_back(LineType::REMOVED, old_lines[old_idx], old_idx + 1, 0);
-			old_idx++;
-		} else if (old_lines[old_idx] == new_lines[new_idx]) {
-			// Lines match - context
-			result.emplace_back(LineType::CONTEXT, old_lines[old_idx], old_idx + 1, new_idx + 1);
+	// Hunks: runs of changes whose gaps are at most 2 * context unchanged
+	// lines, widened by up to `context` unchanged lines on each side. Only the
+	// change flags are scanned between hunks; no line there is copied.
+	auto context = static_cast<idx_t>(options.context_lines);
+	idx_t old_count = old_lines.size(), new_count = new_lines.size();
+	idx_t old_idx = 0, new_idx = 0;
+	bool in_hunk = false;
+	idx_t hunk_old = 0, hunk_new = 0, change_old_end = 0, change_new_end = 0;
+	auto close_hunk = [&]() {
+		idx_t trailing = MinValue<idx_t>(context, old_count - change_old_end);
+		idx_t old_end = change_old_end + trailing, new_end = change_new_end + trailing;
+		result.emplace_back(LineType::HUNK, HunkHeader(hunk_old, old_end, hunk_new, new_end));
+		emit(hunk_old, old_end, hunk_new, new_end);
+		in_hunk = false;
+	};
+	while (old_idx < old_count || new_idx < new_count) {
+		bool old_is_change = old_idx < old_count && old_changed[old_idx];
+		bool new_is_change = new_idx < new_count && new_changed[new_idx];
+		if (!old_is_change && !new_is_change) {
 			old_idx++;
 			new_idx++;
-		} else {
-			// Lines differ - mark as modified (simplified)
-			result.emplace_back(LineType::REMOVED, old_lines[old_idx], old_idx + 1, 0);
-			result.emplace_back(LineType::ADDED, new_lines[new_idx], 0, new_idx + 1);
+			continue;
+		}
+		if (in_hunk && old_idx - change_old_end > 2 * context) {
+			close_hunk();
+		}
+		if (!in_hunk) {
+			idx_t leading = MinValue<idx_t>(context, MinValue<idx_t>(old_idx, new_idx));
+			hunk_old = old_idx - leading;
+			hunk_new = new_idx - leading;
+			in_hunk = true;
+		}
+		while (old_idx < old_count && old_changed[old_idx]) {
 			old_idx++;
+		}
+		while (new_idx < new_count && new_changed[new_idx]) {
 			new_idx++;
 		}
+		change_old_end = old_idx;
+		change_new_end = new_idx;
+	}
+	if (in_hunk) {
+		close_hunk();
 	}
 
 	return result;
@@ -157,69 +407,243 @@ vector<TextDiff::DiffLine> TextDiff::ComputeDiff(const vector<string> &old_lines
 // DuckDB Type Integration
 //===--------------------------------------------------------------------===//
 
-// Custom TextDiff type implementation
-struct TextDiffTypeInfo {
-	static constexpr const LogicalTypeId TYPE_ID = LogicalTypeId::INVALID;
-	static constexpr const char *NAME = "TEXTDIFF";
-};
+// TEXTDIFF layout: the content of all diff lines concatenated into one
+// string, plus one record per line (type, line numbers, slice of content).
+static constexpr idx_t TEXTDIFF_CONTENT = 0;
+static constexpr idx_t TEXTDIFF_LINES = 1;
+static constexpr idx_t LINE_TYPE = 0;
+static constexpr idx_t LINE_OLD_NUMBER = 1;
+static constexpr idx_t LINE_NEW_NUMBER = 2;
+static constexpr idx_t LINE_OFFSET = 3;
+static constexpr idx_t LINE_LENGTH = 4;
+static constexpr idx_t LINE_FIELD_COUNT = 5;
 
 LogicalType TextDiffType() {
-	// Create custom logical type for TextDiff
-	return LogicalType(LogicalTypeId::BLOB); // Use BLOB as base type for now
+	child_list_t<LogicalType> line_fields;
+	line_fields.emplace_back("type", LogicalType::UTINYINT);
+	line_fields.emplace_back("old_line", LogicalType::UINTEGER);
+	line_fields.emplace_back("new_line", LogicalType::UINTEGER);
+	line_fields.emplace_back("offset", LogicalType::UINTEGER);
+	line_fields.emplace_back("length", LogicalType::UINTEGER);
+	child_list_t<LogicalType> fields;
+	fields.emplace_back("content", LogicalType::VARCHAR);
+	fields.emplace_back("lines", LogicalType::LIST(LogicalType::STRUCT(std::move(line_fields))));
+	auto type = LogicalType::STRUCT(std::move(fields));
+	type.SetAlias("TEXTDIFF");
+	return type;
 }
 
-// TextDiff creation function
-static void TextDiffFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &old_vector = args.data[0];
-	auto &new_vector = args.data[1];
+// Writes `diff` into row `row` of a flat TEXTDIFF vector
+static void WriteTextDiff(const PackedTextDiff &diff, Vector &result, idx_t row) {
+	auto &entries = StructVector::GetEntries(result);
+	auto &content_vector = *entries[TEXTDIFF_CONTENT];
+	auto &lines_vector = *entries[TEXTDIFF_LINES];
+	const auto &lines = diff.lines;
+
+	auto list_offset = ListVector::GetListSize(lines_vector);
+	ListVector::Reserve(lines_vector, list_offset + lines.size());
+	auto &line_fields = StructVector::GetEntries(ListVector::GetEntry(lines_vector));
+	auto types = FlatVector::GetData<uint8_t>(*line_fields[LINE_TYPE]);
+	auto old_numbers = FlatVector::GetData<uint32_t>(*line_fields[LINE_OLD_NUMBER]);
+	auto new_numbers = FlatVector::GetData<uint32_t>(*line_fields[LINE_NEW_NUMBER]);
+	auto offsets = FlatVector::GetData<uint32_t>(*line_fields[LINE_OFFSET]);
+	auto lengths = FlatVector::GetData<uint32_t>(*line_fields[LINE_LENGTH]);
+
+	for (idx_t i = 0; i < lines.size(); i++) {
+		const auto &line = lines[i];
+		auto target = list_offset + i;
+		types[target] = static_cast<uint8_t>(line.type);
+		old_numbers[target] = line.old_line_number;
+		new_numbers[target] = line.new_line_number;
+		offsets[target] = line.offset;
+		lengths[target] = line.length;
+	}
+
+	FlatVector::GetData<string_t>(content_vector)[row] = StringVector::AddString(content_vector, diff.content);
+	FlatVector::GetData<list_entry_t>(lines_vector)[row] = list_entry_t(list_offset, lines.size());
+	ListVector::SetListSize(lines_vector, list_offset + lines.size());
+}
+
+static void WriteNullTextDiff(Vector &result, idx_t row) {
+	auto &lines_vector = *StructVector::GetEntries(result)[TEXTDIFF_LINES];
+	FlatVector::GetData<list_entry_t>(lines_vector)[row] = list_entry_t(ListVector::GetListSize(lines_vector), 0);
+	FlatVector::SetNull(result, row, true);
+}
+
+// Reads the fields of TEXTDIFF values in place
+class TextDiffReader {
+public:
+	TextDiffReader(Vector &diffs, idx_t count) : flat(diffs.GetType()) {
+		flat.Reference(diffs);
+		flat.Flatten(count);
+		auto &entries = StructVector::GetEntries(flat);
+		entries[TEXTDIFF_CONTENT]->ToUnifiedFormat(count, content_format);
+		entries[TEXTDIFF_LINES]->ToUnifiedFormat(count, lines_format);
+		auto &lines = *entries[TEXTDIFF_LINES];
+		auto line_count = ListVector::GetListSize(lines);
+		auto &line_fields = StructVector::GetEntries(ListVector::GetEntry(lines));
+		for (idx_t f = 0; f < LINE_FIELD_COUNT; f++) {
+			line_fields[f]->ToUnifiedFormat(line_count, field_formats[f]);
+		}
+	}
+
+	bool IsNull(idx_t row) const {
+		return !FlatVector::Validity(flat).RowIsValid(row);
+	}
+	// Range of the rows' line records
+	list_entry_t Lines(idx_t row) const {
+		auto idx = lines_format.sel->get_index(row);
+		if (!lines_format.validity.RowIsValid(idx)) {
+			return list_entry_t(0, 0);
+		}
+		return UnifiedVectorFormat::GetData<list_entry_t>(lines_format)[idx];
+	}
+	TextDiff::LineType Type(idx_t line) const {
+		return static_cast<TextDiff::LineType>(Field<uint8_t>(LINE_TYPE, line));
+	}
+	// Content of a line, clamped to the row's content string
+	string_t Content(idx_t row, idx_t line) const {
+		auto idx = content_format.sel->get_index(row);
+		if (!content_format.validity.RowIsValid(idx)) {
+			return string_t();
+		}
+		auto content = UnifiedVectorFormat::GetData<string_t>(content_format)[idx];
+		idx_t offset = MinValue<idx_t>(Field<uint32_t>(LINE_OFFSET, line), content.GetSize());
+		idx_t length = MinValue<idx_t>(Field<uint32_t>(LINE_LENGTH, line), content.GetSize() - offset);
+		return string_t(content.GetData() + offset, UnsafeNumericCast<uint32_t>(length));
+	}
+
+private:
+	template <class T>
+	T Field(idx_t field, idx_t line) const {
+		auto &format = field_formats[field];
+		auto idx = format.sel->get_index(line);
+		return format.validity.RowIsValid(idx) ? UnifiedVectorFormat::GetData<T>(format)[idx] : T(0);
+	}
 
+	Vector flat;
+	UnifiedVectorFormat content_format;
+	UnifiedVectorFormat lines_format;
+	UnifiedVectorFormat field_formats[LINE_FIELD_COUNT];
+};
+
+static bool TextDiffToVarcharCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	TextDiffReader reader(source, count);
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 	auto result_data = FlatVector::GetData<string_t>(result);
 	auto &result_validity = FlatVector::Validity(result);
+	string text;
+	for (idx_t row = 0; row < count; row++) {
+		if (reader.IsNull(row)) {
+			result_validity.SetInvalid(row);
+			continue;
+		}
+		auto lines = reader.Lines(row);
+		text.clear();
+		if (lines.length == 0) {
+			text = "No differences";
+		}
+		for (idx_t line = lines.offset; line < lines.offset + lines.length; line++) {
+			auto content = reader.Content(row, line);
+			TextDiff::AppendLine(text, reader.Type(line), content.GetData(), content.GetSize());
+		}
+		result_data[row] = StringVector::AddString(result, text);
+	}
+	if (source.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	return true;
+}
 
-	for (idx_t i = 0; i < args.size(); i++) {
-		if (old_vector.GetValue(i).IsNull() || new_vector.GetValue(i).IsNull()) {
-			result_validity.SetInvalid(i);
+static int64_t ParseContextLines(const Value &value) {
+	auto context_lines = value.GetValue<int64_t>();
+	if (context_lines < 0) {
+		throw InvalidInputException("context_lines must be non-negative, got %lld", context_lines);
+	}
+	return context_lines;
+}
+
+// Optional arguments of text_diff/diff_text: (algorithm), (context_lines) or
+// (algorithm, context_lines)
+static TextDiff::Options GetDiffOptions(DataChunk &args, idx_t row) {
+	TextDiff::Options options;
+	for (idx_t col = 2; col < args.ColumnCount(); col++) {
+		auto value = args.data[col].GetValue(row);
+		if (value.IsNull()) {
 			continue;
 		}
+		if (args.data[col].GetType().id() == LogicalTypeId::VARCHAR) {
+			options.algorithm = ParseDiffAlgorithm(value.ToString());
+		} else {
+			options.context_lines = ParseContextLines(value);
+		}
+	}
+	return options;
+}
 
-		string old_text = old_vector.GetValue(i).ToString();
-		string new_text = new_vector.GetValue(i).ToString();
+// TextDiff creation function
+static void TextDiffFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnifiedVectorFormat old_format, new_format;
+	args.data[0].ToUnifiedFormat(args.size(), old_format);
+	args.data[1].ToUnifiedFormat(args.size(), new_format);
+	auto old_texts = UnifiedVectorFormat::GetData<string_t>(old_format);
+	auto new_texts = UnifiedVectorFormat::GetData<string_t>(new_format);
 
-		auto diff = TextDiff::CreateDiff(old_text, new_text);
-		string diff_str = diff.ToString();
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto cache = DiffCache::Get(state.GetContext());
 
-		result_data[i] = StringVector::AddString(result, diff_str);
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto old_idx = old_format.sel->get_index(i);
+		auto new_idx = new_format.sel->get_index(i);
+		if (!old_format.validity.RowIsValid(old_idx) || !new_format.validity.RowIsValid(new_idx)) {
+			WriteNullTextDiff(result, i);
+			continue;
+		}
+
+		// Diff the argument strings in place
+		auto &old_text = old_texts[old_idx];
+		auto &new_text = new_texts[new_idx];
+		auto diff = CachedTextDiff(cache, old_text.GetData(), old_text.GetSize(), new_text.GetData(),
+		                           new_text.GetSize(), GetDiffOptions(args, i));
+		WriteTextDiff(*diff, result, i);
 	}
 }
 
 // diff_text function - pure text diffing (no file I/O)
 static void DiffTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &old_vector = args.data[0];
-	auto &new_vector = args.data[1];
+	UnifiedVectorFormat old_format, new_format;
+	args.data[0].ToUnifiedFormat(args.size(), old_format);
+	args.data[1].ToUnifiedFormat(args.size(), new_format);
+	auto old_texts = UnifiedVectorFormat::GetData<string_t>(old_format);
+	auto new_texts = UnifiedVectorFormat::GetData<string_t>(new_format);
 
 	result.SetVectorType(VectorType::FLAT_VECTOR);
 	auto result_data = FlatVector::GetData<string_t>(result);
 	auto &result_validity = FlatVector::Validity(result);
+	auto cache = DiffCache::Get(state.GetContext());
 
 	for (idx_t i = 0; i < args.size(); i++) {
-		if (old_vector.GetValue(i).IsNull() || new_vector.GetValue(i).IsNull()) {
+		auto old_idx = old_format.sel->get_index(i);
+		auto new_idx = new_format.sel->get_index(i);
+		if (!old_format.validity.RowIsValid(old_idx) || !new_format.validity.RowIsValid(new_idx)) {
 			result_validity.SetInvalid(i);
 			continue;
 		}
 
-		string old_text = old_vector.GetValue(i).ToString();
-		string new_text = new_vector.GetValue(i).ToString();
+		auto &old_text = old_texts[old_idx];
+		auto &new_text = new_texts[new_idx];
+		auto options = GetDiffOptions(args, i);
 
 		try {
 			// Pure text diffing - no file I/O
-			auto diff = TextDiff::CreateDiff(old_text, new_text);
+			auto diff = CachedTextDiff(cache, old_text.GetData(), old_text.GetSize(), new_text.GetData(),
+			                           new_text.GetSize(), options);
 
-			if (diff.IsEmpty()) {
+			if (diff->IsEmpty()) {
 				// Return NULL for identical content
 				result_validity.SetInvalid(i);
 			} else {
-				string diff_str = diff.ToString();
+				string diff_str = diff->ToString();
 				result_data[i] = StringVector::AddString(result, diff_str);
 			}
 
@@ -231,18 +655,101 @@ static void DiffTextFunction(DataChunk &args, ExpressionState &state, Vector &re
 	}
 }
 
-// TextDiff stats function
+// text_diff_stats result: STRUCT(lines_added, lines_removed, lines_context)
+static LogicalType TextDiffStatsType() {
+	child_list_t<LogicalType> fields;
+	fields.emplace_back("lines_added", LogicalType::BIGINT);
+	fields.emplace_back("lines_removed", LogicalType::BIGINT);
+	fields.emplace_back("lines_context", LogicalType::BIGINT);
+	return LogicalType::STRUCT(std::move(fields));
+}
+
+static void WriteTextDiffStats(const TextDiff::Stats &stats, Vector &result, idx_t row) {
+	auto &entries = StructVector::GetEntries(result);
+	FlatVector::GetData<int64_t>(*entries[0])[row] = static_cast<int64_t>(stats.lines_added);
+	FlatVector::GetData<int64_t>(*entries[1])[row] = static_cast<int64_t>(stats.lines_removed);
+	FlatVector::GetData<int64_t>(*entries[2])[row] = static_cast<int64_t>(stats.lines_context);
+}
+
+// text_diff_stats(TEXTDIFF): counts the line records
 static void TextDiffStatsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &diff_vector = args.data[0];
+	TextDiffReader reader(args.data[0], args.size());
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	for (idx_t row = 0; row < args.size(); row++) {
+		if (reader.IsNull(row)) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		TextDiff::Stats stats;
+		auto lines = reader.Lines(row);
+		for (idx_t line = lines.offset; line < lines.offset + lines.length; line++) {
+			switch (reader.Type(line)) {
+			case TextDiff::LineType::ADDED:
+				stats.lines_added++;
+				break;
+			case TextDiff::LineType::REMOVED:
+				stats.lines_removed++;
+				break;
+			case TextDiff::LineType::MODIFIED:
+				stats.lines_modified++;
+				break;
+			case TextDiff::LineType::HUNK:
+				break;
+			default:
+				stats.lines_context++;
+				break;
+			}
+		}
+		WriteTextDiffStats(stats, result, row);
+	}
+}
 
-	// For now, return a simple struct with stats
-	// In full implementation, this would parse the TextDiff blob
-	result.SetVectorType(VectorType::CONSTANT_VECTOR);
-	auto result_data = ConstantVector::GetData<string_t>(result);
-	result_data[0] = StringVector::AddString(result, "lines_added: 1, lines_removed: 1, lines_modified: 1");
+// text_diff_stats(VARCHAR): the same counts from diff_text() output
+static void TextDiffStatsTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnifiedVectorFormat format;
+	args.data[0].ToUnifiedFormat(args.size(), format);
+	auto texts = UnifiedVectorFormat::GetData<string_t>(format);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	for (idx_t row = 0; row < args.size(); row++) {
+		auto idx = format.sel->get_index(row);
+		if (!format.validity.RowIsValid(idx)) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		auto diff = TextDiff::FromString(texts[idx].GetString());
+		WriteTextDiffStats(diff.GetStats(), result, row);
+	}
+}
+
+// text_diff_stats(old, new[, algorithm][, context_lines]): counts without building the diff
+static void TextDiffStatsPairFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnifiedVectorFormat old_format, new_format;
+	args.data[0].ToUnifiedFormat(args.size(), old_format);
+	args.data[1].ToUnifiedFormat(args.size(), new_format);
+	auto old_texts = UnifiedVectorFormat::GetData<string_t>(old_format);
+	auto new_texts = UnifiedVectorFormat::GetData<string_t>(new_format);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	for (idx_t row = 0; row < args.size(); row++) {
+		auto old_idx = old_format.sel->get_index(row);
+		auto new_idx = new_format.sel->get_index(row);
+		if (!old_format.validity.RowIsValid(old_idx) || !new_format.validity.RowIsValid(new_idx)) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		auto &old_text = old_texts[old_idx];
+		auto &new_text = new_texts[new_idx];
+		auto options = GetDiffOptions(args, row);
+		auto stats = TextDiff::ComputeStats(old_text.GetData(), old_text.GetSize(), new_text.GetData(),
+		                                    new_text.GetSize(), options);
+		WriteTextDiffStats(stats, result, row);
+	}
 }
 
-// TextDiff lines table function
+// text_diff_lines table function
+struct TextDiffLinesBindData : public TableFunctionData {
+	Value diff; // TEXTDIFF or diff_text() output
+};
+
 struct TextDiffLinesData : public GlobalTableFunctionState {
 	vector<TextDiff::DiffLine> lines;
 	idx_t position = 0;
@@ -253,19 +760,73 @@ struct TextDiffLinesData : public GlobalTableFunctionState {
 
 static unique_ptr<FunctionData> TextDiffLinesBind(ClientContext &context, TableFunctionBindInput &input,
                                                   vector<LogicalType> &return_types, vector<string> &names) {
-	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT};
-	names = {"line_type", "content", "line_number"};
-	return nullptr;
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT,
+	                LogicalType::BIGINT};
+	names = {"line_type", "content", "line_number", "old_line_number", "new_line_number"};
+	auto bind_data = make_uniq<TextDiffLinesBindData>();
+	bind_data->diff = input.inputs[0];
+	return std::move(bind_data);
 }
 
-static unique_ptr<GlobalTableFunctionState> TextDiffLinesInit(ClientContext &context, TableFunctionInitInput &input) {
-	// For now, return empty data - full implementation would parse TextDiff argument
+// Line records of a TEXTDIFF value, read field by field
+static vector<TextDiff::DiffLine> TextDiffLinesFromValue(const Value &diff) {
 	vector<TextDiff::DiffLine> lines;
-	lines.emplace_back(TextDiff::LineType::CONTEXT, "Hello", 1, 1);
-	lines.emplace_back(TextDiff::LineType::REMOVED, "World", 2, 0);
-	lines.emplace_back(TextDiff::LineType::ADDED, "DuckDB", 0, 2);
+	auto &fields = StructValue::GetChildren(diff);
+	if (fields[TEXTDIFF_CONTENT].IsNull() || fields[TEXTDIFF_LINES].IsNull()) {
+		return lines;
+	}
+	auto &content = StringValue::Get(fields[TEXTDIFF_CONTENT]);
+	for (auto &line : ListValue::GetChildren(fields[TEXTDIFF_LINES])) {
+		auto &line_fields = StructValue::GetChildren(line);
+		auto field = [&](idx_t f) {
+			return line_fields[f].IsNull() ? idx_t(0) : line_fields[f].GetValue<idx_t>();
+		};
+		idx_t offset = MinValue<idx_t>(field(LINE_OFFSET), content.size());
+		idx_t length = MinValue<idx_t>(field(LINE_LENGTH), content.size() - offset);
+		lines.emplace_back(static_cast<TextDiff::LineType>(field(LINE_TYPE)), content.substr(offset, length),
+		                   field(LINE_OLD_NUMBER), field(LINE_NEW_NUMBER));
+	}
+	return lines;
+}
+
+static unique_ptr<GlobalTableFunctionState> TextDiffLinesInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<TextDiffLinesBindData>();
+	auto &diff = bind_data.diff;
+	if (diff.IsNull()) {
+		return make_uniq<TextDiffLinesData>(vector<TextDiff::DiffLine>());
+	}
+	if (diff.type().id() == LogicalTypeId::STRUCT) {
+		return make_uniq<TextDiffLinesData>(TextDiffLinesFromValue(diff));
+	}
+	auto parsed = TextDiff::FromString(StringValue::Get(diff));
+	return make_uniq<TextDiffLinesData>(parsed.GetLines());
+}
+
+static const char *LineTypeName(TextDiff::LineType type) {
+	switch (type) {
+	case TextDiff::LineType::ADDED:
+		return "ADDED";
+	case TextDiff::LineType::REMOVED:
+		return "REMOVED";
+	case TextDiff::LineType::MODIFIED:
+		return "MODIFIED";
+	case TextDiff::LineType::HUNK:
+		return "HUNK";
+	default:
+		return "CONTEXT";
+	}
+}
 
-	return make_uniq<TextDiffLinesData>(std::move(lines));
+// Writes the text_diff_lines columns of one line, starting at column `col`
+static void WriteDiffLineRow(DataChunk &output, idx_t col, idx_t row, const TextDiff::DiffLine &line,
+                             idx_t line_number) {
+	output.SetValue(col, row, Value(LineTypeName(line.type)));
+	output.SetValue(col + 1, row, Value(line.content));
+	output.SetValue(col + 2, row, Value::BIGINT(static_cast<int64_t>(line_number)));
+	output.SetValue(col + 3, row,
+	                line.old_line_number ? Value::BIGINT(static_cast<int64_t>(line.old_line_number)) : Value());
+	output.SetValue(col + 4, row,
+	                line.new_line_number ? Value::BIGINT(static_cast<int64_t>(line.new_line_number)) : Value());
 }
 
 static void TextDiffLinesFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
@@ -273,29 +834,7 @@ static void TextDiffLinesFunction(ClientContext &context, TableFunctionInput &da
 
 	idx_t output_idx = 0;
 	while (data.position < data.lines.size() && output_idx < STANDARD_VECTOR_SIZE) {
-		const auto &line = data.lines[data.position];
-
-		// Set line_type
-		string line_type_str;
-		switch (line.type) {
-		case TextDiff::LineType::CONTEXT:
-			line_type_str = "CONTEXT";
-			break;
-		case TextDiff::LineType::ADDED:
-			line_type_str = "ADDED";
-			break;
-		case TextDiff::LineType::REMOVED:
-			line_type_str = "REMOVED";
-			break;
-		case TextDiff::LineType::MODIFIED:
-			line_type_str = "MODIFIED";
-			break;
-		}
-
-		output.SetValue(0, output_idx, Value(line_type_str));
-		output.SetValue(1, output_idx, Value(line.content));
-		output.SetValue(2, output_idx, Value::BIGINT(static_cast<int64_t>(data.position + 1)));
-
+		WriteDiffLineRow(output, 0, output_idx, data.lines[data.position], data.position + 1);
 		data.position++;
 		output_idx++;
 	}
@@ -312,25 +851,31 @@ struct ReadGitDiffBindData : public FunctionData {
 	string path1;
 	string path2;
 	bool include_metadata;
+	TextDiff::Options options;
+	// Emit line counts instead of diff_text
+	bool stats_only;
 
-	ReadGitDiffBindData(string p1, string p2, bool metadata)
-	    : path1(std::move(p1)), path2(std::move(p2)), include_metadata(metadata) {
+	ReadGitDiffBindData(string p1, string p2, bool metadata, TextDiff::Options options_p, bool stats_only_p)
+	    : path1(std::move(p1)), path2(std::move(p2)), include_metadata(metadata), options(options_p),
+	      stats_only(stats_only_p) {
 	}
 
 	unique_ptr<FunctionData> Copy() const override {
-		return make_uniq<ReadGitDiffBindData>(path1, path2, include_metadata);
+		return make_uniq<ReadGitDiffBindData>(path1, path2, include_metadata, options, stats_only);
 	}
 
 	bool Equals(const FunctionData &other) const override {
 		auto &other_data = other.Cast<ReadGitDiffBindData>();
 		return path1 == other_data.path1 && path2 == other_data.path2 &&
-		       include_metadata == other_data.include_metadata;
+		       include_metadata == other_data.include_metadata && options == other_data.options &&
+		       stats_only == other_data.stats_only;
 	}
 };
 
 // Global state for execution
 struct ReadGitDiffData : public GlobalTableFunctionState {
 	string diff_text;
+	TextDiff::Stats stats; // stats_only
 	string path1;
 	string path2;
 	bool include_metadata;
@@ -355,9 +900,26 @@ static unique_ptr<FunctionData> ReadGitDiffBind(ClientContext &context, TableFun
 		path2 = path1 + "@HEAD"; // Default comparison
 	}
 
+	TextDiff::Options options;
+	bool stats_only = false;
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "algorithm") {
+			options.algorithm = ParseDiffAlgorithm(kv.second.ToString());
+		} else if (kv.first == "context_lines") {
+			options.context_lines = ParseContextLines(kv.second);
+		} else if (kv.first == "stats_only") {
+			stats_only = BooleanValue::Get(kv.second);
+		}
+	}
+
 	// Basic return columns
-	return_types = {LogicalType::VARCHAR};
-	names = {"diff_text"};
+	if (stats_only) {
+		return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+		names = {"lines_added", "lines_removed", "lines_context"};
+	} else {
+		return_types = {LogicalType::VARCHAR};
+		names = {"diff_text"};
+	}
 
 	// TODO: Add metadata columns when include_metadata parameter is implemented
 	// For now, also include basic path info
@@ -367,7 +929,64 @@ static unique_ptr<FunctionData> ReadGitDiffBind(ClientContext &context, TableFun
 	names.push_back("path2");
 
 	// Store arguments in bind data
-	return make_uniq<ReadGitDiffBindData>(path1, path2, true);
+	return make_uniq<ReadGitDiffBindData>(path1, path2, true, options, stats_only);
+}
+
+// Diffs (or counts) two buffers into the scan state
+static unique_ptr<ReadGitDiffData> DiffContents(const ReadGitDiffBindData &bind_data, const char *old_data,
+                                                idx_t old_size, const char *new_data, idx_t new_size) {
+	auto data = make_uniq<ReadGitDiffData>(string(), bind_data.path1, bind_data.path2, bind_data.include_metadata);
+	if (bind_data.stats_only) {
+		data->stats = TextDiff::ComputeStats(old_data, old_size, new_data, new_size, bind_data.options);
+	} else {
+		data->diff_text = TextDiff::CreateDiff(old_data, old_size, new_data, new_size, bind_data.options).ToString();
+	}
+	return data;
+}
+
+static bool IsLFSPointerBlob(git_blob *blob) {
+	static constexpr const char LFS_HEADER[] = "version https://git-lfs.github.com/spec/v1";
+	auto size = static_cast<idx_t>(git_blob_rawsize(blob));
+	return size <= 1024 && size >= sizeof(LFS_HEADER) - 1 &&
+	       memcmp(git_blob_rawcontent(blob), LFS_HEADER, sizeof(LFS_HEADER) - 1) == 0;
+}
+
+// Fast path for two git:// URIs of committed files in the same repository:
+// the files are compared by blob id, so an unchanged file costs two tree
+// lookups and no content is read. Changed blobs are diffed straight from the
+// object database. Returns nullptr when the general path has to handle the
+// arguments (other repositories, pseudo-refs, missing files, LFS objects).
+static unique_ptr<ReadGitDiffData> TryDiffGitBlobs(const ReadGitDiffBindData &bind_data) {
+	string old_repo, new_repo;
+	git_oid old_id, new_id;
+	if (!TryGetGitUriBlobId(bind_data.path1, old_repo, old_id) ||
+	    !TryGetGitUriBlobId(bind_data.path2, new_repo, new_id) || old_repo != new_repo) {
+		return nullptr;
+	}
+	if (git_oid_equal(&old_id, &new_id)) {
+		// Same blob, same content
+		return DiffContents(bind_data, "", 0, "", 0);
+	}
+
+	ScopedGitRepo repo(old_repo);
+	git_blob *old_blob = nullptr;
+	git_blob *new_blob = nullptr;
+	if (!repo.is_valid() || git_blob_lookup(&old_blob, repo, &old_id) != 0) {
+		return nullptr;
+	}
+	auto old_guard = MakeGitBlob(old_blob);
+	if (git_blob_lookup(&new_blob, repo, &new_id) != 0) {
+		return nullptr;
+	}
+	auto new_guard = MakeGitBlob(new_blob);
+	if (IsLFSPointerBlob(old_blob) || IsLFSPointerBlob(new_blob)) {
+		// The file system resolves pointers to the LFS objects
+		return nullptr;
+	}
+	return DiffContents(bind_data, static_cast<const char *>(git_blob_rawcontent(old_blob)),
+	                    static_cast<idx_t>(git_blob_rawsize(old_blob)),
+	                    static_cast<const char *>(git_blob_rawcontent(new_blob)),
+	                    static_cast<idx_t>(git_blob_rawsize(new_blob)));
 }
 
 static unique_ptr<GlobalTableFunctionState> ReadGitDiffInit(ClientContext &context, TableFunctionInitInput &input) {
@@ -377,6 +996,11 @@ static unique_ptr<GlobalTableFunctionState> ReadGitDiffInit(ClientContext &conte
 	string path2 = bind_data.path2;
 
 	try {
+		auto blob_diff = TryDiffGitBlobs(bind_data);
+		if (blob_diff) {
+			return std::move(blob_diff);
+		}
+
 		// Read actual file content using DuckDB filesystem
 		auto &fs = FileSystem::GetFileSystem(context);
 
@@ -407,12 +1031,13 @@ static unique_ptr<GlobalTableFunctionState> ReadGitDiffInit(ClientContext &conte
 		}
 
 		// Create diff using our TextDiff implementation
-		auto diff = TextDiff::CreateDiff(content1, content2);
-		string diff_text = diff.ToString();
-
-		return make_uniq<ReadGitDiffData>(std::move(diff_text), path1, path2, bind_data.include_metadata);
+		return DiffContents(bind_data, content1.data(), content1.size(), content2.data(), content2.size());
 
 	} catch (const std::exception &e) {
+		if (bind_data.stats_only) {
+			// There is no text column to carry the error
+			throw;
+		}
 		// Return error in diff_text for now
 		string error_diff = "Error: " + string(e.what());
 		return make_uniq<ReadGitDiffData>(std::move(error_diff), path1, path2, bind_data.include_metadata);
@@ -420,6 +1045,7 @@ static unique_ptr<GlobalTableFunctionState> ReadGitDiffInit(ClientContext &conte
 }
 
 static void ReadGitDiffFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<ReadGitDiffBindData>();
 	auto &data = data_p.global_state->Cast<ReadGitDiffData>();
 
 	if (data.returned_row) {
@@ -429,45 +1055,394 @@ static void ReadGitDiffFunction(ClientContext &context, TableFunctionInput &data
 	}
 
 	// Return the diff data
-	output.SetValue(0, 0, Value(data.diff_text));
-	output.SetValue(1, 0, Value(data.path1));
-	output.SetValue(2, 0, Value(data.path2));
+	idx_t col = 0;
+	if (bind_data.stats_only) {
+		output.SetValue(col++, 0, Value::BIGINT(static_cast<int64_t>(data.stats.lines_added)));
+		output.SetValue(col++, 0, Value::BIGINT(static_cast<int64_t>(data.stats.lines_removed)));
+		output.SetValue(col++, 0, Value::BIGINT(static_cast<int64_t>(data.stats.lines_context)));
+	} else {
+		output.SetValue(col++, 0, Value(data.diff_text));
+	}
+	output.SetValue(col++, 0, Value(data.path1));
+	output.SetValue(col++, 0, Value(data.path2));
 
 	data.returned_row = true;
 	output.SetCardinality(1);
 }
 
+//===--------------------------------------------------------------------===//
+// LATERAL (read_git_diff_each)
+//===--------------------------------------------------------------------===//
+
+// One (old_uri, new_uri) input row and its diff
+struct GitDiffEachPair {
+	string old_uri; // empty for NULL
+	string new_uri;
+	TextDiff::Options options;
+	TextDiff diff;
+	ErrorData error;
+};
+
+struct ReadGitDiffEachLocalState : public LocalTableFunctionState {
+	vector<GitDiffEachPair> pairs; // by row of the current input chunk
+	bool computed = false;
+	idx_t current_pair = 0;
+	idx_t current_line = 0;
+};
+
+// One side of a pair: a blob id to look up, or a buffer read from the
+// working directory. A URI whose file does not exist reads as empty, so
+// added and deleted files diff against nothing.
+struct GitDiffEachSide {
+	string repo_path;
+	bool has_id = false;
+	git_oid id;
+	string buffer;
+	git_blob *blob = nullptr;
+
+	~GitDiffEachSide() {
+		if (blob) {
+			git_blob_free(blob);
+		}
+	}
+	const char *Data() const {
+		return blob ? static_cast<const char *>(git_blob_rawcontent(blob)) : buffer.data();
+	}
+	idx_t Size() const {
+		return blob ? static_cast<idx_t>(git_blob_rawsize(blob)) : buffer.size();
+	}
+};
+
+// Goes through the client's file system so allowed_directories and
+// enable_external_access apply. False if the file does not exist.
+static bool ReadWholeFile(FileSystem &fs, const string &path, string &out) {
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+	if (!handle) {
+		return false;
+	}
+	auto size = NumericCast<idx_t>(handle->GetFileSize());
+	out.resize(size);
+	if (size > 0) {
+		handle->Read(&out[0], size);
+	}
+	return true;
+}
+
+static void ResolveDiffEachSide(FileSystem &fs, const string &uri, GitDiffEachSide &side) {
+	if (uri.empty()) {
+		return;
+	}
+	auto path = GitPath::Parse(StringUtil::StartsWith(uri, "git://") ? uri : "git://" + uri);
+	string revision = path.revision.empty() ? "HEAD" : path.revision;
+	auto upper = StringUtil::Upper(revision);
+	if (upper == "WORKDIR" || upper == "WORKTREE") {
+		string full_path;
+		try {
+			full_path = SafeWorkdirPath(path.repository_path, path.file_path);
+		} catch (const std::exception &) {
+			if (fs.FileExists(GetWorkdirRoot(path.repository_path) + path.file_path)) {
+				throw; // exists, but outside the working directory
+			}
+			return;
+		}
+		if (!ReadWholeFile(fs, full_path, side.buffer)) {
+			throw IOException("read_git_diff_each: failed to read '%s'", full_path);
+		}
+		return;
+	}
+
+	side.repo_path = path.repository_path;
+	ScopedGitRepo repo(side.repo_path);
+	if (!repo.is_valid()) {
+		throw IOException("read_git_diff_each: failed to open repository '%s'", side.repo_path);
+	}
+	if (upper == "STAGED" || upper == "INDEX") {
+		git_index *index = nullptr;
+		if (git_repository_index(&index, repo) != 0) {
+			const git_error *e = git_error_last();
+			throw IOException("read_git_diff_each: failed to read index: %s", e ? e->message : "Unknown error");
+		}
+		auto index_guard = MakeGitIndex(index);
+		auto entry = git_index_get_bypath(index, path.file_path.c_str(), 0);
+		if (entry) {
+			git_oid_cpy(&side.id, &entry->id);
+			side.has_id = true;
+		}
+		return;
+	}
+
+	git_object *obj = nullptr;
+	if (git_revparse_single(&obj, repo, revision.c_str()) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("read_git_diff_each: unable to resolve '%s': %s", uri, e ? e->message : "Unknown error");
+	}
+	side.has_id = LookupTreeBlobId(obj, path.file_path, side.id);
+	git_object_free(obj);
+}
+
+static void LoadDiffEachBlob(const string &uri, GitDiffEachSide &side) {
+	if (!side.has_id) {
+		return;
+	}
+	ScopedGitRepo repo(side.repo_path);
+	if (!repo.is_valid() || git_blob_lookup(&side.blob, repo, &side.id) != 0) {
+		const git_error *e = git_error_last();
+		throw IOException("read_git_diff_each: failed to load blob for '%s': %s", uri,
+		                  e ? e->message : "Unknown error");
+	}
+}
+
+// Both sides are resolved to blob ids first: equal ids give an empty diff
+// without loading either blob.
+static void ComputeDiffEachPair(FileSystem &fs, GitDiffEachPair &pair) {
+	try {
+		GitDiffEachSide old_side, new_side;
+		ResolveDiffEachSide(fs, pair.old_uri, old_side);
+		ResolveDiffEachSide(fs, pair.new_uri, new_side);
+		if (old_side.has_id && new_side.has_id && git_oid_equal(&old_side.id, &new_side.id)) {
+			return;
+		}
+		LoadDiffEachBlob(pair.old_uri, old_side);
+		LoadDiffEachBlob(pair.new_uri, new_side);
+		pair.diff = TextDiff::CreateDiff(old_side.Data(), old_side.Size(), new_side.Data(), new_side.Size(),
+		                                 pair.options);
+	} catch (const std::exception &e) {
+		pair.error = ErrorData(e);
+	}
+}
+
+// Pairs are independent, so they are handed out to the scheduler's workers
+// through a shared counter. Repository handles come from each thread's own
+// pool since libgit2 objects are not shared across threads.
+static void ComputeDiffEachPairs(ClientContext &context, vector<GitDiffEachPair> &pairs) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	idx_t num_workers = MinValue<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads(), pairs.size());
+	std::atomic<idx_t> next_pair(0);
+	RunParallelWorkers(context, num_workers, [&](idx_t worker) {
+		while (true) {
+			idx_t i = next_pair.fetch_add(1);
+			if (i >= pairs.size()) {
+				break;
+			}
+			ComputeDiffEachPair(fs, pairs[i]);
+		}
+	});
+}
+
+static void ReadGitDiffEachColumns(vector<LogicalType> &return_types, vector<string> &names) {
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::BIGINT};
+	names = {"old_uri", "new_uri", "line_type", "content", "line_number", "old_line_number", "new_line_number"};
+}
+
+static unique_ptr<FunctionData> ReadGitDiffEachBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	// LATERAL: arguments arrive at runtime via the input DataChunk
+	if (!input.inputs.empty()) {
+		throw BinderException("read_git_diff_each takes LATERAL arguments or a subquery of pairs. For direct calls, "
+		                      "use read_git_diff(...) instead");
+	}
+	ReadGitDiffEachColumns(return_types, names);
+	return make_uniq<TableFunctionData>();
+}
+
+// read_git_diff_each((SELECT old_uri, new_uri[, context_lines] FROM ...)):
+// the subquery streams in whole chunks, so many pairs are diffed per call.
+// A correlated LATERAL call gets one row at a time instead.
+static unique_ptr<FunctionData> ReadGitDiffEachTableBind(ClientContext &context, TableFunctionBindInput &input,
+                                                         vector<LogicalType> &return_types, vector<string> &names) {
+	auto &types = input.input_table_types;
+	if (types.size() < 2 || types.size() > 3 || types[0].id() != LogicalTypeId::VARCHAR ||
+	    types[1].id() != LogicalTypeId::VARCHAR || (types.size() == 3 && !types[2].IsIntegral())) {
+		throw BinderException("read_git_diff_each: the subquery must return (old_uri VARCHAR, new_uri VARCHAR[, "
+		                      "context_lines INTEGER])");
+	}
+	ReadGitDiffEachColumns(return_types, names);
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<LocalTableFunctionState> ReadGitDiffEachLocalInit(ExecutionContext &context,
+                                                                    TableFunctionInitInput &input,
+                                                                    GlobalTableFunctionState *global_state) {
+	return make_uniq<ReadGitDiffEachLocalState>();
+}
+
+// Reads the pairs of the input chunk; the optional third column is context_lines
+static void ReadDiffEachInput(DataChunk &input, vector<GitDiffEachPair> &pairs) {
+	UnifiedVectorFormat old_format, new_format, context_format;
+	input.data[0].ToUnifiedFormat(input.size(), old_format);
+	input.data[1].ToUnifiedFormat(input.size(), new_format);
+	bool has_context = input.ColumnCount() > 2;
+	if (has_context) {
+		input.data[2].ToUnifiedFormat(input.size(), context_format);
+	}
+	auto old_uris = UnifiedVectorFormat::GetData<string_t>(old_format);
+	auto new_uris = UnifiedVectorFormat::GetData<string_t>(new_format);
+
+	pairs.clear();
+	pairs.resize(input.size());
+	for (idx_t row = 0; row < input.size(); row++) {
+		auto &pair = pairs[row];
+		auto old_idx = old_format.sel->get_index(row);
+		auto new_idx = new_format.sel->get_index(row);
+		if (old_format.validity.RowIsValid(old_idx)) {
+			pair.old_uri = old_uris[old_idx].GetString();
+		}
+		if (new_format.validity.RowIsValid(new_idx)) {
+			pair.new_uri = new_uris[new_idx].GetString();
+		}
+		if (has_context) {
+			auto context_idx = context_format.sel->get_index(row);
+			if (context_format.validity.RowIsValid(context_idx)) {
+				// Any integer type from a subquery
+				pair.options.context_lines = ParseContextLines(input.data[2].GetValue(row));
+			}
+		}
+	}
+}
+
+// The whole input chunk is diffed at once, in parallel when it holds more
+// than one pair, then its lines are emitted pair by pair. Each line row
+// carries its pair's URIs.
+static OperatorResultType ReadGitDiffEachFunction(ExecutionContext &context, TableFunctionInput &data_p,
+                                                  DataChunk &input, DataChunk &output) {
+	auto &state = data_p.local_state->Cast<ReadGitDiffEachLocalState>();
+	D_ASSERT(input.ColumnCount() >= 2);
+
+	if (!state.computed) {
+		ReadDiffEachInput(input, state.pairs);
+		ComputeDiffEachPairs(context.client, state.pairs);
+		for (auto &pair : state.pairs) {
+			if (pair.error.HasError()) {
+				pair.error.Throw();
+			}
+		}
+		state.computed = true;
+		state.current_pair = 0;
+		state.current_line = 0;
+	}
+
+	idx_t output_count = 0;
+	while (output_count < STANDARD_VECTOR_SIZE && state.current_pair < state.pairs.size()) {
+		auto &pair = state.pairs[state.current_pair];
+		auto &lines = pair.diff.GetLines();
+		if (state.current_line >= lines.size()) {
+			state.current_pair++;
+			state.current_line = 0;
+			continue;
+		}
+		output.SetValue(0, output_count, pair.old_uri.empty() ? Value() : Value(pair.old_uri));
+		output.SetValue(1, output_count, pair.new_uri.empty() ? Value() : Value(pair.new_uri));
+		WriteDiffLineRow(output, 2, output_count, lines[state.current_line], state.current_line + 1);
+		state.current_line++;
+		output_count++;
+	}
+	output.SetCardinality(output_count);
+
+	if (state.current_pair >= state.pairs.size()) {
+		state.pairs.clear();
+		state.computed = false;
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+	return OperatorResultType::HAVE_MORE_OUTPUT;
+}
+
 void RegisterTextDiffType(ExtensionLoader &loader) {
 	// Register text_diff function
-	auto text_diff_func = ScalarFunction("text_diff", {LogicalType::VARCHAR, LogicalType::VARCHAR},
-	                                     LogicalType::VARCHAR, TextDiffFunction);
-	loader.RegisterFunction(text_diff_func);
+	// TEXTDIFF renders as diff_text() output wherever a VARCHAR is expected
+	auto text_diff_type = TextDiffType();
+	loader.RegisterType("TEXTDIFF", text_diff_type);
+	loader.RegisterCastFunction(text_diff_type, LogicalType::VARCHAR, BoundCastInfo(TextDiffToVarcharCast), 1);
+
+	ScalarFunctionSet text_diff_set("text_diff");
+	text_diff_set.AddFunction(
+	    ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, text_diff_type, TextDiffFunction));
+	// text_diff(old, new, algorithm)
+	text_diff_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                                         text_diff_type, TextDiffFunction));
+	// text_diff(old, new, context_lines)
+	text_diff_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER},
+	                                         text_diff_type, TextDiffFunction));
+	// text_diff(old, new, algorithm, context_lines)
+	text_diff_set.AddFunction(ScalarFunction(
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER}, text_diff_type,
+	    TextDiffFunction));
+	loader.RegisterFunction(text_diff_set);
 
 	// Register diff_text function (Phase 2 main function)
-	auto diff_text_func = ScalarFunction("diff_text", {LogicalType::VARCHAR, LogicalType::VARCHAR},
-	                                     LogicalType::VARCHAR, DiffTextFunction);
-	loader.RegisterFunction(diff_text_func);
+	ScalarFunctionSet diff_text_set("diff_text");
+	diff_text_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
+	                                         DiffTextFunction));
+	// diff_text(old, new, algorithm)
+	diff_text_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                                         LogicalType::VARCHAR, DiffTextFunction));
+	// diff_text(old, new, context_lines)
+	diff_text_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER},
+	                                         LogicalType::VARCHAR, DiffTextFunction));
+	// diff_text(old, new, algorithm, context_lines)
+	diff_text_set.AddFunction(ScalarFunction(
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER},
+	    LogicalType::VARCHAR, DiffTextFunction));
+	loader.RegisterFunction(diff_text_set);
 
 	// Register text_diff_stats function
-	auto stats_func =
-	    ScalarFunction("text_diff_stats", {LogicalType::VARCHAR}, LogicalType::VARCHAR, TextDiffStatsFunction);
-	loader.RegisterFunction(stats_func);
+	ScalarFunctionSet stats_set("text_diff_stats");
+	stats_set.AddFunction(ScalarFunction({text_diff_type}, TextDiffStatsType(), TextDiffStatsFunction));
+	stats_set.AddFunction(ScalarFunction({LogicalType::VARCHAR}, TextDiffStatsType(), TextDiffStatsTextFunction));
+	// text_diff_stats(old, new[, algorithm][, context_lines])
+	stats_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, TextDiffStatsType(),
+	                                     TextDiffStatsPairFunction));
+	stats_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                                     TextDiffStatsType(), TextDiffStatsPairFunction));
+	stats_set.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER},
+	                                     TextDiffStatsType(), TextDiffStatsPairFunction));
+	stats_set.AddFunction(ScalarFunction(
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER}, TextDiffStatsType(),
+	    TextDiffStatsPairFunction));
+	loader.RegisterFunction(stats_set);
 
 	// Register text_diff_lines table function
-	TableFunction lines_func("text_diff_lines", {LogicalType::VARCHAR}, TextDiffLinesFunction, TextDiffLinesBind,
-	                         TextDiffLinesInit);
-	loader.RegisterFunction(lines_func);
+	TableFunctionSet lines_set("text_diff_lines");
+	lines_set.AddFunction(
+	    TableFunction({text_diff_type}, TextDiffLinesFunction, TextDiffLinesBind, TextDiffLinesInit));
+	lines_set.AddFunction(
+	    TableFunction({LogicalType::VARCHAR}, TextDiffLinesFunction, TextDiffLinesBind, TextDiffLinesInit));
+	loader.RegisterFunction(lines_set);
 
 	// Register read_git_diff table function (Phase 2 main function)
 	// Single-argument version
 	TableFunction read_git_diff_func_1("read_git_diff", {LogicalType::VARCHAR}, ReadGitDiffFunction, ReadGitDiffBind,
 	                                   ReadGitDiffInit);
+	read_git_diff_func_1.named_parameters["algorithm"] = LogicalType::VARCHAR;
+	read_git_diff_func_1.named_parameters["context_lines"] = LogicalType::INTEGER;
+	read_git_diff_func_1.named_parameters["stats_only"] = LogicalType::BOOLEAN;
 	loader.RegisterFunction(read_git_diff_func_1);
 
 	// Two-argument version
 	TableFunction read_git_diff_func_2("read_git_diff", {LogicalType::VARCHAR, LogicalType::VARCHAR},
 	                                   ReadGitDiffFunction, ReadGitDiffBind, ReadGitDiffInit);
+	read_git_diff_func_2.named_parameters["algorithm"] = LogicalType::VARCHAR;
+	read_git_diff_func_2.named_parameters["context_lines"] = LogicalType::INTEGER;
+	read_git_diff_func_2.named_parameters["stats_only"] = LogicalType::BOOLEAN;
 	loader.RegisterFunction(read_git_diff_func_2);
+
+	// read_git_diff_each takes LATERAL arguments or a subquery of pairs; named
+	// parameters are not delivered to in_out_function binds, so context_lines
+	// is positional
+	TableFunctionSet read_git_diff_each_set("read_git_diff_each");
+	TableFunction read_git_diff_each_2({LogicalType::VARCHAR, LogicalType::VARCHAR}, nullptr, ReadGitDiffEachBind,
+	                                   nullptr, ReadGitDiffEachLocalInit);
+	read_git_diff_each_2.in_out_function = ReadGitDiffEachFunction;
+	read_git_diff_each_set.AddFunction(read_git_diff_each_2);
+	TableFunction read_git_diff_each_3({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER}, nullptr,
+	                                   ReadGitDiffEachBind, nullptr, ReadGitDiffEachLocalInit);
+	read_git_diff_each_3.in_out_function = ReadGitDiffEachFunction;
+	read_git_diff_each_set.AddFunction(read_git_diff_each_3);
+	TableFunction read_git_diff_each_table({LogicalType::TABLE}, nullptr, ReadGitDiffEachTableBind, nullptr,
+	                                       ReadGitDiffEachLocalInit);
+	read_git_diff_each_table.in_out_function = ReadGitDiffEachFunction;
+	read_git_diff_each_set.AddFunction(read_git_diff_each_table);
+	loader.RegisterFunction(read_git_diff_each_set);
 }
 
 } // namespace duckdb
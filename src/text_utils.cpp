@@ -0,0 +1,129 @@
+#include "text_utils.hpp"
+#include "duckdb/common/types/hash.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+bool IsValidUTF8(const char *data, size_t length) {
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+	size_t i = 0;
+	while (i < length) {
+		// Fast path: skip 8 ASCII bytes at a time.
+		while (i + sizeof(uint64_t) <= length) {
+			uint64_t word;
+			memcpy(&word, bytes + i, sizeof(word));
+			if (word & HIGH_BITS) {
+				break;
+			}
+			i += sizeof(uint64_t);
+		}
+		if (i >= length) {
+			break;
+		}
+
+		unsigned char byte = bytes[i];
+		if (byte <= 0x7F) {
+			i++;
+			continue;
+		}
+		int num_bytes = 0;
+		if ((byte & 0xE0) == 0xC0) {
+			num_bytes = 2;
+		} else if ((byte & 0xF0) == 0xE0) {
+			num_bytes = 3;
+		} else if ((byte & 0xF8) == 0xF0) {
+			num_bytes = 4;
+		} else {
+			return false;
+		}
+		if (i + num_bytes > length) {
+			return false;
+		}
+		for (int j = 1; j < num_bytes; j++) {
+			if ((bytes[i + j] & 0xC0) != 0x80) {
+				return false;
+			}
+		}
+		i += num_bytes;
+	}
+	return true;
+}
+
+void SplitLineViews(const char *data, size_t length, vector<string_t> &lines, bool strip_cr) {
+	const char *pos = data;
+	const char *end = data + length;
+	while (pos < end) {
+		auto newline = static_cast<const char *>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+		const char *line_end = newline ? newline : end;
+		const char *content_end = line_end;
+		if (strip_cr && content_end > pos && content_end[-1] == '\r') {
+			content_end--;
+		}
+		lines.emplace_back(pos, UnsafeNumericCast<uint32_t>(content_end - pos));
+		if (!newline) {
+			break;
+		}
+		pos = newline + 1;
+	}
+}
+
+void TokenizeLines(const char *data, size_t length, vector<LineToken> &lines, bool strip_cr) {
+	const char *pos = data;
+	const char *end = data + length;
+	while (pos < end) {
+		auto newline = static_cast<const char *>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+		const char *line_end = newline ? newline : end;
+		const char *content_end = line_end;
+		if (strip_cr && content_end > pos && content_end[-1] == '\r') {
+			content_end--;
+		}
+		auto line_length = UnsafeNumericCast<uint32_t>(content_end - pos);
+		lines.push_back(LineToken {static_cast<uint64_t>(pos - data), line_length, Hash(pos, line_length)});
+		if (!newline) {
+			break;
+		}
+		pos = newline + 1;
+	}
+}
+
+static inline uint64_t RotateLeft(uint64_t value, int bits) {
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// MurmurHash3's 64-bit finalizer
+static inline uint64_t Avalanche(uint64_t value) {
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+ContentHash HashContent(const char *data, size_t length) {
+	static constexpr uint64_t K1 = 0x87c37b91114253d5ULL;
+	static constexpr uint64_t K2 = 0x4cf5ad432745937fULL;
+	uint64_t h1 = 0x9e3779b97f4a7c15ULL ^ length;
+	uint64_t h2 = 0xc2b2ae3d27d4eb4fULL + length;
+
+	size_t pos = 0;
+	for (; pos + 8 <= length; pos += 8) {
+		uint64_t word;
+		memcpy(&word, data + pos, 8);
+		h1 = RotateLeft(h1 ^ (word * K1), 31) * K2;
+		h2 = RotateLeft(h2 + (word * K2), 27) * K1 + 0x52dce729;
+	}
+	uint64_t tail = 0;
+	memcpy(&tail, data + pos, length - pos);
+	h1 ^= tail * K1;
+	h2 += tail * K2;
+
+	h1 = Avalanche(h1 + h2);
+	h2 = Avalanche(h2 ^ h1);
+	return ContentHash {h1, h2};
+}
+
+} // namespace duckdb
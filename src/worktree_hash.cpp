@@ -0,0 +1,214 @@
+#include "worktree_hash.hpp"
+#include "git_repo_pool.hpp"
+#include "git_utils.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <openssl/evp.h>
+
+#include <atomic>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+static constexpr const char *FAST_HASH_SETTING = "duck_tails_fast_hash";
+static constexpr idx_t HASH_BATCH_SIZE = 64;
+static constexpr size_t HASH_READ_BUFFER_SIZE = 128 * 1024;
+
+void RegisterWorktreeHashSettings(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(FAST_HASH_SETTING,
+	                          "Hash unfiltered worktree files with OpenSSL SHA-1 (git_status engine := 'parallel', "
+	                          "WORKDIR git_tree and git_read)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+bool FastHashEnabled(ClientContext &context) {
+	Value value;
+	if (!context.TryGetCurrentSetting(FAST_HASH_SETTING, value) || value.IsNull()) {
+		return false;
+	}
+	return BooleanValue::Get(value);
+}
+
+//===--------------------------------------------------------------------===//
+// OpenSSL blob hasher
+//===--------------------------------------------------------------------===//
+
+// SHA-1 over "blob <size>\0" followed by the content, fed in pieces.
+class BlobHasher {
+public:
+	explicit BlobHasher(size_t size) : ctx(EVP_MD_CTX_new()) {
+		ok = ctx && EVP_DigestInit_ex(ctx, EVP_sha1(), nullptr) == 1;
+		char header[64];
+		int header_len = snprintf(header, sizeof(header), "blob %llu", static_cast<unsigned long long>(size));
+		// The header includes its terminating NUL.
+		Update(header, static_cast<size_t>(header_len) + 1);
+	}
+	~BlobHasher() {
+		EVP_MD_CTX_free(ctx);
+	}
+	BlobHasher(const BlobHasher &) = delete;
+	BlobHasher &operator=(const BlobHasher &) = delete;
+
+	void Update(const void *data, size_t length) {
+		if (ok && length > 0) {
+			ok = EVP_DigestUpdate(ctx, data, length) == 1;
+		}
+	}
+
+	bool Finish(git_oid &out) {
+		unsigned char digest[EVP_MAX_MD_SIZE];
+		unsigned int digest_len = 0;
+		if (!ok || EVP_DigestFinal_ex(ctx, digest, &digest_len) != 1 || digest_len != GIT_OID_RAWSZ) {
+			return false;
+		}
+		return git_oid_fromraw(&out, digest) == 0;
+	}
+
+private:
+	EVP_MD_CTX *ctx;
+	bool ok;
+};
+
+static bool FastHashBuffer(const char *data, size_t length, git_oid &out) {
+	BlobHasher hasher(length);
+	hasher.Update(data, length);
+	return hasher.Finish(out);
+}
+
+// Streams a regular file through the hasher. The size comes from the open
+// handle; a file that changes length while being read fails the hash.
+static bool FastHashRegularFile(const string &full_path, git_oid &out) {
+	FILE *f = fopen(full_path.c_str(), "rb");
+	if (!f) {
+		return false;
+	}
+	if (fseek(f, 0, SEEK_END) != 0) {
+		fclose(f);
+		return false;
+	}
+	long size = ftell(f);
+	if (size < 0 || fseek(f, 0, SEEK_SET) != 0) {
+		fclose(f);
+		return false;
+	}
+
+	BlobHasher hasher(static_cast<size_t>(size));
+	vector<char> buffer(HASH_READ_BUFFER_SIZE);
+	size_t total = 0;
+	size_t n;
+	while ((n = fread(buffer.data(), 1, buffer.size(), f)) > 0) {
+		hasher.Update(buffer.data(), n);
+		total += n;
+	}
+	bool read_ok = !ferror(f) && total == static_cast<size_t>(size);
+	fclose(f);
+	return read_ok && hasher.Finish(out);
+}
+
+// True when no filter (CRLF, ident, LFS, ...) applies to rel_path on its way
+// into the object database, i.e. the on-disk bytes are the blob content.
+static bool IsUnfiltered(git_repository *repo, const string &rel_path) {
+	git_filter_list *filters = nullptr;
+	if (git_filter_list_load(&filters, repo, nullptr, rel_path.c_str(), GIT_FILTER_TO_ODB, GIT_FILTER_DEFAULT) != 0) {
+		return false;
+	}
+	if (filters) {
+		git_filter_list_free(filters);
+		return false;
+	}
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Public entry points
+//===--------------------------------------------------------------------===//
+
+bool HashWorktreeFile(git_repository *repo, const string &full_path, const string &rel_path, bool fast, git_oid &out) {
+#ifndef _WIN32
+	struct stat st;
+	if (lstat(full_path.c_str(), &st) != 0) {
+		return false;
+	}
+	if (S_ISLNK(st.st_mode)) {
+		vector<char> target(static_cast<size_t>(st.st_size) + 1);
+		ssize_t len = readlink(full_path.c_str(), target.data(), target.size());
+		if (len < 0) {
+			return false;
+		}
+		if (fast) {
+			return FastHashBuffer(target.data(), static_cast<size_t>(len), out);
+		}
+		return git_odb_hash(&out, target.data(), static_cast<size_t>(len), GIT_OBJECT_BLOB) == 0;
+	}
+#endif
+	if (fast && IsUnfiltered(repo, rel_path)) {
+		return FastHashRegularFile(full_path, out);
+	}
+	return git_repository_hashfile(&out, repo, full_path.c_str(), GIT_OBJECT_BLOB, rel_path.c_str()) == 0;
+}
+
+bool HashWorktreeContent(git_repository *repo, const string &full_path, const string &rel_path, const char *data,
+                         size_t length, bool fast, git_oid &out) {
+	if (!IsUnfiltered(repo, rel_path)) {
+		return git_repository_hashfile(&out, repo, full_path.c_str(), GIT_OBJECT_BLOB, rel_path.c_str()) == 0;
+	}
+	if (fast) {
+		return FastHashBuffer(data, length, out);
+	}
+	return git_odb_hash(&out, data, length, GIT_OBJECT_BLOB) == 0;
+}
+
+// Attribute and filter lookups go through the repository, so every worker
+// takes its thread's handle from GitRepoPool; inline runs use `repo`.
+void HashWorktreeFilesParallel(ClientContext &context, git_repository *repo, const string &repo_path,
+                               const string &workdir, const vector<string> &rel_paths, bool fast, idx_t max_threads,
+                               vector<git_oid> &oids, vector<bool> &ok) {
+	oids.assign(rel_paths.size(), git_oid());
+	ok.assign(rel_paths.size(), false);
+	// vector<bool> packs bits, so workers record results in a byte array.
+	vector<uint8_t> hashed(rel_paths.size(), 0);
+
+	idx_t num_batches = (rel_paths.size() + HASH_BATCH_SIZE - 1) / HASH_BATCH_SIZE;
+	std::atomic<idx_t> next_batch(0);
+	auto work = [&](git_repository *worker_repo) {
+		while (true) {
+			idx_t batch = next_batch.fetch_add(1);
+			if (batch >= num_batches) {
+				break;
+			}
+			idx_t end = MinValue<idx_t>((batch + 1) * HASH_BATCH_SIZE, rel_paths.size());
+			for (idx_t i = batch * HASH_BATCH_SIZE; i < end; i++) {
+				hashed[i] = HashWorktreeFile(worker_repo, workdir + rel_paths[i], rel_paths[i], fast, oids[i]);
+			}
+		}
+	};
+
+	idx_t num_workers = MinValue<idx_t>(MaxValue<idx_t>(max_threads, 1), num_batches);
+	if (num_workers <= 1) {
+		work(repo);
+	} else {
+		RunParallelWorkers(context, num_workers, [&](idx_t worker) {
+			ScopedGitRepo worker_repo(repo_path);
+			if (!worker_repo.is_valid()) {
+				const git_error *e = git_error_last();
+				throw IOException("failed to open repository '%s': %s", repo_path, e ? e->message : "unknown error");
+			}
+			work(worker_repo);
+		});
+	}
+
+	for (idx_t i = 0; i < rel_paths.size(); i++) {
+		ok[i] = hashed[i] != 0;
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,197 @@
+#!/bin/bash
+# Rebuilds the scripted fixture tarballs in this directory. Commits use fixed
+# author/committer names and dates, so commit ids are stable and tests can
+# assert them. The older fixtures (main-repo, empty-repo, ...) were packed by
+# hand and are not rebuilt here.
+#
+# Usage: build_fixtures.sh [fixture...]   (default: all scripted fixtures)
+
+set -e
+
+FIXTURES_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+export GIT_AUTHOR_NAME="Test User"
+export GIT_AUTHOR_EMAIL="test@example.com"
+export GIT_COMMITTER_NAME="Test User"
+export GIT_COMMITTER_EMAIL="test@example.com"
+export GIT_CONFIG_NOSYSTEM=1
+export HOME="$WORK_DIR"
+export TZ=UTC
+
+# commit_at <unix time> <message>: commits the index at a fixed date
+commit_at() {
+    GIT_AUTHOR_DATE="@$1 +0000" GIT_COMMITTER_DATE="@$1 +0000" git commit -q -m "$2"
+}
+
+# merge_at <unix time> <message> <rev>: merges <rev> with a merge commit at a fixed date
+merge_at() {
+    GIT_AUTHOR_DATE="@$1 +0000" GIT_COMMITTER_DATE="@$1 +0000" git merge -q --no-ff -m "$2" "$3"
+}
+
+init_repo() {
+    git init -q -b main "$1"
+    cd "$1"
+    git config user.name "$GIT_AUTHOR_NAME"
+    git config user.email "$GIT_AUTHOR_EMAIL"
+    git config core.autocrlf false
+}
+
+pack_fixture() {
+    local name="$1"
+    tar -C "$WORK_DIR" --owner=0 --group=0 --sort=name --mtime="@1700000000" -cf - "$name" | gzip -n > "$FIXTURES_DIR/$name.tar.gz"
+    echo "Wrote $FIXTURES_DIR/$name.tar.gz"
+}
+
+# status-repo: two commits plus a worktree in every status git reports.
+#   modified.txt   modified, unstaged      staged.txt   modified, staged
+#   both.txt       staged and modified     deleted.txt  deleted, unstaged
+#   removed.txt    deleted, staged         added.txt    new, staged
+#   untracked.txt, newdir/inner.txt        untracked    debug.log ignored
+#   crlf.txt       eol=crlf file (CRLF on disk, LF in the blob) with one
+#                  line appended in the worktree
+build_status_repo() {
+    init_repo "$WORK_DIR/status-repo"
+    printf 'clean\n' > clean.txt
+    printf 'line1\nline2\nline3\n' > modified.txt
+    printf 'staged base\n' > staged.txt
+    printf 'both base\n' > both.txt
+    printf 'to delete\n' > deleted.txt
+    printf 'to remove\n' > removed.txt
+    mkdir -p src
+    printf 'print("hi")\n' > src/nested.py
+    printf '*.log\n' > .gitignore
+    printf 'crlf.txt text eol=crlf\n' > .gitattributes
+    printf 'first\nsecond\n' > crlf.txt
+    git add -A
+    commit_at 1700000000 "Initial commit"
+    printf 'docs\n' > notes.md
+    git add notes.md
+    commit_at 1700000100 "Add notes"
+
+    printf 'line1\nline two\nline3\nline4\n' > modified.txt
+    printf 'staged base\nstaged line\n' > staged.txt
+    git add staged.txt
+    printf 'both base\nstaged\n' > both.txt
+    git add both.txt
+    printf 'both base\nstaged\nunstaged\n' > both.txt
+    rm deleted.txt
+    git rm -q removed.txt
+    printf 'new file\n' > added.txt
+    git add added.txt
+    printf 'untracked\n' > untracked.txt
+    mkdir -p newdir
+    printf 'inner\n' > newdir/inner.txt
+    printf 'ignored\n' > debug.log
+    printf 'first\r\nsecond\r\nthird\r\n' > crlf.txt
+    cd "$FIXTURES_DIR"
+    pack_fixture status-repo
+}
+
+# rename-repo: moves for rename detection.
+#   HEAD~2..HEAD~1  docs/guide.md -> docs/manual.md, content unchanged
+#   HEAD~1..HEAD    notes.txt -> notes.md with one of ten lines edited
+#   worktree        data.crlf (eol=crlf, LF in the blob) moved to moved.crlf
+#                   without telling git
+build_rename_repo() {
+    init_repo "$WORK_DIR/rename-repo"
+    mkdir -p docs
+    for i in $(seq 1 12); do echo "Guide line $i explains one more thing"; done > docs/guide.md
+    for i in $(seq 1 10); do echo "Note number $i with some text"; done > notes.txt
+    printf 'keep\n' > keep.txt
+    printf '*.crlf text eol=crlf\n' > .gitattributes
+    printf 'alpha\nbeta\ngamma\n' > data.crlf
+    git add -A
+    commit_at 1700001000 "Initial commit"
+    git mv docs/guide.md docs/manual.md
+    commit_at 1700001100 "Rename guide"
+    git mv notes.txt notes.md
+    sed -i 's/^Note number 5 with some text$/Note five was rewritten/' notes.md
+    git add notes.md
+    commit_at 1700001200 "Rename and edit notes"
+
+    rm data.crlf
+    printf 'alpha\r\nbeta\r\ngamma\r\n' > moved.crlf
+    cd "$FIXTURES_DIR"
+    pack_fixture rename-repo
+}
+
+# graph-repo: forked and criss-cross history with packed refs and a
+# commit-graph file.
+#   main     c0 - m1 - m2 - m3         (m3 committed after the commit-graph)
+#   feature            m1 - f1 - f2 - f3
+#   left               m1 - a1 - L     L = merge of b1 into a1
+#   right              m1 - b1 - R     R = merge of a1 into b1 (criss-cross)
+# Tags: v1.0 (annotated, m1), v2.0 (annotated, m2), v2.0-wrapped (annotated
+# tag of v2.0), lt-00..lt-39 (lightweight, m1), refs/remotes/origin/main (m1).
+# Every ref is packed; afterwards main moves to m3 and v3.0 (annotated, m3)
+# is created, so both stay loose.
+build_graph_repo() {
+    init_repo "$WORK_DIR/graph-repo"
+    printf 'base\n' > base.txt
+    git add base.txt
+    commit_at 1700010000 "Initial commit"
+    printf 'main 1\n' > main.txt
+    git add main.txt
+    commit_at 1700010100 "Main 1"
+    GIT_COMMITTER_DATE="@1700010100 +0000" git tag -a v1.0 -m "Release 1.0"
+    git branch feature
+    git branch left
+    git branch right
+    git update-ref refs/remotes/origin/main HEAD
+
+    printf 'main 2\n' >> main.txt
+    git add main.txt
+    commit_at 1700010200 "Main 2"
+    GIT_COMMITTER_DATE="@1700010200 +0000" git tag -a v2.0 -m "Release 2.0"
+    GIT_COMMITTER_DATE="@1700010200 +0000" git tag -a v2.0-wrapped -m "Wraps v2.0" v2.0 2>/dev/null
+
+    git checkout -q feature
+    for i in 1 2 3; do
+        printf 'feature %s\n' "$i" >> feature.txt
+        git add feature.txt
+        commit_at $((1700010300 + i)) "Feature $i"
+    done
+
+    git checkout -q left
+    printf 'left\n' > left.txt
+    git add left.txt
+    commit_at 1700010400 "Left 1"
+    git checkout -q right
+    printf 'right\n' > right.txt
+    git add right.txt
+    commit_at 1700010500 "Right 1"
+    git checkout -q left
+    merge_at 1700010600 "Merge right into left" "right"
+    git checkout -q right
+    merge_at 1700010700 "Merge left into right" "left~1"
+
+    git checkout -q main
+    for i in $(seq -w 0 39); do
+        git tag "lt-$i" HEAD~1
+    done
+
+    git commit-graph write --reachable
+    git pack-refs --all
+
+    printf 'main 3\n' >> main.txt
+    git add main.txt
+    commit_at 1700010800 "Main 3"
+    GIT_COMMITTER_DATE="@1700010800 +0000" git tag -a v3.0 -m "Release 3.0"
+    cd "$FIXTURES_DIR"
+    pack_fixture graph-repo
+}
+
+FIXTURES=("$@")
+if [ ${#FIXTURES[@]} -eq 0 ]; then
+    FIXTURES=(status-repo rename-repo graph-repo)
+fi
+for fixture in "${FIXTURES[@]}"; do
+    case "$fixture" in
+        status-repo) build_status_repo ;;
+        rename-repo) build_rename_repo ;;
+        graph-repo) build_graph_repo ;;
+        *) echo "Unknown fixture: $fixture"; exit 1 ;;
+    esac
+done
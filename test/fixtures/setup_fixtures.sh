@@ -41,6 +41,9 @@ setup_fixtures() {
         "large-repo.tar.gz|main,branch-1,branch-2,branch-3,branch-4,branch-5,branch-6,branch-7,branch-8,branch-9,branch-10|tag-1,tag-2,tag-3,tag-4,tag-5|Large repository for performance testing"
         "special-chars-repo.tar.gz|main,feature/test-123,bugfix/issue-456|v1.0.0-beta,v1.0.0-rc.1|Repository with special characters"
         "dotfile-repo.tar.gz|main||Repository with hidden dotfile directories"
+        "status-repo.tar.gz|main||Worktree with staged, unstaged, deleted, untracked and ignored files (build_fixtures.sh)"
+        "rename-repo.tar.gz|main||Pure and edited renames plus an untracked move (build_fixtures.sh)"
+        "graph-repo.tar.gz|main,feature,left,right|v1.0,v2.0,v2.0-wrapped,v3.0|Forked and criss-cross history, packed refs, commit-graph (build_fixtures.sh)"
     )
     
     # Extract each fixture
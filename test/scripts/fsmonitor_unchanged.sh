@@ -0,0 +1,5 @@
+#!/bin/sh
+# fsmonitor hook (protocol v2) for git_status tests: answers every query with
+# the same token and no changed paths. A run without a token is still a full
+# scan, so the first query sees everything and later ones see nothing new.
+printf 'duck-tails-test-token\0'